@@ -45,6 +45,23 @@ class BytesKey {
     values.reserve(capacity);
   }
 
+  /**
+   * Removes all values from the key but keeps its capacity, so that the key can be rebuilt without
+   * reallocations.
+   */
+  void clear() {
+    values.clear();
+    runningHash = InitialHash;
+  }
+
+  /**
+   * Returns a 64-bit hash of the key, which is accumulated while the values are written and thus
+   * costs nothing to query.
+   */
+  uint64_t hash() const {
+    return runningHash;
+  }
+
   /**
    * Returns true if this key is valid.
    */
@@ -92,7 +109,9 @@ class BytesKey {
   }
 
   friend bool operator==(const BytesKey& a, const BytesKey& b) {
-    return a.values == b.values;
+    // The hashes differ for almost all different keys, so the full comparison only runs to verify
+    // a match.
+    return a.runningHash == b.runningHash && a.values == b.values;
   }
 
   bool operator<(const BytesKey& key) const {
@@ -100,7 +119,12 @@ class BytesKey {
   }
 
  private:
+  static constexpr uint64_t InitialHash = 0xCBF29CE484222325;
+
   std::vector<uint32_t> values = {};
+  uint64_t runningHash = InitialHash;
+
+  void append(uint32_t value);
 
   friend struct BytesKeyHasher;
 };
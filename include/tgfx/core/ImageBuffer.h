@@ -30,6 +30,7 @@ namespace tgfx {
 class Context;
 class TextureView;
 class BufferImage;
+class ImageCodec;
 
 /**
  * ImageBuffer describes a two-dimensional array of pixels and is optimized for creating textures.
@@ -77,6 +78,23 @@ class ImageBuffer {
   static std::shared_ptr<ImageBuffer> MakeNV12(
       std::shared_ptr<YUVData> yuvData, YUVColorSpace colorSpace = YUVColorSpace::BT601_LIMITED);
 
+  /**
+   * Decodes the pixels of the codec and compresses them into ETC2 RGBA8 blocks, which are stored
+   * row by row. The blocks can be saved, for example, to a disk cache, and passed to MakeETC2()
+   * later to skip both the decoding and the compression. Returns nullptr if the codec is nullptr or
+   * alpha-only, or if the pixels fail to decode.
+   */
+  static std::shared_ptr<Data> CompressETC2(std::shared_ptr<ImageCodec> codec);
+
+  /**
+   * Creates an ImageBuffer from the ETC2 RGBA8 blocks returned by CompressETC2(). The blocks are
+   * uploaded to the GPU as they are, which takes a quarter of the memory of RGBA_8888 pixels. The
+   * returned ImageBuffer can't create mipmapped textures, or any texture if the GPU has no ETC2
+   * support. Returns nullptr if the size of the blocks doesn't match the width and height.
+   */
+  static std::shared_ptr<ImageBuffer> MakeETC2(std::shared_ptr<Data> blocks, int width, int height,
+                                               std::shared_ptr<ColorSpace> colorSpace = nullptr);
+
   virtual ~ImageBuffer() = default;
   /**
    * Returns the width of the image buffer.
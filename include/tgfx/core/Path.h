@@ -119,6 +119,13 @@ class Path {
    */
   bool isEmpty() const;
 
+  /**
+   * Returns true if Path has a single contour that is convex when filled. Curves are checked by
+   * their control points, so a convex curve may be reported as not convex. Returns false if the
+   * path is empty or all of its points are on the same line.
+   */
+  bool isConvex() const;
+
   /**
    * Returns true if the point (x, y) is contained by Path, taking into account PathFillType.
    */
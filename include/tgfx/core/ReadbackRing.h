@@ -0,0 +1,115 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <functional>
+#include <vector>
+#include "tgfx/core/ImageInfo.h"
+#include "tgfx/core/Rect.h"
+#include "tgfx/gpu/Context.h"
+
+namespace tgfx {
+class GPUBufferProxy;
+class Surface;
+
+/**
+ * ReadbackRing streams pixels out of Surfaces through a fixed number of readback buffers that are
+ * reused across frames. Each call to readPixels() starts an asynchronous readback into a free slot
+ * of the ring and returns the index of the frame, so several frames can be in flight while the
+ * following ones are being rendered. Call poll() to consume the finished readbacks in the order
+ * they were started. The pixels are accessed in place in the readback buffers without an extra
+ * copy. Create a ReadbackRing by calling ReadbackRing::Make().
+ */
+class ReadbackRing {
+ public:
+  /**
+   * The callback invoked by poll() for each finished readback. The pixels are only valid during
+   * the callback and respect the Surface's origin, like the pixels of SurfaceReadback.
+   */
+  using Callback =
+      std::function<void(int64_t frameIndex, const ImageInfo& info, const void* pixels)>;
+
+  /**
+   * Creates a new ReadbackRing with the given number of slots. Returns nullptr if the capacity is
+   * zero.
+   */
+  static std::shared_ptr<ReadbackRing> Make(size_t capacity);
+
+  /**
+   * Returns the max number of readbacks that can be in flight at the same time.
+   */
+  size_t capacity() const {
+    return slots.size();
+  }
+
+  /**
+   * Returns the number of readbacks that have been started but not yet consumed by poll().
+   */
+  size_t pendingCount() const {
+    return _pendingCount;
+  }
+
+  /**
+   * Starts reading a rect of pixels from the Surface into a free slot of the ring. The readback is
+   * performed when the Context is flushed and submitted. Returns the index of the frame, which
+   * starts from zero and increases with each successful call, or -1 if all slots are in flight,
+   * or if the rect is empty or outside the bounds of the Surface.
+   */
+  int64_t readPixels(Surface* surface, const Rect& rect);
+
+  /**
+   * Returns true if the readback of the given frame is still pending and its pixel data is ready
+   * to access. This method does not block the calling thread.
+   */
+  bool isReady(Context* context, int64_t frameIndex) const;
+
+  /**
+   * Passes the pixels of the finished readbacks to the callback in the order they were started,
+   * and releases their slots for reuse. Stops at the first readback that is not ready yet, unless
+   * wait is true, in which case it flushes the Context if needed and blocks until all pending
+   * readbacks are finished, if the backend supports blocking. A readback whose pixels can't be
+   * accessed is dropped without calling the callback. Returns the number of readbacks passed to the
+   * callback.
+   */
+  size_t poll(Context* context, const Callback& callback, bool wait = false);
+
+ private:
+  struct Slot {
+    std::shared_ptr<GPUBufferProxy> readbackBuffer = nullptr;
+    size_t bufferSize = 0;
+    ImageInfo info = {};
+    int64_t frameIndex = -1;
+    // The submit serial of the Context at which the transfer of the slot is encoded. A reused
+    // readback buffer keeps the fence of the previous frame until then.
+    uint64_t submitSerial = 0;
+  };
+
+  std::vector<Slot> slots = {};
+  size_t firstPending = 0;
+  size_t _pendingCount = 0;
+  int64_t nextFrameIndex = 0;
+
+  explicit ReadbackRing(size_t capacity) : slots(capacity) {
+  }
+
+  const Slot* findPendingSlot(int64_t frameIndex) const;
+
+  void popFirstPending();
+};
+}  // namespace tgfx
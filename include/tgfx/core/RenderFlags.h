@@ -37,5 +37,20 @@ class RenderFlags {
    * asynchronously.
    */
   static constexpr uint32_t DisableAsyncTask = 1 << 1;
+
+  /**
+   * Compresses the textures of static images decoded from ImageCodecs into the ETC2 format while
+   * decoding them, which reduces their GPU memory by 4x at the cost of some image quality. Ignored
+   * if the GPU has no ETC2 support, or if the image is mipmapped or alpha-only.
+   */
+  static constexpr uint32_t CompressImages = 1 << 2;
+
+  /**
+   * Draws text from signed distance fields rasterized once at a reference size, which can then be
+   * drawn at any scale or rotation without rasterizing the glyphs again. This is useful while the
+   * matrix is animating, such as during a pinch-zoom, at the cost of slightly rounder glyph
+   * corners. Color glyphs are always drawn as regular masks.
+   */
+  static constexpr uint32_t DistanceFieldText = 1 << 3;
 };
 }  // namespace tgfx
@@ -188,6 +188,7 @@ class Shape {
   friend class EffectShape;
   friend class ShapeDrawOp;
   friend class ProxyProvider;
+  friend class OpsCompositor;
   friend class Canvas;
   friend class Types;
   friend class ShapeUtils;
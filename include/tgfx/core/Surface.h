@@ -29,6 +29,7 @@
 namespace tgfx {
 class Canvas;
 class Context;
+class GPUBufferProxy;
 class RenderContext;
 class RenderTargetProxy;
 
@@ -206,6 +207,22 @@ class Surface {
 
   bool aboutToDraw(bool discardContent = false);
 
+  /**
+   * Replaces the render flags of the Surface. The pending draws are flushed to a separate render
+   * pass first if the flags change, since they were recorded with the previous flags.
+   */
+  void setRenderFlags(uint32_t renderFlags);
+
+  /**
+   * Flushes the pending draws and schedules a transfer of the rect of pixels into the readback
+   * buffer. A new readback buffer is created if the given one is nullptr or smaller than the
+   * pixels. Returns false if the rect is empty or outside the bounds of the Surface.
+   */
+  bool transferPixels(const Rect& rect, ImageInfo* info,
+                      std::shared_ptr<GPUBufferProxy>* readbackBuffer, size_t* bufferSize);
+
   friend class RenderContext;
+  friend class ReadbackRing;
+  friend class DisplayList;
 };
 }  // namespace tgfx
\ No newline at end of file
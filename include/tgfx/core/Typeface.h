@@ -195,5 +195,6 @@ class Typeface {
   friend class RenderContext;
   friend class PDFExportContext;
   friend class PDFFont;
+  friend class GlyphPathCache;
 };
 }  // namespace tgfx
@@ -55,6 +55,22 @@ class CommandQueue {
   virtual void writeTexture(std::shared_ptr<Texture> texture, const Rect& rect, const void* pixels,
                             size_t rowBytes) = 0;
 
+  /**
+   * Copies pixel data from a staging GPUBuffer to the texture within the specified rectangle, like
+   * writeTexture(), but without blocking the calling thread while the pixels are transferred. The
+   * buffer must have been created with GPUBufferUsage::STAGING and must not be mapped. Check the
+   * GPUBuffer's isReady() method before writing to the buffer again. Compressed textures are not
+   * supported.
+   * @param srcBuffer The staging buffer to copy from.
+   * @param srcOffset The offset in the buffer where the pixel data starts.
+   * @param srcRowBytes The number of bytes per row in the buffer.
+   * @param dstTexture The texture to copy to.
+   * @param dstRect The rectangle region of the texture to write.
+   */
+  virtual void copyBufferToTexture(std::shared_ptr<GPUBuffer> srcBuffer, size_t srcOffset,
+                                   size_t srcRowBytes, std::shared_ptr<Texture> dstTexture,
+                                   const Rect& dstRect) = 0;
+
   /**
    * Schedules the execution of the specified command buffer on the GPU.
    */
@@ -67,6 +83,13 @@ class CommandQueue {
    */
   virtual std::shared_ptr<Semaphore> insertSemaphore() = 0;
 
+  /**
+   * Inserts a fence after all the commands submitted so far and attaches it to the buffer, so the
+   * buffer's isReady() method returns false until the GPU has finished executing those commands.
+   * This lets the buffer be mapped again without overwriting data the GPU may still be reading.
+   */
+  virtual void insertFence(std::shared_ptr<GPUBuffer> buffer) = 0;
+
   /**
    * Inserts a GPU wait operation into the command queue, making the GPU wait until the specified
    * semaphore is signaled before executing subsequent commands.
@@ -20,9 +20,12 @@
 
 #include <chrono>
 #include <deque>
+#include <memory>
 #include "tgfx/gpu/Backend.h"
 #include "tgfx/gpu/Device.h"
+#include "tgfx/gpu/MemoryPressure.h"
 #include "tgfx/gpu/Recording.h"
+#include "tgfx/gpu/ResourceCategory.h"
 
 namespace tgfx {
 class GlobalCache;
@@ -37,6 +40,8 @@ class SlidingWindowTracker;
 class AtlasManager;
 class CommandBuffer;
 class ShaderCaps;
+class ProgramBinaryStore;
+class Data;
 
 /**
  * Context is responsible for creating and managing GPU resources, as well as issuing drawing
@@ -87,7 +92,8 @@ class Context {
   }
 
   /**
-   * Returns the number of bytes consumed by internal gpu caches.
+   * Returns the number of bytes consumed by internal gpu caches, including the CPU copies of the
+   * atlas pages and the streaming buffers reused across flushes.
    */
   size_t memoryUsage() const;
 
@@ -107,6 +113,20 @@ class Context {
    */
   void setCacheLimit(size_t bytesLimit);
 
+  /**
+   * Returns the gpu memory cache limit in bytes for the given category of resources. The default
+   * value is SIZE_MAX, which leaves the category bounded by the overall cacheLimit() only.
+   */
+  size_t cacheLimit(ResourceCategory category) const;
+
+  /**
+   * Sets the gpu memory cache limit in bytes for the given category of resources. If the category
+   * exceeds the new limit, the cache will try to free its resources to get under the limit. When
+   * purging for any limit, resources that are cheap to regenerate per byte, such as scratch render
+   * targets, are freed before expensive ones, such as decoded images.
+   */
+  void setCacheLimit(ResourceCategory category, size_t bytesLimit);
+
   /**
    * Returns the number of frames (valid flushes) after which unused GPU resources are considered
    * expired. A 'frame' is defined as a non-empty flush where actual rendering work is performed and
@@ -137,6 +157,82 @@ class Context {
    */
   bool purgeResourcesUntilMemoryTo(size_t bytesLimit);
 
+  /**
+   * Releases the memory held by the context in response to the given level of memory pressure,
+   * usually forwarded from a memory warning of the operating system. Pending drawing operations
+   * are flushed and submitted first. The glyph atlases, the GPU program cache, the idle drawing
+   * buffers and the purgeable resources are then trimmed according to the level, and DisplayLists
+   * rendering to this context drop their tile caches at their next render() call. Returns the
+   * number of bytes of GPU resources released immediately.
+   */
+  size_t onMemoryPressure(MemoryPressure level);
+
+  /**
+   * Returns the number of times the context has handled the given level of memory pressure,
+   * including the ones triggered by the memory soft limit. Caches living outside the context
+   * compare it with the value seen last time to decide whether to release their own memory.
+   */
+  uint32_t memoryPressureCount(MemoryPressure level) const {
+    return memoryPressureCounts[static_cast<int>(level)];
+  }
+
+  /**
+   * Returns the memory soft limit of the context in bytes. The default value is SIZE_MAX, which
+   * disables the soft limit.
+   */
+  size_t memorySoftLimit() const {
+    return _memorySoftLimit;
+  }
+
+  /**
+   * Sets the memory soft limit of the context in bytes. When the memory usage rises above the soft
+   * limit after all pending work is submitted, the context purges resources until the usage is back
+   * under the limit and counts it as a moderate memory pressure, so DisplayLists rendering to this
+   * context drop their tiles out of view. The glyph atlases and the GPU programs are kept. This
+   * happens once each time the usage crosses the limit, not at every submit while it stays above.
+   */
+  void setMemorySoftLimit(size_t bytesLimit) {
+    _memorySoftLimit = bytesLimit;
+    overMemorySoftLimit = false;
+  }
+
+  /**
+   * Returns the ProgramBinaryStore used to persist the linked binaries of GPU programs, or nullptr
+   * if none is set.
+   */
+  std::shared_ptr<ProgramBinaryStore> programBinaryStore() const {
+    return _programBinaryStore;
+  }
+
+  /**
+   * Sets the ProgramBinaryStore used to persist the linked binaries of GPU programs. Programs that
+   * are not in memory are loaded from the store if possible instead of being compiled from source,
+   * and newly compiled programs are saved to it. This has no effect if the GPU backend can't
+   * retrieve program binaries. Pass nullptr to stop using the store.
+   */
+  void setProgramBinaryStore(std::shared_ptr<ProgramBinaryStore> store) {
+    _programBinaryStore = std::move(store);
+  }
+
+  /**
+   * Exports the programs currently cached by the context, from the most recently used to the
+   * least, which can be passed to precompilePrograms() in a later run to create them ahead of
+   * time. The exported data contains the generated shader code and is only valid for the same
+   * version of tgfx. Returns nullptr if no program is cached.
+   */
+  std::shared_ptr<Data> exportProgramKeys() const;
+
+  /**
+   * Compiles and links the programs exported by exportProgramKeys() ahead of time, so that their
+   * first draws don't stall on shader compilation. The work stops once the timeBudget runs out,
+   * but at least one program is compiled per call. Calling it again with the same data continues
+   * from where the last call stopped, which spreads the work over several frames. Returns true if
+   * all programs in the data have been processed.
+   */
+  bool precompilePrograms(std::shared_ptr<Data> data,
+                          std::chrono::steady_clock::duration timeBudget =
+                              std::chrono::steady_clock::duration::max());
+
   /**
    * Inserts a GPU semaphore that the current GPU-backed API must wait on before executing any more
    * commands on the GPU. The context will take ownership of the underlying semaphore and delete it
@@ -192,9 +288,26 @@ class Context {
     return _atlasManager;
   }
 
+  /**
+   * Returns the number of drawing buffers submitted to the GPU so far.
+   */
+  uint64_t submitSerial() const {
+    return _submitSerial;
+  }
+
+  /**
+   * Returns the value submitSerial() reaches once the drawing operations recorded so far are
+   * submitted to the GPU.
+   */
+  uint64_t nextSubmitSerial() const {
+    return _submitSerial + pendingDrawingBuffers.size() + 1;
+  }
+
  private:
   std::shared_ptr<DrawingBuffer> getDrawingBuffer(const Recording* recording) const;
 
+  void checkMemorySoftLimit();
+
   Device* _device = nullptr;
   GPU* _gpu = nullptr;
   ShaderCaps* _shaderCaps = nullptr;
@@ -203,7 +316,13 @@ class Context {
   DrawingManager* _drawingManager = nullptr;
   ProxyProvider* _proxyProvider = nullptr;
   AtlasManager* _atlasManager = nullptr;
+  std::shared_ptr<ProgramBinaryStore> _programBinaryStore = nullptr;
   std::deque<std::shared_ptr<DrawingBuffer>> pendingDrawingBuffers = {};
+  uint64_t _submitSerial = 0;
+  size_t _memorySoftLimit = SIZE_MAX;
+  uint32_t memoryPressureCounts[2] = {};
+  bool handlingMemoryPressure = false;
+  bool overMemorySoftLimit = false;
 };
 
 }  // namespace tgfx
@@ -154,6 +154,16 @@ class GPU {
   virtual std::shared_ptr<RenderPipeline> createRenderPipeline(
       const RenderPipelineDescriptor& descriptor) = 0;
 
+  /**
+   * Returns the binary of the given pipeline, which can be set to RenderPipelineDescriptor::binary
+   * to recreate the pipeline later without compiling the shaders. Returns nullptr if the GPU
+   * backend or the driver can't retrieve pipeline binaries. The default implementation returns
+   * nullptr.
+   */
+  virtual std::shared_ptr<Data> getPipelineBinary(const RenderPipeline*) const {
+    return nullptr;
+  }
+
   /**
    * Creates a command encoder that can be used to encode commands to be issued to the GPU.
    */
@@ -52,6 +52,13 @@ class GPUBufferUsage {
    * to the CPU.
    */
   static constexpr uint32_t READBACK = 0x800;
+
+  /**
+   * The buffer can be used as a staging buffer, which is mapped for the CPU to write pixels into
+   * and then copied to textures by CommandQueue::copyBufferToTexture(). The mapped memory may be
+   * written from any thread, but map() and unmap() must be called on the thread of the GPU.
+   */
+  static constexpr uint32_t STAGING = 0x1000;
 };
 
 /**
@@ -80,8 +87,9 @@ class GPUBuffer {
 
   /**
    * Checks if the GPUBuffer is ready for access. For readback buffers, this means the data transfer
-   * from the GPU to the CPU has finished. For other buffer types, this usually returns true
-   * immediately after creation.
+   * from the GPU to the CPU has finished. For staging buffers, this means the GPU has finished
+   * reading the last copy out of the buffer, so it can be written again without stalling. For
+   * other buffer types, this usually returns true immediately after creation.
    */
   virtual bool isReady() const = 0;
 
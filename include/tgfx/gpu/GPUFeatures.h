@@ -39,5 +39,10 @@ class GPUFeatures {
    * immediately visible to subsequent texture reads without needing to flush the pipeline.
    */
   bool textureBarrier = false;
+
+  /**
+   * Indicates whether the GPU supports sampling textures in the PixelFormat::ETC2_RGBA8 format.
+   */
+  bool textureCompressionETC2 = false;
 };
 }  // namespace tgfx
@@ -0,0 +1,38 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+namespace tgfx {
+/**
+ * MemoryPressure describes how urgently a Context should release memory, usually forwarded from
+ * the memory warnings of the operating system.
+ */
+enum class MemoryPressure {
+  /**
+   * Memory is getting low. The context releases memory that is cheap to regenerate or not needed
+   * for the current frame, such as scratch resources, idle atlas pages, and tiles out of view.
+   */
+  Moderate,
+  /**
+   * Memory is critically low. The context releases everything it can regenerate later, at the cost
+   * of redrawing and re-uploading content over the next frames.
+   */
+  Critical,
+};
+}  // namespace tgfx
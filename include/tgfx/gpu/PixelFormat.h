@@ -56,6 +56,12 @@ enum class PixelFormat {
   /**
    * Pixel with 24 bits for depth, 8 bits for stencil. Each pixel is stored on 4 bytes.
    */
-  DEPTH24_STENCIL8
+  DEPTH24_STENCIL8,
+
+  /**
+   * Compressed pixels with ETC2 color and EAC alpha. Each block of 4x4 pixels is stored on 16
+   * bytes. Textures in this format can only be sampled, and must be written in whole blocks.
+   */
+  ETC2_RGBA8
 };
 }  // namespace tgfx
@@ -0,0 +1,63 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include "tgfx/core/Data.h"
+
+namespace tgfx {
+/**
+ * ProgramBinaryStore is a persistent storage for the linked binaries of GPU programs. When it is
+ * set to a Context, the programs are loaded from their binaries if possible instead of being
+ * compiled from source, which greatly reduces the hitches caused by the first use of a program in
+ * a new process. Implementations must be thread-safe if the store is shared between contexts.
+ */
+class ProgramBinaryStore {
+ public:
+  /**
+   * The default maximum total size of the binaries kept by a file store, in bytes.
+   */
+  static constexpr size_t DEFAULT_MAX_BYTES = 32 * 1024 * 1024;
+
+  /**
+   * Creates a ProgramBinaryStore that saves each binary as a file in the given directory, which
+   * must already exist. Once the total size of the files exceeds maxBytes, the least recently used
+   * ones are removed. The index of the files is updated in the background and flushed when the
+   * store is destroyed, so only one store should use the directory at a time. Returns nullptr if
+   * the directory is empty.
+   */
+  static std::shared_ptr<ProgramBinaryStore> MakeFrom(const std::string& directory,
+                                                      size_t maxBytes = DEFAULT_MAX_BYTES);
+
+  virtual ~ProgramBinaryStore() = default;
+
+  /**
+   * Returns the binary previously saved with the given key, or nullptr if there is none. The key
+   * covers the shader code of the program and the GPU driver strings. A returned binary can still
+   * be rejected by the driver, in which case the program is compiled from source again.
+   */
+  virtual std::shared_ptr<Data> load(const Data& key) = 0;
+
+  /**
+   * Saves the binary of a newly linked program with the given key, replacing any existing one.
+   */
+  virtual void save(const Data& key, std::shared_ptr<Data> binary) = 0;
+};
+}  // namespace tgfx
@@ -21,6 +21,7 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include "tgfx/core/Data.h"
 #include "tgfx/gpu/Attribute.h"
 #include "tgfx/gpu/BlendFactor.h"
 #include "tgfx/gpu/BlendOperation.h"
@@ -332,6 +333,13 @@ class RenderPipelineDescriptor {
    * An object that describes the face culling configuration for the render pipeline.
    */
   PrimitiveDescriptor primitive = {};
+
+  /**
+   * The binary returned by GPU::getPipelineBinary() for a pipeline created from the same shader
+   * code. If set, the pipeline is created from the binary and the shader modules are ignored, which
+   * skips compiling and linking the shaders.
+   */
+  std::shared_ptr<Data> binary = nullptr;
 };
 
 /**
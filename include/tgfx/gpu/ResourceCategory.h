@@ -0,0 +1,45 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+namespace tgfx {
+/**
+ * ResourceCategory groups the GPU resources cached by a Context, so that each group can be given
+ * its own cache limit.
+ */
+enum class ResourceCategory {
+  /**
+   * Textures holding content that is expensive to regenerate, such as decoded images and
+   * rasterized shapes.
+   */
+  Texture,
+  /**
+   * Render targets and stencil buffers used for offscreen rendering.
+   */
+  RenderTarget,
+  /**
+   * GPU buffers, such as the vertex buffers of triangulated shapes.
+   */
+  Buffer,
+  /**
+   * All other resources.
+   */
+  Other,
+};
+}  // namespace tgfx
@@ -221,6 +221,25 @@ class DisplayList {
     _maxTilesRefinedPerFrame = count;
   }
 
+  /**
+   * Returns true if text is allowed to be drawn as signed distance fields while the zoomScale is
+   * changing. This setting is ignored in tiled rendering mode. When enabled, glyphs are no longer
+   * rasterized again for every new zoomScale during zooming, which can greatly improve zooming
+   * performance for text-heavy content. Once the zoomScale stops changing, hasContentChanged()
+   * returns true, and the next rendering redraws the text as sharp masks. The default is false.
+   */
+  bool allowDistanceFieldText() const {
+    return _allowDistanceFieldText;
+  }
+
+  /**
+   * Sets whether to allow text to be drawn as signed distance fields while the zoomScale is
+   * changing.
+   */
+  void setAllowDistanceFieldText(bool allow) {
+    _allowDistanceFieldText = allow;
+  }
+
   /**
    * Returns the background color of the root layer. The background is an infinite rectangle that
    * covers the entire display area and is drawn using the SrcOver blend mode.
@@ -284,6 +303,7 @@ class DisplayList {
   int _tileSize = 256;
   int _maxTileCount = 0;
   bool _allowZoomBlur = false;
+  bool _allowDistanceFieldText = false;
   int _maxTilesRefinedPerFrame = 5;
   int _subtreeCacheMaxSize = 0;
   bool _showDirtyRegions = false;
@@ -291,17 +311,22 @@ class DisplayList {
   bool hasZoomBlurTiles = false;
   int64_t lastZoomScaleInt = 1000;
   Point lastContentOffset = {};
+  int64_t renderedZoomScaleInt = 1000;
+  bool distanceFieldText = false;
   Point mousePosition = {};
   int totalTileCount = 0;
   std::vector<std::shared_ptr<Surface>> surfaceCaches = {};
   std::unordered_map<int64_t, TileCache*> tileCaches = {};
   std::vector<std::shared_ptr<Tile>> emptyTiles = {};
   std::deque<std::vector<Rect>> lastDirtyRegions = {};
+  uint32_t memoryPressureContextID = 0;
+  uint32_t moderatePressureCount = 0;
+  uint32_t criticalPressureCount = 0;
 
   std::vector<Rect> renderDirect(Surface* surface, bool autoClear) const;
 
   std::vector<Rect> renderPartial(Surface* surface, bool autoClear,
-                                  const std::vector<Rect>& dirtyRegions);
+                                  const std::vector<Rect>& dirtyRegions, bool redrawAll);
 
   std::vector<Rect> renderTiled(Surface* surface, bool autoClear,
                                 const std::vector<Rect>& dirtyRegions);
@@ -347,6 +372,10 @@ class DisplayList {
 
   void resetCaches();
 
+  void checkMemoryPressure(const Surface* surface);
+
+  void releaseTilesOutOfView(const Surface* surface);
+
   void drawRootLayer(Surface* surface, const Rect& drawRect, const Matrix& viewMatrix,
                      bool autoClear) const;
 
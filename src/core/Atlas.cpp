@@ -138,6 +138,15 @@ bool Atlas::getCellLocator(const BytesKey& cellKey, AtlasCellLocator& cellLocato
   return plotGeneration == locatorGeneration;
 }
 
+Plot* Atlas::getPlot(const PlotLocator& plotLocator) const {
+  auto pageIndex = plotLocator.pageIndex();
+  auto plotIndex = plotLocator.plotIndex();
+  if (pageIndex >= pages.size() || plotIndex >= numPlots) {
+    return nullptr;
+  }
+  return pages[pageIndex].plotArray[plotIndex].get();
+}
+
 void Atlas::setLastUseToken(const PlotLocator& plotLocator, AtlasToken token) {
   auto plotIndex = plotLocator.plotIndex();
   DEBUG_ASSERT(plotIndex < numPlots);
@@ -267,6 +276,36 @@ void Atlas::compact(AtlasToken startTokenForNextFlush) {
   previousFlushToken = startTokenForNextFlush;
 }
 
+size_t Atlas::releaseIdlePages() {
+  size_t count = 0;
+  while (!pages.empty()) {
+    auto& plotList = pages.back().plotList;
+    auto inUse = std::any_of(plotList.begin(), plotList.end(), [](const Plot* plot) {
+      return plot->lastUseToken() != AtlasToken::InvalidToken() &&
+             plot->flushesSinceLastUsed() == 0;
+    });
+    if (inUse) {
+      break;
+    }
+    deactivateLastPage();
+    count++;
+  }
+  if (count > 0) {
+    flushesSinceLastUse = 0;
+  }
+  return count;
+}
+
+size_t Atlas::memoryUsage() const {
+  size_t bytes = 0;
+  for (auto& page : pages) {
+    for (auto& plot : page.plotList) {
+      bytes += plot->shadowMemoryUsage();
+    }
+  }
+  return bytes;
+}
+
 void Atlas::removeExpiredKeys() {
   constexpr size_t kMaxKeys = 20000;
   if (cellLocators.size() < kMaxKeys || expiredKeys.empty()) {
@@ -39,6 +39,8 @@ class Atlas {
 
   bool getCellLocator(const BytesKey& cellKey, AtlasCellLocator& cellLocator) const;
 
+  Plot* getPlot(const PlotLocator& plotLocator) const;
+
   const std::vector<std::shared_ptr<TextureProxy>>& getTextureProxies() const {
     return textureProxies;
   }
@@ -50,6 +52,18 @@ class Atlas {
 
   void removeExpiredKeys();
 
+  /**
+   * Deactivates the trailing pages that have no plot used in the last flush, releasing their
+   * textures. Returns the number of pages deactivated. Must be called when no pending drawing
+   * operation refers to the atlas.
+   */
+  size_t releaseIdlePages();
+
+  /**
+   * Returns the number of bytes held by the CPU copies of the plots in all active pages.
+   */
+  size_t memoryUsage() const;
+
  private:
   Atlas(ProxyProvider* proxyProvider, PixelFormat pixelFormat, int width, int height, int plotWidth,
         int plotHeight, AtlasGenerationCounter* generationCounter);
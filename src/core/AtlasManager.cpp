@@ -65,6 +65,10 @@ bool AtlasManager::addCellToAtlas(const AtlasCell& cell, AtlasToken nextFlushTok
   return getAtlas(cell.maskFormat)->addToAtlas(cell, nextFlushToken, atlasLocator);
 }
 
+Plot* AtlasManager::getPlot(MaskFormat maskFormat, const PlotLocator& plotLocator) const {
+  return getAtlas(maskFormat)->getPlot(plotLocator);
+}
+
 bool AtlasManager::getCellLocator(MaskFormat maskFormat, const BytesKey& key,
                                   AtlasCellLocator& locator) const {
   return this->getAtlas(maskFormat)->getCellLocator(key, locator);
@@ -98,6 +102,24 @@ AtlasToken AtlasManager::nextFlushToken() const {
   return atlasTokenTracker.nextToken();
 }
 
+void AtlasManager::releaseIdlePages() {
+  for (const auto& atlas : atlases) {
+    if (atlas) {
+      atlas->releaseIdlePages();
+    }
+  }
+}
+
+size_t AtlasManager::memoryUsage() const {
+  size_t bytes = 0;
+  for (const auto& atlas : atlases) {
+    if (atlas) {
+      bytes += atlas->memoryUsage();
+    }
+  }
+  return bytes;
+}
+
 void AtlasManager::releaseAll() {
   for (auto& atlas : atlases) {
     atlas = nullptr;
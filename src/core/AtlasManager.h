@@ -35,6 +35,8 @@ class AtlasManager : public AtlasGenerationCounter {
 
   bool addCellToAtlas(const AtlasCell& cell, AtlasToken nextFlushToken, AtlasLocator&) const;
 
+  Plot* getPlot(MaskFormat maskFormat, const PlotLocator& plotLocator) const;
+
   void setPlotUseToken(PlotUseUpdater&, const PlotLocator&, MaskFormat, AtlasToken) const;
 
   void preFlush();
@@ -43,6 +45,12 @@ class AtlasManager : public AtlasGenerationCounter {
 
   AtlasToken nextFlushToken() const;
 
+  // Releases the trailing atlas pages that were not used in the last flush.
+  void releaseIdlePages();
+
+  // Returns the number of bytes held by the CPU copies of the atlas pages.
+  size_t memoryUsage() const;
+
   // Releases all atlas resources,
   // including their underlying textures.
   void releaseAll();
@@ -51,8 +51,8 @@ Plot::Plot(uint32_t pageIndex, uint32_t plotIndex, AtlasGenerationCounter* gener
            int offsetX, int offsetY, int width, int height)
     : generationCounter(generationCounter), _pageIndex(pageIndex), _plotIndex(plotIndex),
       _genID(generationCounter->next()),
-      _pixelOffset(Point::Make(offsetX * width, offsetY * height)), rectPack(width, height),
-      _plotLocator(pageIndex, plotIndex, _genID) {
+      _pixelOffset(Point::Make(offsetX * width, offsetY * height)), _width(width), _height(height),
+      rectPack(width, height), _plotLocator(pageIndex, plotIndex, _genID) {
 }
 
 bool Plot::addRect(int imageWidth, int imageHeight, AtlasLocator& atlasLocator) {
@@ -78,5 +78,21 @@ void Plot::resetRects() {
   _plotLocator =
       PlotLocator(static_cast<uint32_t>(_pageIndex), static_cast<uint32_t>(_plotIndex), _genID);
   _lastUseToken = AtlasToken::InvalidToken();
+  // The evicted cells are gone, so the next cell starts from a cleared copy allocated on demand.
+  shadowPixels = nullptr;
+  shadowByteSize = 0;
+}
+
+std::shared_ptr<uint8_t[]> Plot::getShadowPixels(size_t byteSize) {
+  if (shadowPixels == nullptr) {
+    shadowPixels.reset(new (std::nothrow) uint8_t[byteSize]());
+    if (shadowPixels == nullptr) {
+      LOGE("Plot::getShadowPixels() failed to allocate %zu bytes for the shadow pixels", byteSize);
+      return nullptr;
+    }
+    shadowByteSize = byteSize;
+  }
+  DEBUG_ASSERT(shadowByteSize == byteSize);
+  return shadowPixels;
 }
 }  // namespace tgfx
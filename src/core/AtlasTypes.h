@@ -19,12 +19,17 @@
 #pragma once
 
 #include <list>
+#include <memory>
 #include "RectPackSkyline.h"
 #include "core/utils/Log.h"
 #include "tgfx/core/Rect.h"
 
 namespace tgfx {
-enum class MaskFormat : int { A8, RGBA, BGRA, Last = BGRA };
+/**
+ * The formats of the atlas cells. SDF cells store single-channel signed distance fields of glyphs
+ * rather than their coverage, so they live in their own atlas even though both are alpha-only.
+ */
+enum class MaskFormat : int { A8, RGBA, BGRA, SDF, Last = SDF };
 
 static constexpr int MaskFormatCount = static_cast<int>(MaskFormat::Last) + 1;
 
@@ -229,10 +234,34 @@ class Plot {
     return _pixelOffset;
   }
 
+  int width() const {
+    return _width;
+  }
+
+  int height() const {
+    return _height;
+  }
+
   bool addRect(int with, int height, AtlasLocator& atlasLocator);
 
   void resetRects();
 
+  /**
+   * Returns the CPU copy of the plot's pixels, which is allocated with the given byte size and
+   * zero-initialized on first use. Cells are rasterized into it, and the parts written during a
+   * flush are uploaded to the atlas texture together. The copy is released when the plot is
+   * evicted, while the pending uploads keep their references. Returns nullptr if the allocation
+   * fails.
+   */
+  std::shared_ptr<uint8_t[]> getShadowPixels(size_t byteSize);
+
+  /**
+   * Returns the number of bytes held by the CPU copy of the plot's pixels.
+   */
+  size_t shadowMemoryUsage() const {
+    return shadowPixels != nullptr ? shadowByteSize : 0;
+  }
+
   AtlasToken lastUseToken() const {
     return _lastUseToken;
   }
@@ -259,7 +288,11 @@ class Plot {
   const uint32_t _plotIndex = 0;
   uint64_t _genID = 0;
   const Point _pixelOffset = {};
+  const int _width = 0;
+  const int _height = 0;
   RectPackSkyline rectPack;
+  std::shared_ptr<uint8_t[]> shadowPixels = nullptr;
+  size_t shadowByteSize = 0;
   PlotLocator _plotLocator;
 };
 
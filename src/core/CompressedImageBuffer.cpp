@@ -0,0 +1,73 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "CompressedImageBuffer.h"
+#include "core/utils/ETC2Encoder.h"
+#include "gpu/resources/TextureView.h"
+
+namespace tgfx {
+std::shared_ptr<CompressedImageBuffer> CompressedImageBuffer::MakeFrom(
+    std::shared_ptr<ImageCodec> codec) {
+  if (codec == nullptr || codec->isAlphaOnly()) {
+    return nullptr;
+  }
+  auto info = ImageInfo::Make(codec->width(), codec->height(), ColorType::RGBA_8888,
+                              AlphaType::Premultiplied, 0, codec->colorSpace());
+  auto pixels = std::make_unique<uint8_t[]>(info.byteSize());
+  if (!codec->readPixels(info, pixels.get())) {
+    return nullptr;
+  }
+  auto byteSize = ETC2CompressedSize(info.width(), info.height());
+  auto blocks = new (std::nothrow) uint8_t[byteSize];
+  if (blocks == nullptr) {
+    return nullptr;
+  }
+  auto data = Data::MakeAdopted(blocks, byteSize);
+  if (!CompressETC2(info, pixels.get(), blocks)) {
+    return nullptr;
+  }
+  return std::shared_ptr<CompressedImageBuffer>(new CompressedImageBuffer(
+      std::move(data), info.width(), info.height(), info.colorSpace()));
+}
+
+std::shared_ptr<CompressedImageBuffer> CompressedImageBuffer::MakeFrom(
+    std::shared_ptr<Data> blocks, int width, int height, std::shared_ptr<ColorSpace> colorSpace) {
+  if (blocks == nullptr || width <= 0 || height <= 0 ||
+      blocks->size() != ETC2CompressedSize(width, height)) {
+    return nullptr;
+  }
+  return std::shared_ptr<CompressedImageBuffer>(
+      new CompressedImageBuffer(std::move(blocks), width, height, std::move(colorSpace)));
+}
+
+CompressedImageBuffer::CompressedImageBuffer(std::shared_ptr<Data> blocks, int width, int height,
+                                             std::shared_ptr<ColorSpace> colorSpace)
+    : blocks(std::move(blocks)), _width(width), _height(height),
+      _colorSpace(std::move(colorSpace)) {
+}
+
+std::shared_ptr<TextureView> CompressedImageBuffer::onMakeTexture(Context* context,
+                                                                  bool mipmapped) const {
+  if (mipmapped) {
+    // The compressed textures have no mipmaps.
+    return nullptr;
+  }
+  return TextureView::MakeFormat(context, _width, _height, blocks->data(),
+                                 ETC2CompressedRowBytes(_width), PixelFormat::ETC2_RGBA8);
+}
+}  // namespace tgfx
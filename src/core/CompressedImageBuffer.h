@@ -0,0 +1,82 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "tgfx/core/Data.h"
+#include "tgfx/core/ImageBuffer.h"
+#include "tgfx/core/ImageCodec.h"
+
+namespace tgfx {
+/**
+ * CompressedImageBuffer holds the pixels of an image compressed into ETC2 RGBA8 blocks, which take
+ * a quarter of the memory of the RGBA_8888 pixels and are uploaded to the GPU as they are.
+ */
+class CompressedImageBuffer : public ImageBuffer {
+ public:
+  /**
+   * Decodes the pixels from the codec and compresses them into ETC2 RGBA8 blocks. Returns nullptr
+   * if the codec is nullptr or alpha only, or if the pixels fail to decode.
+   */
+  static std::shared_ptr<CompressedImageBuffer> MakeFrom(std::shared_ptr<ImageCodec> codec);
+
+  /**
+   * Creates a CompressedImageBuffer from the ETC2 RGBA8 blocks previously returned by data(), for
+   * example, after loading them from a disk cache. Returns nullptr if the size of the blocks does
+   * not match the image size. This backs ImageBuffer::MakeETC2().
+   */
+  static std::shared_ptr<CompressedImageBuffer> MakeFrom(
+      std::shared_ptr<Data> blocks, int width, int height,
+      std::shared_ptr<ColorSpace> colorSpace = nullptr);
+
+  int width() const override {
+    return _width;
+  }
+
+  int height() const override {
+    return _height;
+  }
+
+  bool isAlphaOnly() const override {
+    return false;
+  }
+
+  const std::shared_ptr<ColorSpace>& colorSpace() const override {
+    return _colorSpace;
+  }
+
+  /**
+   * Returns the compressed blocks, which are stored row by row.
+   */
+  std::shared_ptr<Data> data() const {
+    return blocks;
+  }
+
+ protected:
+  std::shared_ptr<TextureView> onMakeTexture(Context* context, bool mipmapped) const override;
+
+ private:
+  std::shared_ptr<Data> blocks = nullptr;
+  int _width = 0;
+  int _height = 0;
+  std::shared_ptr<ColorSpace> _colorSpace = nullptr;
+
+  CompressedImageBuffer(std::shared_ptr<Data> blocks, int width, int height,
+                        std::shared_ptr<ColorSpace> colorSpace);
+};
+}  // namespace tgfx
@@ -0,0 +1,156 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#include "DistanceFieldRasterizer.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "tgfx/core/Pixmap.h"
+
+namespace tgfx {
+static constexpr float DistanceInfinity = 1e20f;
+
+/**
+ * Computes the squared euclidean distance transform of a row or a column of the grid in place. See
+ * "Distance Transforms of Sampled Functions" by Felzenszwalb and Huttenlocher for details.
+ */
+static void DistanceTransform1D(float* grid, size_t offset, size_t stride, size_t length, float* f,
+                                float* z, size_t* v) {
+  v[0] = 0;
+  z[0] = -DistanceInfinity;
+  z[1] = DistanceInfinity;
+  f[0] = grid[offset];
+  size_t k = 0;
+  for (size_t q = 1; q < length; q++) {
+    f[q] = grid[offset + q * stride];
+    auto fq = static_cast<float>(q);
+    float s = 0;
+    while (true) {
+      auto r = static_cast<float>(v[k]);
+      s = (f[q] - f[v[k]] + fq * fq - r * r) / (fq - r) * 0.5f;
+      if (s > z[k] || k == 0) {
+        break;
+      }
+      k--;
+    }
+    k++;
+    v[k] = q;
+    z[k] = s;
+    z[k + 1] = DistanceInfinity;
+  }
+  k = 0;
+  for (size_t q = 0; q < length; q++) {
+    auto fq = static_cast<float>(q);
+    while (z[k + 1] < fq) {
+      k++;
+    }
+    auto distance = fq - static_cast<float>(v[k]);
+    grid[offset + q * stride] = f[v[k]] + distance * distance;
+  }
+}
+
+static void DistanceTransform2D(float* grid, size_t width, size_t height) {
+  auto length = std::max(width, height);
+  std::vector<float> f(length);
+  std::vector<float> z(length + 1);
+  std::vector<size_t> v(length);
+  for (size_t x = 0; x < width; x++) {
+    DistanceTransform1D(grid, x, width, height, f.data(), z.data(), v.data());
+  }
+  for (size_t y = 0; y < height; y++) {
+    DistanceTransform1D(grid, y * width, 1, width, f.data(), z.data(), v.data());
+  }
+}
+
+std::shared_ptr<DistanceFieldRasterizer> DistanceFieldRasterizer::MakeFrom(
+    std::shared_ptr<ImageCodec> source) {
+  if (source == nullptr || !source->isAlphaOnly()) {
+    return nullptr;
+  }
+  return std::shared_ptr<DistanceFieldRasterizer>(new DistanceFieldRasterizer(std::move(source)));
+}
+
+DistanceFieldRasterizer::DistanceFieldRasterizer(std::shared_ptr<ImageCodec> source)
+    : ImageCodec(source->width() + 2 * Spread, source->height() + 2 * Spread),
+      source(std::move(source)) {
+}
+
+bool DistanceFieldRasterizer::onReadPixels(ColorType colorType, AlphaType alphaType,
+                                           size_t dstRowBytes,
+                                           std::shared_ptr<ColorSpace> dstColorSpace,
+                                           void* dstPixels) const {
+  auto maskInfo = ImageInfo::Make(source->width(), source->height(), ColorType::ALPHA_8);
+  std::vector<uint8_t> mask(maskInfo.byteSize());
+  if (!source->readPixels(maskInfo, mask.data())) {
+    return false;
+  }
+  auto fieldWidth = static_cast<size_t>(width());
+  auto fieldHeight = static_cast<size_t>(height());
+  auto pixelCount = fieldWidth * fieldHeight;
+  // The outer grid holds the squared distances to the inside of the mask, and the inner grid holds
+  // the squared distances to the outside. Partially covered pixels are treated as edges offset by
+  // their coverage, which keeps the sub-pixel precision of the antialiased mask.
+  std::vector<float> outerGrid(pixelCount, DistanceInfinity);
+  std::vector<float> innerGrid(pixelCount, 0.0f);
+  for (int y = 0; y < source->height(); y++) {
+    auto row = mask.data() + static_cast<size_t>(y) * maskInfo.rowBytes();
+    auto gridRow = static_cast<size_t>(y + Spread) * fieldWidth + static_cast<size_t>(Spread);
+    for (int x = 0; x < source->width(); x++) {
+      auto alpha = row[x];
+      auto index = gridRow + static_cast<size_t>(x);
+      if (alpha == 255) {
+        outerGrid[index] = 0.0f;
+        innerGrid[index] = DistanceInfinity;
+      } else if (alpha > 0) {
+        auto coverage = static_cast<float>(alpha) / 255.0f;
+        auto outer = std::max(0.0f, 0.5f - coverage);
+        auto inner = std::max(0.0f, coverage - 0.5f);
+        outerGrid[index] = outer * outer;
+        innerGrid[index] = inner * inner;
+      }
+    }
+  }
+  DistanceTransform2D(outerGrid.data(), fieldWidth, fieldHeight);
+  DistanceTransform2D(innerGrid.data(), fieldWidth, fieldHeight);
+
+  auto fieldInfo = ImageInfo::Make(width(), height(), ColorType::ALPHA_8);
+  std::vector<uint8_t> field = {};
+  auto fieldPixels = static_cast<uint8_t*>(dstPixels);
+  auto fieldRowBytes = dstRowBytes;
+  if (colorType != ColorType::ALPHA_8) {
+    field.resize(fieldInfo.byteSize());
+    fieldPixels = field.data();
+    fieldRowBytes = fieldInfo.rowBytes();
+  }
+  static constexpr float DistanceScale = 0.5f / static_cast<float>(Spread);
+  for (size_t y = 0; y < fieldHeight; y++) {
+    auto row = fieldPixels + y * fieldRowBytes;
+    for (size_t x = 0; x < fieldWidth; x++) {
+      auto index = y * fieldWidth + x;
+      auto distance = std::sqrt(innerGrid[index]) - std::sqrt(outerGrid[index]);
+      auto value = std::clamp(0.5f + distance * DistanceScale, 0.0f, 1.0f);
+      row[x] = static_cast<uint8_t>(std::lround(value * 255.0f));
+    }
+  }
+  if (field.empty()) {
+    return true;
+  }
+  auto dstInfo =
+      ImageInfo::Make(width(), height(), colorType, alphaType, dstRowBytes, dstColorSpace);
+  return Pixmap(fieldInfo, field.data()).readPixels(dstInfo, dstPixels);
+}
+}  // namespace tgfx
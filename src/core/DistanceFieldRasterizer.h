@@ -0,0 +1,59 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "tgfx/core/ImageCodec.h"
+
+namespace tgfx {
+/**
+ * A Rasterizer that converts the coverage mask of another alpha-only codec into a signed distance
+ * field. The field is padded by Spread pixels on each side, and each pixel stores the distance to
+ * the nearest edge of the mask, mapped from [-Spread, Spread] to [0, 1], where 0.5 is the edge and
+ * larger values are inside the mask.
+ */
+class DistanceFieldRasterizer : public ImageCodec {
+ public:
+  /**
+   * The max distance in pixels stored in the field on each side of the edges.
+   */
+  static constexpr int Spread = 8;
+
+  /**
+   * Creates a new DistanceFieldRasterizer from the given alpha-only codec. Returns nullptr if the
+   * source is nullptr or not alpha-only.
+   */
+  static std::shared_ptr<DistanceFieldRasterizer> MakeFrom(std::shared_ptr<ImageCodec> source);
+
+  bool isAlphaOnly() const override {
+    return true;
+  }
+
+  bool asyncSupport() const override {
+    return source->asyncSupport();
+  }
+
+ protected:
+  bool onReadPixels(ColorType colorType, AlphaType alphaType, size_t dstRowBytes,
+                    std::shared_ptr<ColorSpace> dstColorSpace, void* dstPixels) const override;
+
+ private:
+  std::shared_ptr<ImageCodec> source = nullptr;
+
+  explicit DistanceFieldRasterizer(std::shared_ptr<ImageCodec> source);
+};
+}  // namespace tgfx
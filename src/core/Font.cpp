@@ -18,6 +18,7 @@
 
 #include "tgfx/core/Font.h"
 #include "ScalerContext.h"
+#include "core/GlyphPathCache.h"
 #include "core/GlyphRasterizer.h"
 #include "core/PixelBuffer.h"
 
@@ -91,28 +92,28 @@ Rect Font::getBounds(GlyphID glyphID) const {
   if (glyphID == 0) {
     return {};
   }
-  return scalerContext->getBounds(glyphID, fauxBold, fauxItalic);
+  return scalerContext->metricsCache.getBounds(glyphID, fauxBold, fauxItalic);
 }
 
 float Font::getAdvance(GlyphID glyphID, bool verticalText) const {
   if (glyphID == 0) {
     return 0;
   }
-  return scalerContext->getAdvance(glyphID, verticalText);
+  return scalerContext->metricsCache.getAdvance(glyphID, verticalText);
 }
 
 Point Font::getVerticalOffset(GlyphID glyphID) const {
   if (glyphID == 0) {
     return {};
   }
-  return scalerContext->getVerticalOffset(glyphID);
+  return scalerContext->metricsCache.getVerticalOffset(glyphID);
 }
 
 bool Font::getPath(GlyphID glyphID, Path* path) const {
   if (glyphID == 0) {
     return false;
   }
-  return scalerContext->generatePath(glyphID, fauxBold, fauxItalic, path);
+  return GlyphPathCache::Get()->getPath(scalerContext.get(), glyphID, fauxBold, fauxItalic, path);
 }
 
 std::shared_ptr<ImageCodec> Font::getImage(GlyphID glyphID, const Stroke* stroke,
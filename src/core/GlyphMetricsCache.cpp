@@ -0,0 +1,54 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "GlyphMetricsCache.h"
+#include "core/ScalerContext.h"
+
+namespace tgfx {
+Rect GlyphMetricsCache::getBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic) {
+  auto& table = boundsTables[(fauxBold ? 1 : 0) | (fauxItalic ? 2 : 0)];
+  Rect bounds = {};
+  if (table.find(glyphID, &bounds)) {
+    return bounds;
+  }
+  bounds = scalerContext->getBounds(glyphID, fauxBold, fauxItalic);
+  table.add(glyphID, bounds, &usedBytes, MaxCacheBytes);
+  return bounds;
+}
+
+float GlyphMetricsCache::getAdvance(GlyphID glyphID, bool verticalText) {
+  auto& table = advanceTables[verticalText ? 1 : 0];
+  float advance = 0.0f;
+  if (table.find(glyphID, &advance)) {
+    return advance;
+  }
+  advance = scalerContext->getAdvance(glyphID, verticalText);
+  table.add(glyphID, advance, &usedBytes, MaxCacheBytes);
+  return advance;
+}
+
+Point GlyphMetricsCache::getVerticalOffset(GlyphID glyphID) {
+  Point offset = {};
+  if (verticalOffsetTable.find(glyphID, &offset)) {
+    return offset;
+  }
+  offset = scalerContext->getVerticalOffset(glyphID);
+  verticalOffsetTable.add(glyphID, offset, &usedBytes, MaxCacheBytes);
+  return offset;
+}
+}  // namespace tgfx
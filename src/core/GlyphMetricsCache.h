@@ -0,0 +1,177 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include "tgfx/core/Point.h"
+#include "tgfx/core/Rect.h"
+#include "tgfx/core/Typeface.h"
+
+namespace tgfx {
+class ScalerContext;
+
+/**
+ * GlyphMetricsTable is a thread-safe table mapping glyph IDs to a kind of glyph metrics. The
+ * entries are grouped into pages allocated on demand, and lookups never take a lock. The page
+ * directory is also allocated on the first add, so an unused table takes a single pointer. Pages
+ * are only released when the table is destroyed.
+ */
+template <typename T>
+class GlyphMetricsTable {
+ public:
+  GlyphMetricsTable() = default;
+
+  GlyphMetricsTable(const GlyphMetricsTable&) = delete;
+
+  GlyphMetricsTable& operator=(const GlyphMetricsTable&) = delete;
+
+  ~GlyphMetricsTable() {
+    auto pageDirectory = directory.load(std::memory_order_relaxed);
+    if (pageDirectory == nullptr) {
+      return;
+    }
+    for (auto& page : pageDirectory->pages) {
+      delete page.load(std::memory_order_relaxed);
+    }
+    delete pageDirectory;
+  }
+
+  /**
+   * Finds the metrics of the given glyph. Returns false if they are not cached yet.
+   */
+  bool find(GlyphID glyphID, T* value) const {
+    auto pageDirectory = directory.load(std::memory_order_acquire);
+    if (pageDirectory == nullptr) {
+      return false;
+    }
+    auto page = pageDirectory->pages[glyphID >> PageShift].load(std::memory_order_acquire);
+    if (page == nullptr) {
+      return false;
+    }
+    auto& entry = page->entries[glyphID & PageMask];
+    if (entry.state.load(std::memory_order_acquire) != Ready) {
+      return false;
+    }
+    *value = entry.value;
+    return true;
+  }
+
+  /**
+   * Adds the metrics of the given glyph to the table. If a new page or the page directory is
+   * needed but usedBytes would exceed bytesLimit, the metrics are not cached.
+   */
+  void add(GlyphID glyphID, const T& value, std::atomic<size_t>* usedBytes, size_t bytesLimit) {
+    auto pageDirectory = GetOrMake(&directory, usedBytes, bytesLimit);
+    if (pageDirectory == nullptr) {
+      return;
+    }
+    auto page = GetOrMake(&pageDirectory->pages[glyphID >> PageShift], usedBytes, bytesLimit);
+    if (page == nullptr) {
+      return;
+    }
+    auto& entry = page->entries[glyphID & PageMask];
+    uint8_t state = Empty;
+    if (entry.state.compare_exchange_strong(state, Writing, std::memory_order_acquire)) {
+      entry.value = value;
+      entry.state.store(Ready, std::memory_order_release);
+    }
+  }
+
+ private:
+  static constexpr int PageShift = 8;
+  static constexpr int PageSize = 1 << PageShift;
+  static constexpr int PageMask = PageSize - 1;
+  static constexpr int PageCount = (UINT16_MAX + 1) >> PageShift;
+  static constexpr uint8_t Empty = 0;
+  static constexpr uint8_t Writing = 1;
+  static constexpr uint8_t Ready = 2;
+
+  struct Entry {
+    std::atomic<uint8_t> state = {Empty};
+    T value = {};
+  };
+
+  struct Page {
+    Entry entries[PageSize];
+  };
+
+  struct Directory {
+    std::atomic<Page*> pages[PageCount] = {};
+  };
+
+  std::atomic<Directory*> directory = {nullptr};
+
+  template <typename U>
+  static U* GetOrMake(std::atomic<U*>* slot, std::atomic<size_t>* usedBytes, size_t bytesLimit) {
+    auto object = slot->load(std::memory_order_acquire);
+    if (object != nullptr) {
+      return object;
+    }
+    if (usedBytes->fetch_add(sizeof(U), std::memory_order_relaxed) + sizeof(U) > bytesLimit) {
+      usedBytes->fetch_sub(sizeof(U), std::memory_order_relaxed);
+      return nullptr;
+    }
+    auto newObject = new U();
+    if (slot->compare_exchange_strong(object, newObject, std::memory_order_acq_rel,
+                                      std::memory_order_acquire)) {
+      return newObject;
+    }
+    // Another thread has installed the object, which is now loaded into the object variable.
+    delete newObject;
+    usedBytes->fetch_sub(sizeof(U), std::memory_order_relaxed);
+    return object;
+  }
+};
+
+/**
+ * GlyphMetricsCache caches the glyph metrics of a ScalerContext, which are filled lazily on the
+ * first query of each glyph. Lookups of cached glyphs are lock-free, so drawing text on multiple
+ * threads doesn't contend on the lock of the typeface. The memory used by the cache is bounded by
+ * MaxCacheBytes, after which the metrics of uncached glyphs are computed on every query.
+ */
+class GlyphMetricsCache {
+ public:
+  static constexpr size_t MaxCacheBytes = 256 * 1024;
+
+  explicit GlyphMetricsCache(const ScalerContext* scalerContext) : scalerContext(scalerContext) {
+  }
+
+  Rect getBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic);
+
+  float getAdvance(GlyphID glyphID, bool verticalText);
+
+  Point getVerticalOffset(GlyphID glyphID);
+
+  /**
+   * Returns the number of bytes allocated for the cached metrics.
+   */
+  size_t memoryUsage() const {
+    return usedBytes.load(std::memory_order_relaxed);
+  }
+
+ private:
+  const ScalerContext* scalerContext = nullptr;
+  std::atomic<size_t> usedBytes = {0};
+  // Indexed by (fauxBold | fauxItalic << 1).
+  GlyphMetricsTable<Rect> boundsTables[4] = {};
+  // Indexed by verticalText.
+  GlyphMetricsTable<float> advanceTables[2] = {};
+  GlyphMetricsTable<Point> verticalOffsetTable = {};
+};
+}  // namespace tgfx
@@ -0,0 +1,116 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#include "GlyphPathCache.h"
+#include "core/ScalerContext.h"
+
+namespace tgfx {
+static BytesKey MakePathKey(uint32_t typefaceID, GlyphID glyphID, bool fauxBold,
+                            bool fauxItalic) {
+  BytesKey pathKey = {};
+  pathKey.write(typefaceID);
+  auto flags = static_cast<uint32_t>(glyphID) | (fauxBold ? 1u << 16 : 0) |
+               (fauxItalic ? 1u << 17 : 0);
+  pathKey.write(flags);
+  return pathKey;
+}
+
+GlyphPathCache* GlyphPathCache::Get() {
+  static auto& cache = *new GlyphPathCache();
+  return &cache;
+}
+
+bool GlyphPathCache::getPath(const ScalerContext* scalerContext, GlyphID glyphID, bool fauxBold,
+                             bool fauxItalic, Path* path) {
+  auto typeface = scalerContext->getTypeface();
+  if (typeface == nullptr) {
+    return scalerContext->generatePath(glyphID, fauxBold, fauxItalic, path);
+  }
+  auto pathKey = MakePathKey(typeface->uniqueID(), glyphID, fauxBold, fauxItalic);
+  auto size = scalerContext->getSize();
+  auto scaled = size >= MinScaledSize;
+  if (!scaled) {
+    // The key of the shared outline has no size, so it never matches a per-size key.
+    pathKey.write(size);
+  }
+  bool hasOutline = false;
+  if (!findPath(pathKey, path, &hasOutline)) {
+    // Extracts the outline outside the cache lock, as it may take the typeface lock.
+    if (scaled) {
+      auto referenceContext = typeface->getScalerContext(ReferenceSize);
+      hasOutline = referenceContext->generateUnhintedPath(glyphID, fauxBold, fauxItalic, path);
+    } else {
+      hasOutline = scalerContext->generatePath(glyphID, fauxBold, fauxItalic, path);
+    }
+    if (!hasOutline) {
+      path->reset();
+    }
+    addPath(pathKey, path, hasOutline);
+  }
+  if (hasOutline && scaled && size != ReferenceSize) {
+    auto scale = size / ReferenceSize;
+    path->transform(Matrix::MakeScale(scale, scale));
+  }
+  return hasOutline;
+}
+
+size_t GlyphPathCache::cachedPathCount() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  return pathLRU.size();
+}
+
+void GlyphPathCache::purge() {
+  std::lock_guard<std::mutex> autoLock(locker);
+  pathLRU.clear();
+  glyphPaths.clear();
+}
+
+bool GlyphPathCache::findPath(const BytesKey& pathKey, Path* path, bool* hasOutline) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto result = glyphPaths.find(pathKey);
+  if (result == glyphPaths.end()) {
+    return false;
+  }
+  auto& glyphPath = result->second;
+  pathLRU.erase(glyphPath->cachedPosition);
+  pathLRU.push_front(glyphPath.get());
+  glyphPath->cachedPosition = pathLRU.begin();
+  *path = glyphPath->path;
+  *hasOutline = glyphPath->hasOutline;
+  return true;
+}
+
+void GlyphPathCache::addPath(const BytesKey& pathKey, Path* path, bool hasOutline) {
+  std::lock_guard<std::mutex> autoLock(locker);
+  auto result = glyphPaths.find(pathKey);
+  if (result != glyphPaths.end()) {
+    // Another thread has added the same glyph while this one was generating it, use its path to
+    // share the same PathRef.
+    *path = result->second->path;
+    return;
+  }
+  auto glyphPath = std::make_unique<GlyphPath>(*path, hasOutline, pathKey);
+  pathLRU.push_front(glyphPath.get());
+  glyphPath->cachedPosition = pathLRU.begin();
+  glyphPaths[pathKey] = std::move(glyphPath);
+  while (pathLRU.size() > MaxCachedPathCount) {
+    auto oldest = pathLRU.back();
+    pathLRU.pop_back();
+    glyphPaths.erase(oldest->pathKey);
+  }
+}
+}  // namespace tgfx
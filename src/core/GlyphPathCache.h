@@ -0,0 +1,107 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include "tgfx/core/BytesKey.h"
+#include "tgfx/core/Path.h"
+#include "tgfx/core/Typeface.h"
+
+namespace tgfx {
+class ScalerContext;
+
+/**
+ * GlyphPathCache is a process-wide, thread-safe LRU cache of glyph outlines keyed by the typeface
+ * ID, glyph ID and faux bold/italic styles. Text sizes at or above MinScaledSize share one
+ * unhinted outline extracted at ReferenceSize, and only apply a scale matrix to it, so fonts of
+ * different sizes don't go back to the typeface for the same glyph. Smaller sizes keep their own
+ * hinted outline per size. Every path returned for the same glyph at a small size, or for the
+ * outline at ReferenceSize, shares one PathRef, which keeps the unique keys of the downstream shape
+ * caches stable.
+ */
+class GlyphPathCache {
+ public:
+  /**
+   * The smallest text size whose glyph path is scaled from the shared unhinted outline. Below it,
+   * hinting snaps stems and heights to whole pixels visibly, so the hinted outline is cached for
+   * each size. Above it, hinting moves the outline by less than the antialiasing can show.
+   */
+  static constexpr float MinScaledSize = 48.0f;
+
+  /**
+   * The text size at which the shared unhinted outlines are extracted, large enough that the
+   * 26.6 fixed-point precision of the outlines stays far below a pixel once scaled.
+   */
+  static constexpr float ReferenceSize = 256.0f;
+
+  /**
+   * The maximum number of glyph paths kept in the cache.
+   */
+  static constexpr size_t MaxCachedPathCount = 2048;
+
+  /**
+   * Returns the process-wide GlyphPathCache instance.
+   */
+  static GlyphPathCache* Get();
+
+  /**
+   * Finds the outline of the given glyph in the cache, or generates it through the scaler context
+   * if it is not cached yet. Returns false if the glyph has no outline.
+   */
+  bool getPath(const ScalerContext* scalerContext, GlyphID glyphID, bool fauxBold,
+               bool fauxItalic, Path* path);
+
+  /**
+   * Returns the number of glyph paths currently in the cache.
+   */
+  size_t cachedPathCount();
+
+  /**
+   * Removes all glyph paths from the cache.
+   */
+  void purge();
+
+ private:
+  struct GlyphPath {
+    GlyphPath(Path path, bool hasOutline, BytesKey pathKey)
+        : path(std::move(path)), hasOutline(hasOutline), pathKey(std::move(pathKey)) {
+    }
+
+    Path path = {};
+    bool hasOutline = false;
+    BytesKey pathKey = {};
+    std::list<GlyphPath*>::iterator cachedPosition = {};
+  };
+
+  std::mutex locker = {};
+  std::list<GlyphPath*> pathLRU = {};
+  BytesKeyMap<std::unique_ptr<GlyphPath>> glyphPaths = {};
+
+  GlyphPathCache() = default;
+
+  bool findPath(const BytesKey& pathKey, Path* path, bool* hasOutline);
+
+  /**
+   * Adds the path to the cache. If the same key is already cached, the path is replaced with the
+   * cached one instead.
+   */
+  void addPath(const BytesKey& pathKey, Path* path, bool hasOutline);
+};
+}  // namespace tgfx
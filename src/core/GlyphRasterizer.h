@@ -36,6 +36,18 @@ class GlyphRasterizer : public ImageCodec {
     return !scalerContext->hasColor();
   }
 
+  std::shared_ptr<ScalerContext> getScalerContext() const {
+    return scalerContext;
+  }
+
+  /**
+   * Returns a request to rasterize the glyph into the given pixels, which must have the same
+   * dimensions as the rasterizer.
+   */
+  GlyphPixelsRequest makePixelsRequest(const ImageInfo& dstInfo, void* dstPixels) const {
+    return {glyphID, fauxBold, stroke, dstInfo, dstPixels};
+  }
+
  protected:
   bool onReadPixels(ColorType colorType, AlphaType alphaType, size_t dstRowBytes,
                     std::shared_ptr<ColorSpace> dstColorSpace, void* dstPixels) const override;
@@ -18,6 +18,7 @@
 
 #include "tgfx/core/ImageBuffer.h"
 #include <memory>
+#include "core/CompressedImageBuffer.h"
 #include "core/PixelBuffer.h"
 #include "core/YUVHardwareBuffer.h"
 #include "core/utils/ColorSpaceHelper.h"
@@ -92,4 +93,18 @@ std::shared_ptr<ImageBuffer> ImageBuffer::MakeNV12(std::shared_ptr<YUVData> yuvD
   }
   return std::make_shared<YUVBuffer>(std::move(yuvData), YUVFormat::NV12, colorSpace);
 }
+
+std::shared_ptr<Data> ImageBuffer::CompressETC2(std::shared_ptr<ImageCodec> codec) {
+  auto buffer = CompressedImageBuffer::MakeFrom(std::move(codec));
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  return buffer->data();
+}
+
+std::shared_ptr<ImageBuffer> ImageBuffer::MakeETC2(std::shared_ptr<Data> blocks, int width,
+                                                   int height,
+                                                   std::shared_ptr<ColorSpace> colorSpace) {
+  return CompressedImageBuffer::MakeFrom(std::move(blocks), width, height, std::move(colorSpace));
+}
 }  // namespace tgfx
@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ImageSource.h"
+#include "core/CompressedImageBuffer.h"
 
 namespace tgfx {
 std::unique_ptr<DataSource<ImageBuffer>> ImageSource::MakeFrom(
@@ -37,7 +38,54 @@ std::unique_ptr<DataSource<ImageBuffer>> ImageSource::MakeFrom(
   return imageSource;
 }
 
-ImageSource::ImageSource(std::shared_ptr<ImageGenerator> generator, bool tryHardware)
-    : generator(std::move(generator)), tryHardware(tryHardware) {
+std::unique_ptr<DataSource<ImageBuffer>> ImageSource::MakeCompressed(
+    std::shared_ptr<ImageCodec> codec, bool asyncDecoding) {
+  if (codec == nullptr) {
+    return nullptr;
+  }
+  auto imageSource = std::make_unique<ImageSource>(std::move(codec), false, true);
+  if (asyncDecoding) {
+    return Async(std::move(imageSource));
+  }
+  return imageSource;
+}
+
+std::unique_ptr<DataSource<ImageBuffer>> ImageSource::MakeStaging(
+    std::shared_ptr<ImageCodec> codec, std::shared_ptr<StagingImageBuffer> stagingBuffer,
+    bool asyncDecoding) {
+  if (codec == nullptr || stagingBuffer == nullptr) {
+    return nullptr;
+  }
+  auto imageSource = std::make_unique<ImageSource>(std::move(codec), std::move(stagingBuffer));
+  if (asyncDecoding) {
+    return Async(std::move(imageSource));
+  }
+  return imageSource;
+}
+
+ImageSource::ImageSource(std::shared_ptr<ImageGenerator> generator, bool tryHardware,
+                         bool compressed)
+    : generator(std::move(generator)), tryHardware(tryHardware), compressed(compressed) {
+}
+
+ImageSource::ImageSource(std::shared_ptr<ImageCodec> codec,
+                         std::shared_ptr<StagingImageBuffer> stagingBuffer)
+    : generator(std::move(codec)), tryHardware(false), stagingBuffer(std::move(stagingBuffer)) {
+}
+
+std::shared_ptr<ImageBuffer> ImageSource::getData() const {
+  if (stagingBuffer != nullptr) {
+    auto codec = std::static_pointer_cast<ImageCodec>(generator);
+    if (codec->readPixels(stagingBuffer->info(), stagingBuffer->pixels())) {
+      return stagingBuffer;
+    }
+  }
+  if (compressed) {
+    auto codec = std::static_pointer_cast<ImageCodec>(generator);
+    if (auto buffer = CompressedImageBuffer::MakeFrom(std::move(codec))) {
+      return buffer;
+    }
+  }
+  return generator->makeBuffer(tryHardware);
 }
 }  // namespace tgfx
@@ -19,6 +19,8 @@
 #pragma once
 
 #include "core/DataSource.h"
+#include "core/StagingImageBuffer.h"
+#include "tgfx/core/ImageCodec.h"
 #include "tgfx/core/ImageGenerator.h"
 
 namespace tgfx {
@@ -35,14 +37,33 @@ class ImageSource : public DataSource<ImageBuffer> {
   static std::unique_ptr<DataSource> MakeFrom(std::shared_ptr<ImageGenerator> generator,
                                               bool tryHardware = true, bool asyncDecoding = true);
 
-  ImageSource(std::shared_ptr<ImageGenerator> generator, bool tryHardware);
+  /**
+   * Creates an image source that decodes the codec and compresses the pixels into ETC2 blocks. If
+   * the compression fails, the image source falls back to the uncompressed pixels.
+   */
+  static std::unique_ptr<DataSource> MakeCompressed(std::shared_ptr<ImageCodec> codec,
+                                                    bool asyncDecoding = true);
+
+  /**
+   * Creates an image source that decodes the codec straight into the mapped memory of the staging
+   * buffer, which the GPU then copies to the texture. The staging buffer must match the size of
+   * the codec. If the decoding into the staging buffer fails, the image source falls back to the
+   * pixels decoded into client memory.
+   */
+  static std::unique_ptr<DataSource> MakeStaging(std::shared_ptr<ImageCodec> codec,
+                                                 std::shared_ptr<StagingImageBuffer> stagingBuffer,
+                                                 bool asyncDecoding = true);
+
+  ImageSource(std::shared_ptr<ImageGenerator> generator, bool tryHardware, bool compressed = false);
+
+  ImageSource(std::shared_ptr<ImageCodec> codec, std::shared_ptr<StagingImageBuffer> stagingBuffer);
 
-  std::shared_ptr<ImageBuffer> getData() const override {
-    return generator->makeBuffer(tryHardware);
-  }
+  std::shared_ptr<ImageBuffer> getData() const override;
 
  private:
   std::shared_ptr<ImageGenerator> generator = nullptr;
   bool tryHardware = true;
+  bool compressed = false;
+  std::shared_ptr<StagingImageBuffer> stagingBuffer = nullptr;
 };
 }  // namespace tgfx
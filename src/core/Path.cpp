@@ -179,6 +179,10 @@ Rect Path::getBounds() const {
   return pathRef->getBounds();
 }
 
+bool Path::isConvex() const {
+  return pathRef->isConvex();
+}
+
 bool Path::isEmpty() const {
   return pathRef->path.isEmpty();
 }
@@ -592,6 +596,7 @@ PathRef* Path::writableRef() {
     // There only one reference to this PathRef, so we can safely reset the uniqueKey and bounds.
     pathRef->uniqueKey.reset();
     pathRef->bounds.reset();
+    pathRef->convexity.store(PathRef::Convexity::Unknown, std::memory_order_relaxed);
   }
   return pathRef.get();
 }
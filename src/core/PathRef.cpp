@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "PathRef.h"
+#include <vector>
 #include "tgfx/core/Path.h"
 
 namespace tgfx {
@@ -51,4 +52,97 @@ Rect PathRef::getBounds() {
   bounds.update(newBounds);
   return newBounds;
 }
+
+static int Sign(float value) {
+  return value > 0 ? 1 : (value < 0 ? -1 : 0);
+}
+
+static bool IsConvexPolygon(const std::vector<SkPoint>& points) {
+  auto count = points.size();
+  if (count < 3) {
+    return false;
+  }
+  int turnSign = 0;
+  int lastXSign = 0;
+  int firstXSign = 0;
+  int xSignChanges = 0;
+  for (size_t i = 0; i < count; i++) {
+    auto& a = points[i];
+    auto& b = points[(i + 1) % count];
+    auto& c = points[(i + 2) % count];
+    auto cross = (b.fX - a.fX) * (c.fY - b.fY) - (b.fY - a.fY) * (c.fX - b.fX);
+    auto sign = Sign(cross);
+    if (sign != 0) {
+      if (turnSign != 0 && sign != turnSign) {
+        return false;
+      }
+      turnSign = sign;
+    }
+    // A polygon that turns in one direction can still wind around more than once, like a
+    // pentagram. A convex one changes its direction along the x-axis at most twice.
+    auto xSign = Sign(b.fX - a.fX);
+    if (xSign != 0) {
+      if (firstXSign == 0) {
+        firstXSign = xSign;
+      } else if (xSign != lastXSign) {
+        xSignChanges++;
+      }
+      lastXSign = xSign;
+    }
+  }
+  if (lastXSign != firstXSign) {
+    xSignChanges++;
+  }
+  return turnSign != 0 && xSignChanges <= 2;
+}
+
+bool PathRef::isConvex() {
+  auto cachedConvexity = convexity.load(std::memory_order_acquire);
+  if (cachedConvexity != Convexity::Unknown) {
+    return cachedConvexity == Convexity::Convex;
+  }
+  std::vector<SkPoint> points = {};
+  points.reserve(static_cast<size_t>(path.countPoints()));
+  bool hasContour = false;
+  bool isConvex = true;
+  SkPath::Iter iter(path, false);
+  SkPoint verbPoints[4];
+  SkPath::Verb verb;
+  while (isConvex && (verb = iter.next(verbPoints)) != SkPath::kDone_Verb) {
+    int pointCount = 0;
+    switch (verb) {
+      case SkPath::kMove_Verb:
+        // Only a single contour can be convex.
+        isConvex = !hasContour;
+        hasContour = true;
+        points.push_back(verbPoints[0]);
+        break;
+      case SkPath::kLine_Verb:
+        pointCount = 1;
+        break;
+      case SkPath::kQuad_Verb:
+      case SkPath::kConic_Verb:
+        pointCount = 2;
+        break;
+      case SkPath::kCubic_Verb:
+        pointCount = 3;
+        break;
+      default:
+        break;
+    }
+    for (int i = 1; i <= pointCount; i++) {
+      auto& point = verbPoints[i];
+      if (point.fX != points.back().fX || point.fY != points.back().fY) {
+        points.push_back(point);
+      }
+    }
+  }
+  if (points.size() > 1 && points.back().fX == points.front().fX &&
+      points.back().fY == points.front().fY) {
+    points.pop_back();
+  }
+  isConvex = isConvex && IsConvexPolygon(points);
+  convexity.store(isConvex ? Convexity::Convex : Convexity::Concave, std::memory_order_release);
+  return isConvex;
+}
 }  // namespace tgfx
\ No newline at end of file
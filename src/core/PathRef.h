@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <atomic>
 #include "core/utils/LazyBounds.h"
 #include "gpu/resources/ResourceKey.h"
 #pragma clang diagnostic push
@@ -45,9 +46,18 @@ class PathRef {
 
   Rect getBounds();
 
+  /**
+   * Returns true if the path has a single contour whose points, including the control points of
+   * curves, form a convex polygon. The result is computed once and cached until the path changes.
+   */
+  bool isConvex();
+
  private:
+  enum class Convexity : uint8_t { Unknown, Convex, Concave };
+
   LazyUniqueKey uniqueKey = {};
   LazyBounds bounds = {};
+  std::atomic<Convexity> convexity = {Convexity::Unknown};
   pk::SkPath path = {};
 
   friend bool operator==(const Path& a, const Path& b);
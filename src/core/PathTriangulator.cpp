@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "PathTriangulator.h"
+#include <algorithm>
 #include "PathRef.h"
 #include "pathkit.h"
 
@@ -40,6 +41,12 @@ static constexpr int MAX_RASTERIZED_TEXTURE_SIZE = 4096;
 
 static constexpr int MIN_TRIANGULATE_SIZE = 162;
 
+static constexpr int MAX_CURVE_SEGMENTS = 256;
+
+// The minimum value of (1 + cos(angle)) between the normals of two adjacent edges of a convex path
+// to inset its corner for antialiasing. Sharper corners would produce very long miters.
+static constexpr float MIN_CONVEX_MITER_FACTOR = 0.1f;
+
 bool PathTriangulator::ShouldTriangulatePath(const Path& path) {
   auto bounds = path.getBounds();
   auto width = static_cast<int>(ceilf(bounds.width()));
@@ -61,6 +68,16 @@ bool PathTriangulator::ShouldTriangulatePath(const Path& path) {
   return path.countPoints() * AA_TESSELLATOR_BUFFER_SIZE_FACTOR <= width * height;
 }
 
+bool PathTriangulator::ShouldStencilPath(const Path& path, const Matrix& viewMatrix) {
+  if (path.countVerbs() <= AA_TESSELLATOR_MAX_VERB_COUNT) {
+    // Simple paths are cheap to tessellate, and their triangles are cached.
+    return false;
+  }
+  auto bounds = viewMatrix.mapRect(path.getBounds());
+  // Small paths are rasterized into masks, which are cheap and also cached.
+  return std::max(bounds.width(), bounds.height()) > static_cast<float>(MIN_TRIANGULATE_SIZE);
+}
+
 size_t PathTriangulator::GetTriangleCount(size_t bufferSize) {
   return bufferSize / (sizeof(float) * 2);
 }
@@ -88,4 +105,380 @@ size_t PathTriangulator::ToAATriangles(const Path& path, const Rect& clipBounds,
                                     *reinterpret_cast<const pk::SkRect*>(&clipBounds), vertices);
   return static_cast<size_t>(count);
 }
+
+// Returns the number of line segments needed to flatten a curve within the tolerance, using Wang's
+// formula with the largest second difference of the control points.
+static int GetCurveSegmentCount(float maxSecondDifference, int degree) {
+  auto factor = static_cast<float>(degree * (degree - 1)) / 8.0f;
+  auto count = ceilf(sqrtf(factor * maxSecondDifference / DefaultTolerance));
+  return std::clamp(static_cast<int>(count), 1, MAX_CURVE_SEGMENTS);
+}
+
+// Appends the points of the flattened quad to the given points, excluding the start point.
+static void FlattenQuad(const Point points[3], std::vector<Point>* result) {
+  auto count = GetCurveSegmentCount((points[0] - points[1] * 2.0f + points[2]).length(), 2);
+  for (int i = 1; i <= count; i++) {
+    auto t = static_cast<float>(i) / static_cast<float>(count);
+    auto mt = 1.0f - t;
+    result->push_back(points[0] * (mt * mt) + points[1] * (2.0f * mt * t) + points[2] * (t * t));
+  }
+}
+
+// Appends the points of the flattened cubic to the given points, excluding the start point.
+static void FlattenCubic(const Point points[4], std::vector<Point>* result) {
+  auto difference = std::max((points[0] - points[1] * 2.0f + points[2]).length(),
+                             (points[1] - points[2] * 2.0f + points[3]).length());
+  auto count = GetCurveSegmentCount(difference, 3);
+  for (int i = 1; i <= count; i++) {
+    auto t = static_cast<float>(i) / static_cast<float>(count);
+    auto mt = 1.0f - t;
+    result->push_back(points[0] * (mt * mt * mt) + points[1] * (3.0f * mt * mt * t) +
+                      points[2] * (3.0f * mt * t * t) + points[3] * (t * t * t));
+  }
+}
+
+class HairlineWriter {
+ public:
+  HairlineWriter(LineCap cap, bool antialias, std::vector<float>* vertices)
+      : cap(cap), antialias(antialias), vertices(vertices) {
+  }
+
+  void moveTo(const Point& point) {
+    finishContour();
+    contour.push_back(point);
+  }
+
+  void lineTo(const Point& point) {
+    contour.push_back(point);
+  }
+
+  void quadTo(const Point points[3]) {
+    FlattenQuad(points, &contour);
+  }
+
+  void cubicTo(const Point points[4]) {
+    FlattenCubic(points, &contour);
+  }
+
+  void close() {
+    if (!contour.empty() && contour.back() != contour.front()) {
+      contour.push_back(contour.front());
+    }
+    closed = true;
+    finishContour();
+  }
+
+  size_t finish() {
+    finishContour();
+    return triangleCount;
+  }
+
+ private:
+  LineCap cap = LineCap::Butt;
+  bool antialias = false;
+  std::vector<float>* vertices = nullptr;
+  std::vector<Point> contour = {};
+  bool closed = false;
+  size_t triangleCount = 0;
+
+  void finishContour() {
+    if (contour.size() > 1) {
+      if (!closed && cap != LineCap::Butt) {
+        extendEnds();
+      }
+      writeContour();
+    }
+    contour.clear();
+    closed = false;
+  }
+
+  // Adjacent segments share the offset points at their joint, which are mitered from the normals
+  // of both segments. This way every pixel along the contour is covered only once, and translucent
+  // hairlines don't get darker dots at the joints. Joints sharper than the miter limit keep the
+  // normals of their own segments, as the mitered points would reach too far.
+  void writeContour() {
+    auto end = std::unique(contour.begin(), contour.end());
+    auto count = static_cast<size_t>(end - contour.begin());
+    if (count < 2) {
+      return;
+    }
+    std::vector<Point> normals(count - 1);
+    for (size_t i = 0; i + 1 < count; i++) {
+      auto direction = contour[i + 1] - contour[i];
+      auto length = direction.length();
+      normals[i] = Point::Make(-direction.y / length, direction.x / length);
+    }
+    auto segmentCount = normals.size();
+    std::vector<Point> startOffsets = normals;
+    std::vector<Point> endOffsets = normals;
+    auto closedContour = closed && segmentCount > 1 && contour[0] == contour[count - 1];
+    for (size_t i = closedContour ? 0 : 1; i < segmentCount; i++) {
+      auto previous = i == 0 ? segmentCount - 1 : i - 1;
+      Point miter = {};
+      if (MiterNormals(normals[previous], normals[i], &miter)) {
+        endOffsets[previous] = miter;
+        startOffsets[i] = miter;
+      }
+    }
+    auto width = antialias ? 1.0f : 0.5f;
+    for (size_t i = 0; i < segmentCount; i++) {
+      writeSegment(contour[i], contour[i + 1], startOffsets[i] * width, endOffsets[i] * width);
+    }
+  }
+
+  static bool MiterNormals(const Point& a, const Point& b, Point* miter) {
+    // The miter length is 1 / cos(angle / 2), and 1 + dot(a, b) equals 2 * cos(angle / 2)^2.
+    static constexpr float MiterLimit = 4.0f;
+    static constexpr float MinDenominator = 2.0f / (MiterLimit * MiterLimit);
+    auto denominator = 1.0f + a.x * b.x + a.y * b.y;
+    if (denominator < MinDenominator) {
+      return false;
+    }
+    *miter = (a + b) * (1.0f / denominator);
+    return true;
+  }
+
+  // Caps of an open contour extend its ends by half the line width, the same as stroking it one
+  // pixel wide. A zero-length contour still draws a dot.
+  void extendEnds() {
+    auto& front = contour.front();
+    auto& back = contour.back();
+    auto next = std::find_if(contour.begin(), contour.end(),
+                             [&](const Point& point) { return point != front; });
+    if (next == contour.end()) {
+      contour = {front - Point::Make(0.5f, 0.0f), front + Point::Make(0.5f, 0.0f)};
+      return;
+    }
+    auto startDirection = front - *next;
+    auto previous = std::find_if(contour.rbegin(), contour.rend(),
+                                 [&](const Point& point) { return point != back; });
+    auto endDirection = back - *previous;
+    front += startDirection * (0.5f / startDirection.length());
+    back += endDirection * (0.5f / endDirection.length());
+  }
+
+  void writeSegment(const Point& start, const Point& end, const Point& startOffset,
+                    const Point& endOffset) {
+    if (!antialias) {
+      writeQuad(start + startOffset, end + endOffset, end - endOffset, start - startOffset);
+      triangleCount += 2;
+      return;
+    }
+    // The coverage falls linearly from the center line to zero one pixel away, which equals the
+    // coverage of a one-pixel-wide line filtered by a one-pixel box.
+    for (auto side : {1.0f, -1.0f}) {
+      writeVertex(start, 1.0f);
+      writeVertex(end, 1.0f);
+      writeVertex(end + endOffset * side, 0.0f);
+      writeVertex(start, 1.0f);
+      writeVertex(end + endOffset * side, 0.0f);
+      writeVertex(start + startOffset * side, 0.0f);
+    }
+    triangleCount += 4;
+  }
+
+  void writeQuad(const Point& a, const Point& b, const Point& c, const Point& d) {
+    for (auto& point : {a, b, c, a, c, d}) {
+      vertices->push_back(point.x);
+      vertices->push_back(point.y);
+    }
+  }
+
+  void writeVertex(const Point& point, float coverage) {
+    vertices->push_back(point.x);
+    vertices->push_back(point.y);
+    vertices->push_back(coverage);
+  }
+};
+
+size_t PathTriangulator::ToHairlineTriangles(const Path& path, LineCap cap, bool antialias,
+                                             std::vector<float>* vertices) {
+  HairlineWriter writer(cap, antialias, vertices);
+  path.decompose(
+      [](PathVerb verb, const Point points[4], void* info) {
+        auto hairlineWriter = static_cast<HairlineWriter*>(info);
+        switch (verb) {
+          case PathVerb::Move:
+            hairlineWriter->moveTo(points[0]);
+            break;
+          case PathVerb::Line:
+            hairlineWriter->lineTo(points[1]);
+            break;
+          case PathVerb::Quad:
+            hairlineWriter->quadTo(points);
+            break;
+          case PathVerb::Cubic:
+            hairlineWriter->cubicTo(points);
+            break;
+          case PathVerb::Close:
+            hairlineWriter->close();
+            break;
+        }
+      },
+      &writer);
+  return writer.finish();
+}
+
+static void WriteConvexVertex(std::vector<float>* vertices, const Point& point, float coverage) {
+  vertices->push_back(point.x);
+  vertices->push_back(point.y);
+  vertices->push_back(coverage);
+}
+
+static float CrossProduct(const Point& a, const Point& b) {
+  return a.x * b.y - a.y * b.x;
+}
+
+size_t PathTriangulator::ToConvexTriangles(const Path& path, bool antialias,
+                                           std::vector<float>* vertices) {
+  std::vector<Point> points = {};
+  path.decompose(
+      [](PathVerb verb, const Point pts[4], void* info) {
+        auto result = static_cast<std::vector<Point>*>(info);
+        switch (verb) {
+          case PathVerb::Move:
+            result->push_back(pts[0]);
+            break;
+          case PathVerb::Line:
+            result->push_back(pts[1]);
+            break;
+          case PathVerb::Quad:
+            FlattenQuad(pts, result);
+            break;
+          case PathVerb::Cubic:
+            FlattenCubic(pts, result);
+            break;
+          default:
+            break;
+        }
+      },
+      &points);
+  std::vector<Point> polygon = {};
+  polygon.reserve(points.size());
+  for (auto& point : points) {
+    if (polygon.empty() || point != polygon.back()) {
+      polygon.push_back(point);
+    }
+  }
+  if (polygon.size() > 1 && polygon.back() == polygon.front()) {
+    polygon.pop_back();
+  }
+  auto count = polygon.size();
+  if (count < 3) {
+    return 0;
+  }
+  float area = 0.0f;
+  for (size_t i = 0; i < count; i++) {
+    area += CrossProduct(polygon[i], polygon[(i + 1) % count]);
+  }
+  if (area == 0.0f) {
+    return 0;
+  }
+  if (!antialias) {
+    for (size_t i = 1; i + 1 < count; i++) {
+      for (auto& point : {polygon[0], polygon[i], polygon[i + 1]}) {
+        vertices->push_back(point.x);
+        vertices->push_back(point.y);
+      }
+    }
+    return count - 2;
+  }
+  // The outward normal of each edge, from polygon[i] to polygon[i + 1].
+  std::vector<Point> normals(count);
+  for (size_t i = 0; i < count; i++) {
+    auto direction = polygon[(i + 1) % count] - polygon[i];
+    auto length = direction.length();
+    normals[i] = area > 0 ? Point::Make(direction.y / length, -direction.x / length)
+                          : Point::Make(-direction.y / length, direction.x / length);
+  }
+  // Every edge ramps its coverage from half a pixel inside to half a pixel outside, so the inner
+  // polygon is the path inset by half a pixel.
+  std::vector<Point> insets(count);
+  for (size_t i = 0; i < count; i++) {
+    auto& previousNormal = normals[(i + count - 1) % count];
+    auto& normal = normals[i];
+    auto factor = 1.0f + previousNormal.x * normal.x + previousNormal.y * normal.y;
+    if (factor < MIN_CONVEX_MITER_FACTOR) {
+      return 0;
+    }
+    insets[i] = polygon[i] - (previousNormal + normal) * (0.5f / factor);
+  }
+  for (size_t i = 0; i < count; i++) {
+    auto next = (i + 1) % count;
+    auto edge = polygon[next] - polygon[i];
+    auto insetEdge = insets[next] - insets[i];
+    if (edge.x * insetEdge.x + edge.y * insetEdge.y <= 0) {
+      // The path is too thin to be inset by half a pixel.
+      return 0;
+    }
+  }
+  for (size_t i = 1; i + 1 < count; i++) {
+    WriteConvexVertex(vertices, insets[0], 1.0f);
+    WriteConvexVertex(vertices, insets[i], 1.0f);
+    WriteConvexVertex(vertices, insets[i + 1], 1.0f);
+  }
+  for (size_t i = 0; i < count; i++) {
+    auto next = (i + 1) % count;
+    auto offset = normals[i] * 0.5f;
+    auto outerStart = polygon[i] + offset;
+    auto outerEnd = polygon[next] + offset;
+    WriteConvexVertex(vertices, insets[i], 1.0f);
+    WriteConvexVertex(vertices, outerStart, 0.0f);
+    WriteConvexVertex(vertices, outerEnd, 0.0f);
+    WriteConvexVertex(vertices, insets[i], 1.0f);
+    WriteConvexVertex(vertices, outerEnd, 0.0f);
+    WriteConvexVertex(vertices, insets[next], 1.0f);
+    // Fills the gap between the outer edges at the corner.
+    WriteConvexVertex(vertices, insets[next], 1.0f);
+    WriteConvexVertex(vertices, outerEnd, 0.0f);
+    WriteConvexVertex(vertices, polygon[next] + normals[next] * 0.5f, 0.0f);
+  }
+  return count - 2 + count * 3;
+}
+
+struct StencilContours {
+  std::vector<Point> points = {};
+  std::vector<size_t> starts = {};
+};
+
+size_t PathTriangulator::ToStencilTriangles(const Path& path, std::vector<float>* vertices) {
+  StencilContours contours = {};
+  path.decompose(
+      [](PathVerb verb, const Point points[4], void* info) {
+        auto result = static_cast<StencilContours*>(info);
+        switch (verb) {
+          case PathVerb::Move:
+            result->starts.push_back(result->points.size());
+            result->points.push_back(points[0]);
+            break;
+          case PathVerb::Line:
+            result->points.push_back(points[1]);
+            break;
+          case PathVerb::Quad:
+            FlattenQuad(points, &result->points);
+            break;
+          case PathVerb::Cubic:
+            FlattenCubic(points, &result->points);
+            break;
+          default:
+            // The fan of every contour is closed implicitly by its first point.
+            break;
+        }
+      },
+      &contours);
+  size_t count = 0;
+  auto& points = contours.points;
+  for (size_t i = 0; i < contours.starts.size(); i++) {
+    auto start = contours.starts[i];
+    auto end = i + 1 < contours.starts.size() ? contours.starts[i + 1] : points.size();
+    for (auto index = start + 2; index < end; index++) {
+      for (auto& point : {points[start], points[index - 1], points[index]}) {
+        vertices->push_back(point.x);
+        vertices->push_back(point.y);
+      }
+      count++;
+    }
+  }
+  return count;
+}
 }  // namespace tgfx
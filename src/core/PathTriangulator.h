@@ -19,6 +19,7 @@
 #pragma once
 
 #include "tgfx/core/Path.h"
+#include "tgfx/core/Stroke.h"
 
 namespace tgfx {
 /**
@@ -32,6 +33,13 @@ class PathTriangulator {
    */
   static bool ShouldTriangulatePath(const Path& path);
 
+  /**
+   * Determines if the path should be filled through the stencil buffer instead of being
+   * triangulated or rasterized on the CPU. This is preferred for large and complex paths, which are
+   * costly to tessellate or rasterize. The viewMatrix maps the path to device space.
+   */
+  static bool ShouldStencilPath(const Path& path, const Matrix& viewMatrix = Matrix::I());
+
   /**
    * Returns the number of triangles based on the buffer size of the vertices.
    */
@@ -55,5 +63,33 @@ class PathTriangulator {
    */
   static size_t ToAATriangles(const Path& path, const Rect& clipBounds,
                               std::vector<float>* vertices);
+
+  /**
+   * Triangulates the given convex path in device space as a triangle fan, skipping the general
+   * tessellator. If antialias is true, the fan is inset by half a pixel and every edge gets a
+   * one-pixel coverage ramp, written in the layout of ToAATriangles(). Otherwise, it is written in
+   * the layout of ToTriangles(). Returns 0 if the path is too thin or has corners too sharp for the
+   * ramps, in which case the caller should fall back to the other methods.
+   */
+  static size_t ToConvexTriangles(const Path& path, bool antialias, std::vector<float>* vertices);
+
+  /**
+   * Converts the given path in device space into triangle fans for writing its winding numbers to
+   * the stencil buffer. Curves are flattened, and each contour becomes a fan around its first
+   * point, written in the layout of ToTriangles(). The fans overlap, so they must not be drawn to
+   * the color buffer directly. Returns the number of triangles written to the vertices.
+   */
+  static size_t ToStencilTriangles(const Path& path, std::vector<float>* vertices);
+
+  /**
+   * Converts the given path in device space into one-pixel-wide hairlines without stroking it. Every
+   * line segment, including those flattened from curves, becomes a quad along the segment, and
+   * adjacent quads are mitered at their joint so that they don't overlap. If
+   * antialias is true, the quad is written in the layout of ToAATriangles(), with a coverage ramp
+   * from the center line to one pixel away on both sides. Otherwise, it is written in the layout of
+   * ToTriangles(). Returns the number of triangles written to the vertices.
+   */
+  static size_t ToHairlineTriangles(const Path& path, LineCap cap, bool antialias,
+                                    std::vector<float>* vertices);
 };
 }  // namespace tgfx
@@ -0,0 +1,124 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/core/ReadbackRing.h"
+#include "core/utils/Log.h"
+#include "gpu/proxies/GPUBufferProxy.h"
+#include "tgfx/core/Surface.h"
+
+namespace tgfx {
+std::shared_ptr<ReadbackRing> ReadbackRing::Make(size_t capacity) {
+  if (capacity == 0) {
+    return nullptr;
+  }
+  return std::shared_ptr<ReadbackRing>(new ReadbackRing(capacity));
+}
+
+int64_t ReadbackRing::readPixels(Surface* surface, const Rect& rect) {
+  if (surface == nullptr || _pendingCount == slots.size()) {
+    return -1;
+  }
+  auto& slot = slots[(firstPending + _pendingCount) % slots.size()];
+  // The readback buffer of the slot is reused if it is large enough for the new frame.
+  if (!surface->transferPixels(rect, &slot.info, &slot.readbackBuffer, &slot.bufferSize)) {
+    return -1;
+  }
+  slot.frameIndex = nextFrameIndex++;
+  slot.submitSerial = surface->getContext()->nextSubmitSerial();
+  _pendingCount++;
+  return slot.frameIndex;
+}
+
+const ReadbackRing::Slot* ReadbackRing::findPendingSlot(int64_t frameIndex) const {
+  if (_pendingCount == 0) {
+    return nullptr;
+  }
+  auto firstFrameIndex = slots[firstPending].frameIndex;
+  if (frameIndex < firstFrameIndex ||
+      frameIndex >= firstFrameIndex + static_cast<int64_t>(_pendingCount)) {
+    return nullptr;
+  }
+  auto offset = static_cast<size_t>(frameIndex - firstFrameIndex);
+  return &slots[(firstPending + offset) % slots.size()];
+}
+
+bool ReadbackRing::isReady(Context* context, int64_t frameIndex) const {
+  auto slot = findPendingSlot(frameIndex);
+  if (slot == nullptr) {
+    return false;
+  }
+  if (context != slot->readbackBuffer->getContext()) {
+    LOGE("ReadbackRing::isReady() Context mismatch!");
+    return false;
+  }
+  if (context->submitSerial() < slot->submitSerial) {
+    return false;
+  }
+  auto readbackBuffer = slot->readbackBuffer->getBuffer();
+  if (readbackBuffer == nullptr) {
+    return false;
+  }
+  return readbackBuffer->gpuBuffer()->isReady();
+}
+
+size_t ReadbackRing::poll(Context* context, const Callback& callback, bool wait) {
+  size_t count = 0;
+  while (_pendingCount > 0) {
+    auto& slot = slots[firstPending];
+    if (context != slot.readbackBuffer->getContext()) {
+      LOGE("ReadbackRing::poll() Context mismatch!");
+      break;
+    }
+    if (context->submitSerial() < slot.submitSerial) {
+      if (!wait) {
+        break;
+      }
+      // The transfer of the slot is not submitted yet, we need to flush the context to encode it.
+      context->flushAndSubmit();
+    }
+    auto readbackBuffer = slot.readbackBuffer->getBuffer();
+    if (context->submitSerial() < slot.submitSerial || readbackBuffer == nullptr) {
+      LOGE("ReadbackRing::poll() Failed to get readback buffer!");
+      popFirstPending();
+      continue;
+    }
+    auto gpuBuffer = readbackBuffer->gpuBuffer();
+    if (!wait && !gpuBuffer->isReady()) {
+      break;
+    }
+    auto pixels = gpuBuffer->map(0, slot.info.byteSize());
+    if (pixels == nullptr) {
+      LOGE("ReadbackRing::poll() Failed to map readback buffer!");
+      popFirstPending();
+      continue;
+    }
+    if (callback) {
+      callback(slot.frameIndex, slot.info, pixels);
+    }
+    gpuBuffer->unmap();
+    popFirstPending();
+    count++;
+  }
+  return count;
+}
+
+void ReadbackRing::popFirstPending() {
+  firstPending = (firstPending + 1) % slots.size();
+  _pendingCount--;
+}
+}  // namespace tgfx
@@ -65,6 +65,17 @@ std::shared_ptr<ScalerContext> ScalerContext::MakeEmpty(float size) {
 }
 
 ScalerContext::ScalerContext(std::shared_ptr<Typeface> typeface, float size)
-    : typeface(std::move(typeface)), textSize(size) {
+    : typeface(std::move(typeface)), textSize(size), metricsCache(this) {
+}
+
+size_t ScalerContext::readPixelsInBatch(const std::vector<GlyphPixelsRequest>& requests) const {
+  size_t count = 0;
+  for (auto& request : requests) {
+    if (readPixels(request.glyphID, request.fauxBold, request.stroke, request.dstInfo,
+                   request.dstPixels)) {
+      count++;
+    }
+  }
+  return count;
 }
 }  // namespace tgfx
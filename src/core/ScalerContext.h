@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include <vector>
+#include "core/GlyphMetricsCache.h"
 #include "tgfx/core/FontMetrics.h"
 #include "tgfx/core/Image.h"
 #include "tgfx/core/Path.h"
@@ -27,10 +29,28 @@
 namespace tgfx {
 static constexpr float ITALIC_SKEW = -0.20f;
 
+/**
+ * Describes a glyph to be rasterized into the given pixels by ScalerContext::readPixelsInBatch().
+ */
+struct GlyphPixelsRequest {
+  GlyphID glyphID = 0;
+  bool fauxBold = false;
+  const Stroke* stroke = nullptr;
+  ImageInfo dstInfo = {};
+  void* dstPixels = nullptr;
+};
+
 class ScalerContext {
  public:
   static std::shared_ptr<ScalerContext> MakeEmpty(float size);
 
+  /**
+   * Releases the memory the vector backend keeps for glyph work and restores on demand, such as
+   * the idle FreeType faces. Called when a Context handles memory pressure. Each vector backend
+   * provides its own implementation.
+   */
+  static void ReleaseIdleResources();
+
   virtual ~ScalerContext() = default;
 
   std::shared_ptr<Typeface> getTypeface() const {
@@ -59,12 +79,28 @@ class ScalerContext {
 
   virtual bool generatePath(GlyphID glyphID, bool fauxBold, bool fauxItalic, Path* path) const = 0;
 
+  /**
+   * Generates the outline of the glyph without hinting, which scales linearly with the text size.
+   * The default implementation returns generatePath(), for scalers that don't hint outlines.
+   */
+  virtual bool generateUnhintedPath(GlyphID glyphID, bool fauxBold, bool fauxItalic,
+                                    Path* path) const {
+    return generatePath(glyphID, fauxBold, fauxItalic, path);
+  }
+
   virtual Rect getImageTransform(GlyphID glyphID, bool fauxBold, const Stroke* stroke,
                                  Matrix* matrix) const = 0;
 
   virtual bool readPixels(GlyphID glyphID, bool fauxBold, const Stroke* stroke,
                           const ImageInfo& dstInfo, void* dstPixels) const = 0;
 
+  /**
+   * Rasterizes the glyphs of all the given requests and returns the number of glyphs rasterized
+   * successfully. The default implementation calls readPixels() for each request. Subclasses may
+   * override it to set up the rasterizer only once for the whole batch.
+   */
+  virtual size_t readPixelsInBatch(const std::vector<GlyphPixelsRequest>& requests) const;
+
   virtual float getBackingSize() const {
     return textSize;
   }
@@ -77,6 +113,9 @@ class ScalerContext {
   ScalerContext(std::shared_ptr<Typeface> typeface, float size);
 
  private:
+  // Caches the glyph metrics queried by Font, keeping text layout off the typeface lock.
+  mutable GlyphMetricsCache metricsCache;
+
   friend class Font;
 };
 }  // namespace tgfx
@@ -19,6 +19,7 @@
 #include "ShapeRasterizer.h"
 #include "core/PathRasterizer.h"
 #include "core/PathTriangulator.h"
+#include "core/utils/ShapeUtils.h"
 #include "utils/Log.h"
 
 namespace tgfx {
@@ -35,11 +36,26 @@ bool ShapeRasterizer::asyncSupport() const {
 }
 
 std::shared_ptr<ShapeBuffer> ShapeRasterizer::getData() const {
+  Path hairlinePath = {};
+  auto cap = LineCap::Butt;
+  if (ShapeUtils::GetHairlinePath(shape, &hairlinePath, &cap)) {
+    auto triangles = makeHairlineTriangles(hairlinePath, cap);
+    if (triangles == nullptr) {
+      return nullptr;
+    }
+    return std::make_shared<ShapeBuffer>(triangles, nullptr);
+  }
   auto finalPath = shape->getPath();
   if (finalPath.isEmpty() && finalPath.isInverseFillType()) {
     finalPath.reset();
     finalPath.addRect(Rect::MakeWH(width, height));
   }
+  if (!finalPath.isInverseFillType() && finalPath.isConvex()) {
+    auto triangles = makeConvexTriangles(finalPath);
+    if (triangles != nullptr) {
+      return std::make_shared<ShapeBuffer>(triangles, nullptr);
+    }
+  }
   if (PathTriangulator::ShouldTriangulatePath(finalPath)) {
     auto triangles = makeTriangles(finalPath);
     if (triangles == nullptr) {
@@ -72,6 +88,27 @@ std::shared_ptr<Data> ShapeRasterizer::makeTriangles(const Path& finalPath) cons
   return Data::MakeWithCopy(vertices.data(), vertices.size() * sizeof(float));
 }
 
+std::shared_ptr<Data> ShapeRasterizer::makeConvexTriangles(const Path& convexPath) const {
+  std::vector<float> vertices = {};
+  auto count =
+      PathTriangulator::ToConvexTriangles(convexPath, aaType == AAType::Coverage, &vertices);
+  if (count == 0) {
+    return nullptr;
+  }
+  return Data::MakeWithCopy(vertices.data(), vertices.size() * sizeof(float));
+}
+
+std::shared_ptr<Data> ShapeRasterizer::makeHairlineTriangles(const Path& hairlinePath,
+                                                             LineCap cap) const {
+  std::vector<float> vertices = {};
+  auto count = PathTriangulator::ToHairlineTriangles(hairlinePath, cap,
+                                                     aaType == AAType::Coverage, &vertices);
+  if (count == 0) {
+    return nullptr;
+  }
+  return Data::MakeWithCopy(vertices.data(), vertices.size() * sizeof(float));
+}
+
 std::shared_ptr<ImageBuffer> ShapeRasterizer::makeImageBuffer(const Path& finalPath) const {
   auto pathRasterizer = PathRasterizer::MakeFrom(width, height, finalPath, aaType != AAType::None);
   if (pathRasterizer == nullptr) {
@@ -22,6 +22,7 @@
 #include "gpu/AAType.h"
 #include "tgfx/core/Data.h"
 #include "tgfx/core/Shape.h"
+#include "tgfx/core/Stroke.h"
 
 namespace tgfx {
 struct ShapeBuffer {
@@ -66,6 +67,10 @@ class ShapeRasterizer : public DataSource<ShapeBuffer> {
 
   std::shared_ptr<Data> makeTriangles(const Path& finalPath) const;
 
+  std::shared_ptr<Data> makeConvexTriangles(const Path& convexPath) const;
+
+  std::shared_ptr<Data> makeHairlineTriangles(const Path& hairlinePath, LineCap cap) const;
+
   std::shared_ptr<ImageBuffer> makeImageBuffer(const Path& finalPath) const;
 };
 }  // namespace tgfx
@@ -0,0 +1,71 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+
+#include "StagingImageBuffer.h"
+#include "core/utils/Log.h"
+#include "core/utils/PixelFormatUtil.h"
+#include "gpu/GlobalCache.h"
+#include "gpu/resources/TextureView.h"
+
+namespace tgfx {
+std::shared_ptr<StagingImageBuffer> StagingImageBuffer::Make(
+    Context* context, int width, int height, bool alphaOnly,
+    std::shared_ptr<ColorSpace> colorSpace) {
+  if (context == nullptr) {
+    return nullptr;
+  }
+  auto colorType = alphaOnly ? ColorType::ALPHA_8 : ColorType::RGBA_8888;
+  auto info =
+      ImageInfo::Make(width, height, colorType, AlphaType::Premultiplied, 0, std::move(colorSpace));
+  if (info.isEmpty() || info.byteSize() < MinByteSize) {
+    return nullptr;
+  }
+  auto buffer = context->globalCache()->acquireStagingBuffer(info.byteSize());
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  auto pixels = buffer->map(0, info.byteSize());
+  if (pixels == nullptr) {
+    return nullptr;
+  }
+  return std::shared_ptr<StagingImageBuffer>(
+      new StagingImageBuffer(info, std::move(buffer), pixels));
+}
+
+StagingImageBuffer::StagingImageBuffer(const ImageInfo& info, std::shared_ptr<GPUBuffer> buffer,
+                                       void* pixels)
+    : _info(info), buffer(std::move(buffer)), _pixels(pixels) {
+}
+
+std::shared_ptr<TextureView> StagingImageBuffer::onMakeTexture(Context* context,
+                                                               bool mipmapped) const {
+  if (buffer == nullptr) {
+    LOGE("StagingImageBuffer::onMakeTexture() the pixels have already been uploaded!");
+    return nullptr;
+  }
+  buffer->unmap();
+  auto format = ColorTypeToPixelFormat(_info.colorType());
+  auto textureView = TextureView::MakeFormat(context, width(), height(), format, mipmapped);
+  if (textureView != nullptr) {
+    context->gpu()->queue()->copyBufferToTexture(buffer, 0, _info.rowBytes(),
+                                                 textureView->getTexture(),
+                                                 Rect::MakeWH(width(), height()));
+  }
+  context->globalCache()->releaseStagingBuffer(std::move(buffer));
+  return textureView;
+}
+}  // namespace tgfx
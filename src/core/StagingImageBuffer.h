@@ -0,0 +1,87 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+
+#pragma once
+
+#include "tgfx/core/ImageBuffer.h"
+#include "tgfx/core/ImageInfo.h"
+#include "tgfx/gpu/GPUBuffer.h"
+
+namespace tgfx {
+/**
+ * StagingImageBuffer holds the pixels of an image decoded straight into a mapped staging buffer of
+ * the GPU, which the GPU copies to the texture without blocking the thread that uploads it.
+ */
+class StagingImageBuffer : public ImageBuffer {
+ public:
+  /**
+   * Images smaller than this are cheaper to upload from client memory than to stage.
+   */
+  static constexpr size_t MinByteSize = 256 * 1024;
+
+  /**
+   * Takes a staging buffer from the context and maps it for the pixels of an image of the
+   * specified size. Must be called on the thread of the context. Returns nullptr if the image is
+   * smaller than MinByteSize, or if the GPU doesn't support staging buffers.
+   */
+  static std::shared_ptr<StagingImageBuffer> Make(Context* context, int width, int height,
+                                                  bool alphaOnly,
+                                                  std::shared_ptr<ColorSpace> colorSpace = nullptr);
+
+  int width() const override {
+    return _info.width();
+  }
+
+  int height() const override {
+    return _info.height();
+  }
+
+  bool isAlphaOnly() const override {
+    return _info.isAlphaOnly();
+  }
+
+  const std::shared_ptr<ColorSpace>& colorSpace() const override {
+    return _info.colorSpace();
+  }
+
+  /**
+   * Returns the layout of the pixels in the staging buffer.
+   */
+  const ImageInfo& info() const {
+    return _info;
+  }
+
+  /**
+   * Returns the mapped memory of the staging buffer, which may be written from any thread until
+   * the texture is made from this buffer.
+   */
+  void* pixels() const {
+    return _pixels;
+  }
+
+ protected:
+  std::shared_ptr<TextureView> onMakeTexture(Context* context, bool mipmapped) const override;
+
+ private:
+  ImageInfo _info = {};
+  // Handed back to the context once the copy to the texture is encoded.
+  mutable std::shared_ptr<GPUBuffer> buffer = nullptr;
+  void* _pixels = nullptr;
+
+  StagingImageBuffer(const ImageInfo& info, std::shared_ptr<GPUBuffer> buffer, void* pixels);
+};
+}  // namespace tgfx
@@ -109,6 +109,14 @@ uint32_t Surface::renderFlags() const {
   return renderContext->renderFlags;
 }
 
+void Surface::setRenderFlags(uint32_t renderFlags) {
+  if (renderContext->renderFlags == renderFlags) {
+    return;
+  }
+  renderContext->flush();
+  renderContext->renderFlags = renderFlags;
+}
+
 int Surface::width() const {
   return renderContext->renderTarget->width();
 }
@@ -190,25 +198,12 @@ Color Surface::getColor(int x, int y) {
 }
 
 std::shared_ptr<SurfaceReadback> Surface::asyncReadPixels(const Rect& rect) {
-  if (rect.isEmpty()) {
-    return nullptr;
-  }
-  auto surfaceRect = Rect::MakeWH(width(), height());
-  if (!surfaceRect.contains(rect)) {
-    return nullptr;
-  }
-  auto renderTarget = renderContext->renderTarget;
-  auto srcRect = renderTarget->getOriginTransform().mapRect(rect);
-  auto colorType = PixelFormatToColorType(renderTarget->format());
-  auto info = ImageInfo::Make(static_cast<int>(srcRect.width()), static_cast<int>(srcRect.height()),
-                              colorType, AlphaType::Premultiplied, 0, colorSpace());
-  auto context = renderTarget->getContext();
-  auto readbackBuffer = context->proxyProvider()->createReadbackBufferProxy(info.byteSize());
-  if (readbackBuffer == nullptr) {
+  ImageInfo info = {};
+  std::shared_ptr<GPUBufferProxy> readbackBuffer = nullptr;
+  size_t bufferSize = 0;
+  if (!transferPixels(rect, &info, &readbackBuffer, &bufferSize)) {
     return nullptr;
   }
-  renderContext->flush();
-  context->drawingManager()->addTransferPixelsTask(renderTarget, srcRect, readbackBuffer);
   return std::shared_ptr<SurfaceReadback>(new SurfaceReadback(info, std::move(readbackBuffer)));
 }
 
@@ -266,4 +261,32 @@ bool Surface::aboutToDraw(bool discardContent) {
   renderContext->replaceRenderTarget(std::move(newRenderTarget), std::move(oldContent));
   return true;
 }
+
+bool Surface::transferPixels(const Rect& rect, ImageInfo* info,
+                             std::shared_ptr<GPUBufferProxy>* readbackBuffer, size_t* bufferSize) {
+  if (rect.isEmpty()) {
+    return false;
+  }
+  auto surfaceRect = Rect::MakeWH(width(), height());
+  if (!surfaceRect.contains(rect)) {
+    return false;
+  }
+  auto renderTarget = renderContext->renderTarget;
+  auto srcRect = renderTarget->getOriginTransform().mapRect(rect);
+  auto colorType = PixelFormatToColorType(renderTarget->format());
+  *info = ImageInfo::Make(static_cast<int>(srcRect.width()), static_cast<int>(srcRect.height()),
+                          colorType, AlphaType::Premultiplied, 0, colorSpace());
+  auto context = renderTarget->getContext();
+  if (*readbackBuffer == nullptr || *bufferSize < info->byteSize()) {
+    auto buffer = context->proxyProvider()->createReadbackBufferProxy(info->byteSize());
+    if (buffer == nullptr) {
+      return false;
+    }
+    *readbackBuffer = std::move(buffer);
+    *bufferSize = info->byteSize();
+  }
+  renderContext->flush();
+  context->drawingManager()->addTransferPixelsTask(renderTarget, srcRect, *readbackBuffer);
+  return true;
+}
 }  // namespace tgfx
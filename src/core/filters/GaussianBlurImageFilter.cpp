@@ -212,9 +212,11 @@ PlacementPtr<FragmentProcessor> GaussianBlurImageFilter::getSourceFragmentProces
   if (fp->numCoordTransforms() == 1) {
     return fp;
   }
-  auto renderTarget =
-      RenderTargetProxy::Make(context, static_cast<int>(scaledDrawRect.width()),
-                              static_cast<int>(scaledDrawRect.height()), source->isAlphaOnly(), 1);
+  // The intermediate target is only sampled by the blur passes, so its backing store can use an
+  // approximate size to be shared with other transient targets in the flush.
+  auto renderTarget = RenderTargetProxy::Make(
+      context, static_cast<int>(scaledDrawRect.width()), static_cast<int>(scaledDrawRect.height()),
+      source->isAlphaOnly(), 1, false, ImageOrigin::TopLeft, BackingFit::Approx);
   if (renderTarget == nullptr) {
     return nullptr;
   }
@@ -18,7 +18,6 @@
 
 #include "tgfx/core/BytesKey.h"
 #include <cstring>
-#include "core/utils/HashRange.h"
 
 namespace tgfx {
 union DataConverter {
@@ -33,39 +32,51 @@ union PointerConverter {
   uint32_t uintValues[2];
 };
 
-void BytesKey::write(uint32_t value) {
+void BytesKey::append(uint32_t value) {
   values.push_back(value);
+  // FNV-1a over 32-bit words.
+  runningHash = (runningHash ^ value) * 0x100000001B3;
+}
+
+void BytesKey::write(uint32_t value) {
+  append(value);
 }
 
 void BytesKey::write(int value) {
   DataConverter converter = {};
   converter.intValue = value;
-  values.push_back(converter.uintValue);
+  append(converter.uintValue);
 }
 
 void BytesKey::write(const void* value) {
   PointerConverter converter = {};
   converter.pointer = value;
-  values.push_back(converter.uintValues[0]);
+  append(converter.uintValues[0]);
   static size_t size = sizeof(intptr_t);
   if (size > 4) {
-    values.push_back(converter.uintValues[1]);
+    append(converter.uintValues[1]);
   }
 }
 
 void BytesKey::write(const uint8_t value[4]) {
   DataConverter converter = {};
   memcpy(converter.bytes, value, 4);
-  values.push_back(converter.uintValue);
+  append(converter.uintValue);
 }
 
 void BytesKey::write(float value) {
   DataConverter converter = {};
   converter.floatValue = value;
-  values.push_back(converter.uintValue);
+  append(converter.uintValue);
 }
 
 size_t BytesKeyHasher::operator()(const BytesKey& key) const {
-  return HashRange(key.values.data(), key.values.size());
+  // FNV-1a only mixes the low bits of each value into the higher bits, so the final hash is
+  // avalanched before being used by the hash map.
+  auto hash = key.runningHash;
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCD;
+  hash ^= hash >> 33;
+  return static_cast<size_t>(hash);
 }
 }  // namespace tgfx
\ No newline at end of file
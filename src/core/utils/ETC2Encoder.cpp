@@ -0,0 +1,345 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ETC2Encoder.h"
+#include <algorithm>
+#include <climits>
+
+namespace tgfx {
+static constexpr int BLOCK_SIZE = 4;
+static constexpr size_t BLOCK_BYTES = 16;
+
+// The ETC1 intensity modifier tables, each row holds the small and large modifiers of a table.
+static constexpr int ETC1Modifiers[8][2] = {{2, 8},   {5, 17},  {9, 29},  {13, 42},
+                                            {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+// The EAC alpha modifier tables.
+static constexpr int EACModifiers[16][8] = {
+    {-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12},
+    {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+    {-3, -6, -8, -12, 2, 5, 7, 11}, {-3, -7, -9, -11, 2, 6, 8, 10},
+    {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+    {-2, -6, -8, -10, 1, 5, 7, 9},  {-2, -5, -8, -10, 1, 4, 7, 9},
+    {-2, -4, -8, -10, 1, 3, 7, 9},  {-2, -5, -7, -10, 1, 4, 6, 9},
+    {-3, -4, -7, -10, 2, 3, 6, 9},  {-1, -2, -3, -10, 0, 1, 2, 9},
+    {-4, -6, -8, -9, 3, 5, 7, 8},   {-3, -5, -7, -9, 2, 4, 6, 8}};
+
+// The EAC table with a zero modifier at ZERO_MODIFIER_INDEX, used to encode constant alpha exactly.
+static constexpr int ZERO_MODIFIER_TABLE = 13;
+static constexpr int ZERO_MODIFIER_INDEX = 4;
+
+struct BlockPixels {
+  // The RGBA values of the 4x4 pixels, stored row by row.
+  uint8_t rgba[16][4] = {};
+};
+
+struct SubblockFit {
+  int error = INT_MAX;
+  int table = 0;
+  uint8_t indices[8] = {};
+};
+
+struct ColorFit {
+  int error = INT_MAX;
+  bool differential = false;
+  bool flip = false;
+  int colors[2][3] = {};
+  SubblockFit subblocks[2] = {};
+};
+
+static inline int ClampToByte(int value) {
+  return std::min(std::max(value, 0), 255);
+}
+
+// Maps the 2-bit pixel index to the modifier of the table: 0 -> +small, 1 -> +large,
+// 2 -> -small, 3 -> -large.
+static inline int ETC1Modifier(int table, int index) {
+  auto value = ETC1Modifiers[table][index & 1];
+  return index & 2 ? -value : value;
+}
+
+static inline int Expand4Bits(int value) {
+  return (value << 4) | value;
+}
+
+static inline int Expand5Bits(int value) {
+  return (value << 3) | (value >> 2);
+}
+
+// Returns the positions of the pixels in the subblock. If flip is false, the subblocks are the
+// left and right 2x4 halves of the block, otherwise they are the top and bottom 4x2 halves.
+static void GetSubblockPositions(bool flip, int subblock, int positions[8]) {
+  int count = 0;
+  for (int y = 0; y < BLOCK_SIZE; y++) {
+    for (int x = 0; x < BLOCK_SIZE; x++) {
+      auto inFirst = flip ? y < 2 : x < 2;
+      if (inFirst == (subblock == 0)) {
+        positions[count++] = y * BLOCK_SIZE + x;
+      }
+    }
+  }
+}
+
+static SubblockFit FitSubblock(const BlockPixels& block, const int positions[8],
+                               const int base[3]) {
+  SubblockFit best = {};
+  for (int table = 0; table < 8; table++) {
+    SubblockFit fit = {};
+    fit.error = 0;
+    fit.table = table;
+    for (int i = 0; i < 8 && fit.error < best.error; i++) {
+      auto pixel = block.rgba[positions[i]];
+      auto bestError = INT_MAX;
+      for (int index = 0; index < 4; index++) {
+        auto modifier = ETC1Modifier(table, index);
+        int error = 0;
+        for (int c = 0; c < 3; c++) {
+          auto diff = ClampToByte(base[c] + modifier) - pixel[c];
+          error += diff * diff;
+        }
+        if (error < bestError) {
+          bestError = error;
+          fit.indices[i] = static_cast<uint8_t>(index);
+        }
+      }
+      fit.error += bestError;
+    }
+    if (fit.error < best.error) {
+      best = fit;
+    }
+  }
+  return best;
+}
+
+static void FitColorBlock(const BlockPixels& block, bool flip, bool differential,
+                          ColorFit* bestFit) {
+  int positions[2][8] = {};
+  int quantized[2][3] = {};
+  int bases[2][3] = {};
+  for (int s = 0; s < 2; s++) {
+    GetSubblockPositions(flip, s, positions[s]);
+    for (int c = 0; c < 3; c++) {
+      int sum = 0;
+      for (auto position : positions[s]) {
+        sum += block.rgba[position][c];
+      }
+      auto average = (sum + 4) / 8;
+      if (differential) {
+        quantized[s][c] = (average * 31 + 127) / 255;
+        bases[s][c] = Expand5Bits(quantized[s][c]);
+      } else {
+        quantized[s][c] = (average * 15 + 127) / 255;
+        bases[s][c] = Expand4Bits(quantized[s][c]);
+      }
+    }
+  }
+  if (differential) {
+    for (int c = 0; c < 3; c++) {
+      auto delta = quantized[1][c] - quantized[0][c];
+      // Any other delta is decoded as one of the ETC2 T, H or planar modes.
+      if (delta < -4 || delta > 3) {
+        return;
+      }
+    }
+  }
+  ColorFit fit = {};
+  fit.differential = differential;
+  fit.flip = flip;
+  fit.error = 0;
+  for (int s = 0; s < 2; s++) {
+    fit.subblocks[s] = FitSubblock(block, positions[s], bases[s]);
+    fit.error += fit.subblocks[s].error;
+    for (int c = 0; c < 3; c++) {
+      fit.colors[s][c] = quantized[s][c];
+    }
+  }
+  if (fit.error < bestFit->error) {
+    *bestFit = fit;
+  }
+}
+
+static void WriteColorBlock(const ColorFit& fit, uint8_t* dst) {
+  uint32_t high = 0;
+  auto& first = fit.colors[0];
+  auto& second = fit.colors[1];
+  if (fit.differential) {
+    for (int c = 0; c < 3; c++) {
+      auto delta = static_cast<uint32_t>(second[c] - first[c]) & 7;
+      high |= (static_cast<uint32_t>(first[c]) << 3 | delta) << (24 - c * 8);
+    }
+  } else {
+    for (int c = 0; c < 3; c++) {
+      high |= (static_cast<uint32_t>(first[c]) << 4 | static_cast<uint32_t>(second[c]))
+              << (24 - c * 8);
+    }
+  }
+  high |= static_cast<uint32_t>(fit.subblocks[0].table) << 5;
+  high |= static_cast<uint32_t>(fit.subblocks[1].table) << 2;
+  high |= (fit.differential ? 2u : 0u) | (fit.flip ? 1u : 0u);
+  uint32_t low = 0;
+  for (int s = 0; s < 2; s++) {
+    int positions[8] = {};
+    GetSubblockPositions(fit.flip, s, positions);
+    for (int i = 0; i < 8; i++) {
+      auto x = positions[i] % BLOCK_SIZE;
+      auto y = positions[i] / BLOCK_SIZE;
+      // The pixel indices are stored column by column.
+      auto bit = x * BLOCK_SIZE + y;
+      auto index = static_cast<uint32_t>(fit.subblocks[s].indices[i]);
+      low |= (index >> 1) << (bit + 16);
+      low |= (index & 1) << bit;
+    }
+  }
+  for (int i = 0; i < 4; i++) {
+    dst[i] = static_cast<uint8_t>(high >> (24 - i * 8));
+    dst[i + 4] = static_cast<uint8_t>(low >> (24 - i * 8));
+  }
+}
+
+static int FitAlphaBlock(const BlockPixels& block, int base, int multiplier, int table,
+                         uint8_t indices[16], int bestError) {
+  auto modifiers = EACModifiers[table];
+  int error = 0;
+  for (int i = 0; i < 16 && error < bestError; i++) {
+    auto alpha = block.rgba[i][3];
+    auto bestPixelError = INT_MAX;
+    for (int index = 0; index < 8; index++) {
+      auto diff = ClampToByte(base + modifiers[index] * multiplier) - alpha;
+      if (diff * diff < bestPixelError) {
+        bestPixelError = diff * diff;
+        indices[i] = static_cast<uint8_t>(index);
+      }
+    }
+    error += bestPixelError;
+  }
+  return error;
+}
+
+static void WriteAlphaBlock(const BlockPixels& block, uint8_t* dst) {
+  int minAlpha = 255;
+  int maxAlpha = 0;
+  for (auto& pixel : block.rgba) {
+    minAlpha = std::min(minAlpha, static_cast<int>(pixel[3]));
+    maxAlpha = std::max(maxAlpha, static_cast<int>(pixel[3]));
+  }
+  int bestBase = minAlpha;
+  int bestMultiplier = 1;
+  int bestTable = ZERO_MODIFIER_TABLE;
+  uint8_t bestIndices[16] = {};
+  std::fill(std::begin(bestIndices), std::end(bestIndices), ZERO_MODIFIER_INDEX);
+  if (minAlpha != maxAlpha) {
+    auto bestError = INT_MAX;
+    uint8_t indices[16] = {};
+    for (int table = 0; table < 16; table++) {
+      auto minModifier = EACModifiers[table][3];
+      auto maxModifier = EACModifiers[table][7];
+      auto range = maxModifier - minModifier;
+      auto center = (maxAlpha - minAlpha + range - 1) / range;
+      for (int multiplier = center - 1; multiplier <= center + 1; multiplier++) {
+        if (multiplier < 1 || multiplier > 15) {
+          continue;
+        }
+        auto offset = (minModifier + maxModifier) * multiplier;
+        auto base = ClampToByte((minAlpha + maxAlpha - offset + 1) / 2);
+        auto error = FitAlphaBlock(block, base, multiplier, table, indices, bestError);
+        if (error < bestError) {
+          bestError = error;
+          bestBase = base;
+          bestMultiplier = multiplier;
+          bestTable = table;
+          std::copy(std::begin(indices), std::end(indices), std::begin(bestIndices));
+        }
+      }
+    }
+  }
+  uint64_t bits = static_cast<uint64_t>(bestBase) << 56 |
+                  static_cast<uint64_t>(bestMultiplier) << 52 |
+                  static_cast<uint64_t>(bestTable) << 48;
+  for (int i = 0; i < 16; i++) {
+    auto x = i % BLOCK_SIZE;
+    auto y = i / BLOCK_SIZE;
+    // The pixel indices are stored column by column, starting from the most significant bits.
+    auto shift = 45 - 3 * (x * BLOCK_SIZE + y);
+    bits |= static_cast<uint64_t>(bestIndices[i]) << shift;
+  }
+  for (int i = 0; i < 8; i++) {
+    dst[i] = static_cast<uint8_t>(bits >> (56 - i * 8));
+  }
+}
+
+static void CompressBlock(const BlockPixels& block, uint8_t* dst) {
+  WriteAlphaBlock(block, dst);
+  ColorFit bestFit = {};
+  for (auto flip : {false, true}) {
+    FitColorBlock(block, flip, true, &bestFit);
+    FitColorBlock(block, flip, false, &bestFit);
+  }
+  WriteColorBlock(bestFit, dst + 8);
+}
+
+size_t ETC2CompressedRowBytes(int width) {
+  if (width <= 0) {
+    return 0;
+  }
+  return static_cast<size_t>((width + BLOCK_SIZE - 1) / BLOCK_SIZE) * BLOCK_BYTES;
+}
+
+size_t ETC2CompressedSize(int width, int height) {
+  if (height <= 0) {
+    return 0;
+  }
+  auto blockRows = (height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  return ETC2CompressedRowBytes(width) * static_cast<size_t>(blockRows);
+}
+
+bool CompressETC2(const ImageInfo& srcInfo, const void* srcPixels, void* dstBlocks) {
+  if (srcInfo.isEmpty() || srcPixels == nullptr || dstBlocks == nullptr) {
+    return false;
+  }
+  auto colorType = srcInfo.colorType();
+  if (colorType != ColorType::RGBA_8888 && colorType != ColorType::BGRA_8888) {
+    return false;
+  }
+  auto swapRedBlue = colorType == ColorType::BGRA_8888;
+  auto width = srcInfo.width();
+  auto height = srcInfo.height();
+  auto dst = static_cast<uint8_t*>(dstBlocks);
+  BlockPixels block = {};
+  for (int blockY = 0; blockY < height; blockY += BLOCK_SIZE) {
+    for (int blockX = 0; blockX < width; blockX += BLOCK_SIZE) {
+      for (int y = 0; y < BLOCK_SIZE; y++) {
+        // The pixels outside the image repeat the edge pixels.
+        auto srcY = std::min(blockY + y, height - 1);
+        auto row = static_cast<const uint8_t*>(srcInfo.computeOffset(srcPixels, 0, srcY));
+        for (int x = 0; x < BLOCK_SIZE; x++) {
+          auto srcX = std::min(blockX + x, width - 1);
+          auto pixel = row + srcX * 4;
+          auto& rgba = block.rgba[y * BLOCK_SIZE + x];
+          rgba[0] = pixel[swapRedBlue ? 2 : 0];
+          rgba[1] = pixel[1];
+          rgba[2] = pixel[swapRedBlue ? 0 : 2];
+          rgba[3] = pixel[3];
+        }
+      }
+      CompressBlock(block, dst);
+      dst += BLOCK_BYTES;
+    }
+  }
+  return true;
+}
+}  // namespace tgfx
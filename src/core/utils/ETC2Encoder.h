@@ -0,0 +1,42 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "tgfx/core/ImageInfo.h"
+
+namespace tgfx {
+/**
+ * Returns the byte size of the ETC2 RGBA8 blocks compressed from an image of the given size. Each
+ * block of 4x4 pixels is compressed into 16 bytes, which is one byte per pixel.
+ */
+size_t ETC2CompressedSize(int width, int height);
+
+/**
+ * Returns the row bytes of the ETC2 RGBA8 blocks compressed from an image of the given width.
+ */
+size_t ETC2CompressedRowBytes(int width);
+
+/**
+ * Compresses the pixels into ETC2 RGBA8 blocks (ETC2 color with EAC alpha), which are stored row by
+ * row in dstBlocks. The dstBlocks must have at least ETC2CompressedSize() bytes. Only the
+ * ColorType::RGBA_8888 and ColorType::BGRA_8888 pixels are supported, the alpha type is kept as is.
+ * Returns false if the pixels can not be compressed.
+ */
+bool CompressETC2(const ImageInfo& srcInfo, const void* srcPixels, void* dstBlocks);
+}  // namespace tgfx
@@ -133,6 +133,70 @@ inline bool IsInteger(float f) {
   return std::floor(f) == f;
 }
 
+/**
+ * Converts a float to the bit pattern of an IEEE 754 half-precision float, rounding to the nearest
+ * even value. Values out of the half range are converted to infinity.
+ */
+inline uint16_t FloatToHalf(float value) {
+  auto bits = Float2Bits(value);
+  auto sign = static_cast<uint16_t>((bits >> 16) & 0x8000);
+  auto exponent = static_cast<int>((bits >> 23) & 0xFF);
+  uint32_t mantissa = bits & 0x7FFFFF;
+  if (exponent == 0xFF) {
+    return static_cast<uint16_t>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+  }
+  auto halfExponent = exponent - 127 + 15;
+  if (halfExponent >= 0x1F) {
+    return static_cast<uint16_t>(sign | 0x7C00);
+  }
+  int shift = 13;
+  uint32_t half = 0;
+  if (halfExponent <= 0) {
+    if (halfExponent < -10) {
+      return sign;
+    }
+    // Subnormal half, shift the implicit leading bit into the mantissa.
+    mantissa |= 0x800000;
+    shift = 14 - halfExponent;
+  } else {
+    half = static_cast<uint32_t>(halfExponent) << 10;
+  }
+  half |= mantissa >> shift;
+  auto rest = mantissa & ((1u << shift) - 1);
+  auto halfway = 1u << (shift - 1);
+  if (rest > halfway || (rest == halfway && (half & 1))) {
+    // May carry into the exponent, which still yields the correctly rounded result.
+    half++;
+  }
+  return static_cast<uint16_t>(sign | half);
+}
+
+/**
+ * Converts the bit pattern of an IEEE 754 half-precision float to a float.
+ */
+inline float HalfToFloat(uint16_t half) {
+  uint32_t sign = static_cast<uint32_t>(half & 0x8000) << 16;
+  uint32_t exponent = (half >> 10) & 0x1F;
+  uint32_t mantissa = half & 0x3FF;
+  uint32_t bits = sign;
+  if (exponent == 0x1F) {
+    bits |= 0x7F800000 | (mantissa << 13);
+  } else if (exponent != 0) {
+    bits |= ((exponent + 127 - 15) << 23) | (mantissa << 13);
+  } else if (mantissa != 0) {
+    // Normalize the subnormal half.
+    exponent = 127 - 15 + 1;
+    while ((mantissa & 0x400) == 0) {
+      mantissa <<= 1;
+      exponent--;
+    }
+    bits |= (exponent << 23) | ((mantissa & 0x3FF) << 13);
+  }
+  float value;
+  memcpy(&value, &bits, sizeof(float));
+  return value;
+}
+
 #if !defined(TGFX_ATTRIBUTE)
 #if defined(__clang__) || defined(__GNUC__)
 #define TGFX_ATTRIBUTE(attr) __attribute__((attr))
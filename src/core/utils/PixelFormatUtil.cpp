@@ -53,6 +53,7 @@ size_t PixelFormatBytesPerPixel(PixelFormat format) {
   switch (format) {
     case PixelFormat::ALPHA_8:
     case PixelFormat::GRAY_8:
+    case PixelFormat::ETC2_RGBA8:  // 16 bytes per block of 4x4 pixels.
       return 1;
     case PixelFormat::RG_88:
       return 2;
@@ -67,6 +68,7 @@ size_t PixelFormatBytesPerPixel(PixelFormat format) {
 PixelFormat MaskFormatToPixelFormat(MaskFormat format) {
   switch (format) {
     case MaskFormat::A8:
+    case MaskFormat::SDF:
       return PixelFormat::ALPHA_8;
     case MaskFormat::RGBA:
       return PixelFormat::RGBA_8888;
@@ -30,6 +30,13 @@ ColorType PixelFormatToColorType(PixelFormat format);
 
 size_t PixelFormatBytesPerPixel(PixelFormat format);
 
+/**
+ * Returns true if the format stores pixels in compressed blocks.
+ */
+inline bool PixelFormatIsCompressed(PixelFormat format) {
+  return format == PixelFormat::ETC2_RGBA8;
+}
+
 PixelFormat MaskFormatToPixelFormat(MaskFormat format);
 
 }  // namespace tgfx
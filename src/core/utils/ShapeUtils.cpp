@@ -50,4 +50,27 @@ float ShapeUtils::CalculateAlphaReduceFactorIfHairline(std::shared_ptr<Shape> sh
   return 1.f;
 }
 
+bool ShapeUtils::GetHairlinePath(std::shared_ptr<Shape> shape, Path* hairlinePath, LineCap* cap) {
+  if (shape == nullptr) {
+    return false;
+  }
+  auto matrix = Matrix::I();
+  if (shape->type() == Shape::Type::Matrix) {
+    auto matrixShape = std::static_pointer_cast<MatrixShape>(shape);
+    matrix = matrixShape->matrix;
+    shape = matrixShape->shape;
+  }
+  if (shape->type() != Shape::Type::Stroke) {
+    return false;
+  }
+  auto strokeShape = std::static_pointer_cast<StrokeShape>(shape);
+  if (!TreatStrokeAsHairline(strokeShape->stroke, matrix)) {
+    return false;
+  }
+  *hairlinePath = strokeShape->shape->onGetPath(matrix.getMaxScale());
+  hairlinePath->transform(matrix);
+  *cap = strokeShape->stroke.cap;
+  return true;
+}
+
 }  // namespace tgfx
\ No newline at end of file
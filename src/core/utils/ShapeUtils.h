@@ -21,6 +21,7 @@
 #include <memory>
 #include "tgfx/core/Path.h"
 #include "tgfx/core/Shape.h"
+#include "tgfx/core/Stroke.h"
 namespace tgfx {
 
 class ShapeUtils {
@@ -33,5 +34,12 @@ class ShapeUtils {
   static Path GetShapeRenderingPath(std::shared_ptr<Shape> shape, float resolutionScale);
 
   static float CalculateAlphaReduceFactorIfHairline(std::shared_ptr<Shape> shape);
+
+  /**
+   * Returns true if the shape is a stroke that is drawn as a hairline at its current scale. If so,
+   * the unstroked path mapped to the coordinate space of the shape is returned in hairlinePath, and
+   * the cap of the stroke is returned in cap, so that the hairline can be drawn without stroking.
+   */
+  static bool GetHairlinePath(std::shared_ptr<Shape> shape, Path* hairlinePath, LineCap* cap);
 };
 }  // namespace tgfx
\ No newline at end of file
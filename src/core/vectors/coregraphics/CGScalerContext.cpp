@@ -127,6 +127,10 @@ static CTFontRef CreateBackingFont(CTFontRef ctFont, float textSize) {
                                         nullptr);
 }
 
+void ScalerContext::ReleaseIdleResources() {
+  // CoreText manages the memory of the fonts itself.
+}
+
 CGScalerContext::CGScalerContext(std::shared_ptr<Typeface> tf, float size)
     : ScalerContext(std::move(tf), size) {
   CTFontRef font = std::static_pointer_cast<CGTypeface>(typeface)->ctFont;
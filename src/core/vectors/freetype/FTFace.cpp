@@ -0,0 +1,109 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FTFace.h"
+#include FT_SIZES_H
+#include <cstring>
+
+namespace tgfx {
+static constexpr FT_UInt DefaultResolutionInDPI = 72;
+
+FT_Face FTFace::OpenFace(FT_Library library, const FTFontData& data) {
+  FT_Open_Args args;
+  memset(&args, 0, sizeof(args));
+  if (data.data) {
+    args.flags = FT_OPEN_MEMORY;
+    args.memory_base = static_cast<const FT_Byte*>(data.data->data());
+    args.memory_size = static_cast<FT_Long>(data.data->size());
+  } else if (!data.path.empty()) {
+    args.flags = FT_OPEN_PATHNAME;
+    args.pathname = const_cast<FT_String*>(data.path.c_str());
+  } else {
+    return nullptr;
+  }
+  FT_Face face = nullptr;
+  auto err = FT_Open_Face(library, &args, data.ttcIndex, &face);
+  if (err || !face->family_name) {
+    if (face != nullptr) {
+      FT_Done_Face(face);
+    }
+    return nullptr;
+  }
+  if (!face->charmap) {
+    FT_Select_Charmap(face, FT_ENCODING_MS_SYMBOL);
+  }
+  return face;
+}
+
+std::unique_ptr<FTFace> FTFace::Make(const FTFontData& data) {
+  auto ftFace = std::unique_ptr<FTFace>(new FTFace(nullptr));
+  if (ftFace->library.library() == nullptr) {
+    return nullptr;
+  }
+  ftFace->_face = OpenFace(ftFace->library.library(), data);
+  if (ftFace->_face == nullptr) {
+    return nullptr;
+  }
+  return ftFace;
+}
+
+FTFace::FTFace(FT_Face face) : _face(face) {
+}
+
+FTFace::~FTFace() {
+  if (_face != nullptr) {
+    // Also releases all sizes created for the face.
+    FT_Done_Face(_face);
+  }
+}
+
+FT_Error FTFace::activateSize(float textSize, FT_F26Dot6 charSize, FT_Int strikeIndex) {
+  for (auto item = sizes.begin(); item != sizes.end(); ++item) {
+    if (item->first == textSize) {
+      if (item != sizes.begin()) {
+        sizes.splice(sizes.begin(), sizes, item);
+      }
+      return FT_Activate_Size(item->second);
+    }
+  }
+  FT_Size size = nullptr;
+  auto err = FT_New_Size(_face, &size);
+  if (err != FT_Err_Ok) {
+    return err;
+  }
+  err = FT_Activate_Size(size);
+  if (err == FT_Err_Ok) {
+    if (strikeIndex >= 0) {
+      err = FT_Select_Size(_face, strikeIndex);
+    } else if (FT_IS_SCALABLE(_face) && charSize > 0) {
+      err = FT_Set_Char_Size(_face, charSize, charSize, DefaultResolutionInDPI,
+                             DefaultResolutionInDPI);
+    }
+  }
+  if (err != FT_Err_Ok) {
+    FT_Done_Size(size);
+    return err;
+  }
+  sizes.emplace_front(textSize, size);
+  if (sizes.size() > MaxSizeCount) {
+    FT_Done_Size(sizes.back().second);
+    sizes.pop_back();
+  }
+  return FT_Err_Ok;
+}
+}  // namespace tgfx
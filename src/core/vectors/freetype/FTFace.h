@@ -0,0 +1,75 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <thread>
+#include "FTFontData.h"
+#include "FTLibrary.h"
+#include "ft2build.h"
+#include FT_FREETYPE_H
+
+namespace tgfx {
+/**
+ * FTFace is a FreeType face opened with its own FT_Library. Faces of the same font data can
+ * therefore be created, used and destroyed on different threads at the same time without a global
+ * lock. A single FTFace must only be used from one thread at a time.
+ */
+class FTFace {
+ public:
+  /**
+   * Opens the face described by the font data with the given library. Returns nullptr if the
+   * font data can't be opened. Calls with the same library must not run at the same time.
+   */
+  static FT_Face OpenFace(FT_Library library, const FTFontData& data);
+
+  /**
+   * Creates a new FTFace from the font data. Returns nullptr if the font data can't be opened.
+   */
+  static std::unique_ptr<FTFace> Make(const FTFontData& data);
+
+  ~FTFace();
+
+  FT_Face face() const {
+    return _face;
+  }
+
+  /**
+   * Activates the FT_Size reserved for the given text size, which is created and scaled on the
+   * first call. A non-negative strikeIndex selects a bitmap strike, otherwise the charSize in 26.6
+   * fixed point is applied if the face is scalable. Returns 0 on success, or a FreeType error code.
+   */
+  FT_Error activateSize(float textSize, FT_F26Dot6 charSize, FT_Int strikeIndex);
+
+ private:
+  static constexpr size_t MaxSizeCount = 8;
+
+  FTLibrary library = {};
+  FT_Face _face = nullptr;
+  // The created sizes keyed by text size, from the most recently used to the least.
+  std::list<std::pair<float, FT_Size>> sizes = {};
+  // The thread that used the face last time, used to hand the face back to the same thread.
+  std::thread::id threadID = {};
+
+  explicit FTFace(FT_Face face);
+
+  friend class FTTypeface;
+};
+}  // namespace tgfx
@@ -22,15 +22,15 @@
 namespace tgfx {
 FT_Library FTLibrary::Get() {
   static FTLibrary& ftLibrary = *new FTLibrary();
-  return ftLibrary.library;
+  return ftLibrary.library();
 }
 FTLibrary::FTLibrary() {
-  FT_Init_FreeType(&library);
+  FT_Init_FreeType(&_library);
 }
 
 FTLibrary::~FTLibrary() {
-  if (library) {
-    FT_Done_Library(library);
+  if (_library) {
+    FT_Done_Library(_library);
   }
 }
 }  // namespace tgfx
@@ -39,7 +39,14 @@ class FTLibrary {
 
   ~FTLibrary();
 
+  /**
+   * Returns the FT_Library owned by this instance.
+   */
+  FT_Library library() const {
+    return _library;
+  }
+
  private:
-  FT_Library library = nullptr;
+  FT_Library _library = nullptr;
 };
 }  // namespace tgfx
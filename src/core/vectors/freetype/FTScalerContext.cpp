@@ -160,6 +160,12 @@ static FT_Int ChooseBitmapStrike(FT_Face face, FT_F26Dot6 scaleY) {
   return chosenStrikeIndex;
 }
 
+void ScalerContext::ReleaseIdleResources() {
+  // The idle faces are not counted in the memory usage of any context, but each one holds a
+  // library and may hold an open font file, so they are all released to be reopened on demand.
+  FTTypeface::ReleaseIdleFaces();
+}
+
 FTScalerContext::FTScalerContext(std::shared_ptr<Typeface> typeFace, float size)
     : ScalerContext(std::move(typeFace), size), textScale(size) {
   backingSize = textSize;
@@ -168,21 +174,13 @@ FTScalerContext::FTScalerContext(std::shared_ptr<Typeface> typeFace, float size)
   // advances, as fontconfig and cairo do.
   loadGlyphFlags |= FT_LOAD_IGNORE_GLOBAL_ADVANCE_WIDTH;
   loadGlyphFlags |= FT_LOAD_TARGET_NORMAL;
+  // The scaler context is created under the typeface locker, and the glyph work is done on the
+  // faces from AutoFTFace, so the shared face only serves to choose the size here.
   auto face = ftTypeface()->face;
   if (FT_HAS_COLOR(face)) {
     loadGlyphFlags |= FT_LOAD_COLOR;
   }
-
-  auto err = FT_New_Size(face, &ftSize);
-  if (err != FT_Err_Ok) {
-    LOGE("FT_New_Size(%s) failed.", face->family_name);
-    return;
-  }
-  err = FT_Activate_Size(ftSize);
-  if (err != FT_Err_Ok) {
-    LOGE("FT_Activate_Size(%s) failed.", face->family_name);
-    return;
-  }
+  FT_Error err = FT_Err_Ok;
   if (FloatNearlyZero(textScale) || !FloatsAreFinite(&textScale, 1)) {
     textScale = 1.0f;
     extraScale.set(0.0f, 0.0f);
@@ -200,6 +198,7 @@ FTScalerContext::FTScalerContext(std::shared_ptr<Typeface> typeFace, float size)
       LOGE("FT_Set_CharSize(%s, %f, %f) failed.", face->family_name, textScaleDot6, textScaleDot6);
       return;
     }
+    charSize = textScaleDot6;
     // Adjust the matrix to reflect the actually chosen scale.
     // FreeType currently does not allow requesting sizes less than 1, this allows for scaling.
     // Don't do this at all sizes as that will interfere with hinting.
@@ -244,16 +243,12 @@ FTScalerContext::FTScalerContext(std::shared_ptr<Typeface> typeFace, float size)
   }
 }
 
-FTScalerContext::~FTScalerContext() {
-  if (ftSize) {
-    std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
-    FT_Done_Size(ftSize);
+int FTScalerContext::setupSize(FTFace* ftFace, bool fauxItalic) const {
+  if (ftFace == nullptr) {
+    return FT_Err_Invalid_Face_Handle;
   }
-}
-
-int FTScalerContext::setupSize(bool fauxItalic) const {
-  FT_Error err = FT_Activate_Size(ftSize);
-  if (err != 0) {
+  auto err = ftFace->activateSize(textSize, charSize, strikeIndex);
+  if (err != FT_Err_Ok) {
     return err;
   }
   auto matrix = getExtraMatrix(fauxItalic);
@@ -263,23 +258,22 @@ int FTScalerContext::setupSize(bool fauxItalic) const {
       FloatToFTFixed(-matrix.getSkewY()),
       FloatToFTFixed(matrix.getScaleY()),
   };
-  FT_Set_Transform(ftTypeface()->face, &matrix22, nullptr);
+  FT_Set_Transform(ftFace->face(), &matrix22, nullptr);
   return 0;
 }
 
 FontMetrics FTScalerContext::getFontMetrics() const {
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
+  AutoFTFace ftFace(ftTypeface());
   FontMetrics metrics = {};
-  if (setupSize(false)) {
+  if (setupSize(ftFace.get(), false)) {
     return metrics;
   }
-  getFontMetricsInternal(&metrics);
+  getFontMetricsInternal(ftFace.get()->face(), &metrics);
   return metrics;
 }
 
-void FTScalerContext::getFontMetricsInternal(FontMetrics* metrics) const {
-  auto face = ftTypeface()->face;
-  auto upem = static_cast<float>(ftTypeface()->unitsPerEmInternal());
+void FTScalerContext::getFontMetricsInternal(FT_Face face, FontMetrics* metrics) const {
+  auto upem = static_cast<float>(FTTypeface::UnitsPerEm(face));
 
   // use the os/2 table as a source of reasonable defaults.
   auto xHeight = 0.0f;
@@ -329,13 +323,13 @@ void FTScalerContext::getFontMetricsInternal(FontMetrics* metrics) const {
     // we may be able to synthesize x_height and cap_height from outline
     if (xHeight == 0.f) {
       FT_BBox bbox;
-      if (getCBoxForLetter('x', &bbox)) {
+      if (getCBoxForLetter(face, 'x', &bbox)) {
         xHeight = static_cast<float>(bbox.yMax) / 64.0f;
       }
     }
     if (capHeight == 0.f) {
       FT_BBox bbox;
-      if (getCBoxForLetter('H', &bbox)) {
+      if (getCBoxForLetter(face, 'H', &bbox)) {
         capHeight = static_cast<float>(bbox.yMax) / 64.0f;
       }
     }
@@ -388,8 +382,7 @@ void FTScalerContext::getFontMetricsInternal(FontMetrics* metrics) const {
   metrics->underlinePosition = underlinePosition * textScale;
 }
 
-bool FTScalerContext::getCBoxForLetter(char letter, FT_BBox* bbox) const {
-  auto face = ftTypeface()->face;
+bool FTScalerContext::getCBoxForLetter(FT_Face face, char letter, FT_BBox* bbox) const {
   const auto glyph_id = FT_Get_Char_Index(face, static_cast<FT_ULong>(letter));
   if (glyph_id == 0) {
     return false;
@@ -484,21 +477,29 @@ static bool GenerateGlyphPath(FT_Face face, Path* path) {
 
 bool FTScalerContext::generatePath(GlyphID glyphID, bool fauxBold, bool fauxItalic,
                                    Path* path) const {
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
-  auto face = ftTypeface()->face;
-  if (!loadOutlineGlyph(face, glyphID, fauxBold, fauxItalic)) {
+  return generatePathInternal(glyphID, fauxBold, fauxItalic, true, path);
+}
+
+bool FTScalerContext::generateUnhintedPath(GlyphID glyphID, bool fauxBold, bool fauxItalic,
+                                           Path* path) const {
+  return generatePathInternal(glyphID, fauxBold, fauxItalic, false, path);
+}
+
+bool FTScalerContext::generatePathInternal(GlyphID glyphID, bool fauxBold, bool fauxItalic,
+                                           bool hinting, Path* path) const {
+  AutoFTFace ftFace(ftTypeface());
+  if (!loadOutlineGlyph(ftFace.get(), glyphID, fauxBold, fauxItalic, hinting)) {
     path->reset();
     return false;
   }
-  if (!GenerateGlyphPath(face, path)) {
+  if (!GenerateGlyphPath(ftFace.get()->face(), path)) {
     path->reset();
     return false;
   }
   return true;
 }
 
-void FTScalerContext::getBBoxForCurrentGlyph(FT_BBox* bbox) const {
-  auto face = ftTypeface()->face;
+static void GetBBoxForCurrentGlyph(FT_Face face, FT_BBox* bbox) {
   FT_Outline_Get_CBox(&face->glyph->outline, bbox);
 
   // outset the box to integral boundaries
@@ -509,13 +510,13 @@ void FTScalerContext::getBBoxForCurrentGlyph(FT_BBox* bbox) const {
 }
 
 Rect FTScalerContext::getBounds(tgfx::GlyphID glyphID, bool fauxBold, bool fauxItalic) const {
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
+  AutoFTFace ftFace(ftTypeface());
   Rect bounds = {};
-  if (setupSize(fauxItalic)) {
+  if (setupSize(ftFace.get(), fauxItalic)) {
     return bounds;
   }
   auto glyphFlags = loadGlyphFlags | static_cast<FT_Int32>(FT_LOAD_BITMAP_METRICS_ONLY);
-  auto face = ftTypeface()->face;
+  auto face = ftFace.get()->face();
   auto err = FT_Load_Glyph(face, glyphID, glyphFlags);
   if (err != FT_Err_Ok) {
     return bounds;
@@ -528,7 +529,7 @@ Rect FTScalerContext::getBounds(tgfx::GlyphID glyphID, bool fauxBold, bool fauxI
     FT_BBox rect = {FT_PosLimits::max(), FT_PosLimits::max(), FT_PosLimits::min(),
                     FT_PosLimits::min()};
     if (0 < face->glyph->outline.n_contours) {
-      getBBoxForCurrentGlyph(&rect);
+      GetBBoxForCurrentGlyph(face, &rect);
     } else {
       rect = {0, 0, 0, 0};
     }
@@ -560,15 +561,14 @@ Rect FTScalerContext::getBounds(tgfx::GlyphID glyphID, bool fauxBold, bool fauxI
 }
 
 float FTScalerContext::getAdvance(GlyphID glyphID, bool verticalText) const {
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
-  if (setupSize(false)) {
+  AutoFTFace ftFace(ftTypeface());
+  if (setupSize(ftFace.get(), false)) {
     return 0;
   }
-  return getAdvanceInternal(glyphID, verticalText);
+  return getAdvanceInternal(ftFace.get()->face(), glyphID, verticalText);
 }
 
-float FTScalerContext::getAdvanceInternal(GlyphID glyphID, bool verticalText) const {
-  auto face = ftTypeface()->face;
+float FTScalerContext::getAdvanceInternal(FT_Face face, GlyphID glyphID, bool verticalText) const {
   auto glyphFlags = loadGlyphFlags | static_cast<FT_Int32>(FT_LOAD_BITMAP_METRICS_ONLY);
   if (verticalText) {
     glyphFlags |= FT_LOAD_VERTICAL_LAYOUT;
@@ -581,13 +581,17 @@ float FTScalerContext::getAdvanceInternal(GlyphID glyphID, bool verticalText) co
 }
 
 Point FTScalerContext::getVerticalOffset(GlyphID glyphID) const {
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
-  if (glyphID == 0 || setupSize(false)) {
+  if (glyphID == 0) {
     return {};
   }
+  AutoFTFace ftFace(ftTypeface());
+  if (setupSize(ftFace.get(), false)) {
+    return {};
+  }
+  auto face = ftFace.get()->face();
   FontMetrics metrics = {};
-  getFontMetricsInternal(&metrics);
-  auto advanceX = getAdvanceInternal(glyphID);
+  getFontMetricsInternal(face, &metrics);
+  auto advanceX = getAdvanceInternal(face, glyphID);
   return {-advanceX * 0.5f, metrics.capHeight};
 }
 
@@ -604,13 +608,13 @@ Rect FTScalerContext::getImageTransform(GlyphID glyphID, bool fauxBold, const St
     return bounds;
   }
 
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
+  AutoFTFace ftFace(ftTypeface());
   auto glyphFlags = loadGlyphFlags | static_cast<FT_Int32>(FT_LOAD_BITMAP_METRICS_ONLY);
   glyphFlags &= ~FT_LOAD_NO_BITMAP;
-  if (!loadBitmapGlyph(glyphID, glyphFlags)) {
+  if (!loadBitmapGlyph(ftFace.get(), glyphID, glyphFlags)) {
     return {};
   }
-  auto face = ftTypeface()->face;
+  auto face = ftFace.get()->face();
   if (matrix) {
     matrix->setTranslate(static_cast<float>(face->glyph->bitmap_left),
                          -static_cast<float>(face->glyph->bitmap_top));
@@ -629,23 +633,45 @@ bool FTScalerContext::readPixels(GlyphID glyphID, bool fauxBold, const Stroke*,
   // Note: In the hasColor() function, freeType has an internal lock. Placing this method later
   // would cause repeated locking and lead to a deadlock.
   bool colorFont = hasColor();
-  std::lock_guard<std::mutex> autoLock(ftTypeface()->locker);
+  AutoFTFace ftFace(ftTypeface());
+  return readPixelsInternal(ftFace.get(), glyphID, fauxBold, colorFont, dstInfo, dstPixels);
+}
+
+size_t FTScalerContext::readPixelsInBatch(const std::vector<GlyphPixelsRequest>& requests) const {
+  bool colorFont = hasColor();
+  size_t count = 0;
+  // Rasterize the whole batch with one face, so that the face is taken from the typeface only once.
+  AutoFTFace ftFace(ftTypeface());
+  for (auto& request : requests) {
+    if (request.dstInfo.isEmpty() || request.dstPixels == nullptr) {
+      continue;
+    }
+    if (readPixelsInternal(ftFace.get(), request.glyphID, request.fauxBold, colorFont,
+                           request.dstInfo, request.dstPixels)) {
+      count++;
+    }
+  }
+  return count;
+}
+
+bool FTScalerContext::readPixelsInternal(FTFace* ftFace, GlyphID glyphID, bool fauxBold,
+                                         bool colorFont, const ImageInfo& dstInfo,
+                                         void* dstPixels) const {
   if (!colorFont) {
-    auto face = ftTypeface()->face;
-    if (!loadOutlineGlyph(face, glyphID, fauxBold, false)) {
+    if (!loadOutlineGlyph(ftFace, glyphID, fauxBold, false)) {
       return false;
     }
     ClearPixels(dstInfo, dstPixels);
-    RenderOutLineGlyph(face, dstInfo, dstPixels);
+    RenderOutLineGlyph(ftFace->face(), dstInfo, dstPixels);
     return true;
   }
   auto glyphFlags = loadGlyphFlags;
   glyphFlags |= FT_LOAD_RENDER;
   glyphFlags &= ~FT_LOAD_NO_BITMAP;
-  if (!loadBitmapGlyph(glyphID, glyphFlags)) {
+  if (!loadBitmapGlyph(ftFace, glyphID, glyphFlags)) {
     return false;
   }
-  auto ftBitmap = ftTypeface()->face->glyph->bitmap;
+  auto ftBitmap = ftFace->face()->glyph->bitmap;
   auto width = ftBitmap.width;
   auto height = ftBitmap.rows;
   auto src = reinterpret_cast<const uint8_t*>(ftBitmap.buffer);
@@ -672,11 +698,12 @@ bool FTScalerContext::readPixels(GlyphID glyphID, bool fauxBold, const Stroke*,
   return true;
 }
 
-bool FTScalerContext::loadBitmapGlyph(GlyphID glyphID, FT_Int32 glyphFlags) const {
-  if (setupSize(false)) {
+bool FTScalerContext::loadBitmapGlyph(FTFace* ftFace, GlyphID glyphID,
+                                      FT_Int32 glyphFlags) const {
+  if (setupSize(ftFace, false)) {
     return false;
   }
-  auto face = ftTypeface()->face;
+  auto face = ftFace->face();
   auto err = FT_Load_Glyph(face, glyphID, glyphFlags);
   if (err != FT_Err_Ok || face->glyph->format != FT_GLYPH_FORMAT_BITMAP) {
     return false;
@@ -697,15 +724,19 @@ FTTypeface* FTScalerContext::ftTypeface() const {
   return static_cast<FTTypeface*>(typeface.get());
 }
 
-bool FTScalerContext::loadOutlineGlyph(FT_Face face, GlyphID glyphID, bool fauxBold,
-                                       bool fauxItalic) const {
+bool FTScalerContext::loadOutlineGlyph(FTFace* ftFace, GlyphID glyphID, bool fauxBold,
+                                       bool fauxItalic, bool hinting) const {
   // FT_IS_SCALABLE is documented to mean the face contains outline glyphs.
-  if (!FT_IS_SCALABLE(face) || setupSize(fauxItalic)) {
+  if (setupSize(ftFace, fauxItalic) || !FT_IS_SCALABLE(ftFace->face())) {
     return false;
   }
+  auto face = ftFace->face();
   auto flags = loadGlyphFlags;
   flags |= FT_LOAD_NO_BITMAP;  // ignore embedded bitmaps so we're sure to get the outline
   flags &= ~FT_LOAD_RENDER;    // don't scan convert (we just want the outline)
+  if (!hinting) {
+    flags |= FT_LOAD_NO_HINTING;
+  }
   auto err = FT_Load_Glyph(face, glyphID, flags);
   if (err != FT_Err_Ok || face->glyph->format != FT_GLYPH_FORMAT_OUTLINE) {
     return false;
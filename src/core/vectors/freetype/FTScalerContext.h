@@ -30,8 +30,6 @@ class FTScalerContext : public ScalerContext {
  public:
   FTScalerContext(std::shared_ptr<Typeface> typeFace, float textSize);
 
-  ~FTScalerContext() override;
-
   FontMetrics getFontMetrics() const override;
 
   Rect getBounds(GlyphID glyphID, bool fauxBold, bool fauxItalic) const override;
@@ -42,38 +40,48 @@ class FTScalerContext : public ScalerContext {
 
   bool generatePath(GlyphID glyphID, bool fauxBold, bool fauxItalic, Path* path) const override;
 
+  bool generateUnhintedPath(GlyphID glyphID, bool fauxBold, bool fauxItalic,
+                            Path* path) const override;
+
   Rect getImageTransform(GlyphID glyphID, bool fauxBold, const Stroke* stroke,
                          Matrix* matrix) const override;
 
   bool readPixels(GlyphID glyphID, bool fauxBold, const Stroke* stroke, const ImageInfo& dstInfo,
                   void* dstPixels) const override;
 
+  size_t readPixelsInBatch(const std::vector<GlyphPixelsRequest>& requests) const override;
+
   float getBackingSize() const override {
     return backingSize;
   }
 
  private:
-  int setupSize(bool fauxItalic) const;
+  int setupSize(FTFace* ftFace, bool fauxItalic) const;
 
-  void getFontMetricsInternal(FontMetrics* metrics) const;
+  void getFontMetricsInternal(FT_Face face, FontMetrics* metrics) const;
 
-  float getAdvanceInternal(GlyphID glyphID, bool verticalText = false) const;
+  bool readPixelsInternal(FTFace* ftFace, GlyphID glyphID, bool fauxBold, bool colorFont,
+                          const ImageInfo& dstInfo, void* dstPixels) const;
 
-  bool getCBoxForLetter(char letter, FT_BBox* bbox) const;
+  float getAdvanceInternal(FT_Face face, GlyphID glyphID, bool verticalText = false) const;
 
-  void getBBoxForCurrentGlyph(FT_BBox* bbox) const;
+  bool getCBoxForLetter(FT_Face face, char letter, FT_BBox* bbox) const;
 
-  bool loadBitmapGlyph(GlyphID glyphID, FT_Int32 glyphFlags) const;
+  bool loadBitmapGlyph(FTFace* ftFace, GlyphID glyphID, FT_Int32 glyphFlags) const;
 
   Matrix getExtraMatrix(bool fauxItalic) const;
 
   FTTypeface* ftTypeface() const;
 
-  bool loadOutlineGlyph(FT_Face face, GlyphID glyphID, bool fauxBold, bool fauxItalic) const;
+  bool loadOutlineGlyph(FTFace* ftFace, GlyphID glyphID, bool fauxBold, bool fauxItalic,
+                        bool hinting = true) const;
+
+  bool generatePathInternal(GlyphID glyphID, bool fauxBold, bool fauxItalic, bool hinting,
+                            Path* path) const;
 
   float textScale = 1.0f;
   Point extraScale = Point::Make(1.f, 1.f);
-  FT_Size ftSize = nullptr;
+  FT_F26Dot6 charSize = 0;  // The char size requested for scalable faces.
   FT_Int strikeIndex = -1;  // The bitmap strike for the face (or -1 if none).
   FT_Int32 loadGlyphFlags = 0;
   float backingSize = 1.0f;
@@ -26,8 +26,10 @@
 #include FT_FONT_FORMATS_H
 #include FT_TYPE1_TABLES_H
 #include <array>
+#include <list>
 #include "FTScalerContext.h"
 #include "SystemFont.h"
+#include "core/utils/Log.h"
 #include "core/utils/UniqueID.h"
 
 namespace tgfx {
@@ -62,30 +64,25 @@ static std::mutex& FTMutex() {
   return mutex;
 }
 
+struct IdleFace {
+  uint32_t typefaceID = 0;
+  std::unique_ptr<FTFace> ftFace = nullptr;
+};
+
+static std::mutex& IdleFaceLocker() {
+  static std::mutex& mutex = *new std::mutex;
+  return mutex;
+}
+
+// The idle faces of all typefaces, from the most recently used to the least.
+static std::list<IdleFace>& IdleFaces() {
+  static std::list<IdleFace>& idleFaces = *new std::list<IdleFace>;
+  return idleFaces;
+}
+
 static FT_Face CreateFTFace(const FTFontData& data) {
   std::lock_guard<std::mutex> autoLock(FTMutex());
-  FT_Open_Args args;
-  memset(&args, 0, sizeof(args));
-  if (data.data) {
-    args.flags = FT_OPEN_MEMORY;
-    args.memory_base = static_cast<const FT_Byte*>(data.data->data());
-    args.memory_size = static_cast<FT_Long>(data.data->size());
-  } else if (!data.path.empty()) {
-    args.flags = FT_OPEN_PATHNAME;
-    args.pathname = const_cast<FT_String*>(data.path.c_str());
-  } else {
-    return nullptr;
-  }
-  FT_Face face = nullptr;
-  auto ftLibrary = FTLibrary::Get();
-  auto err = FT_Open_Face(ftLibrary, &args, data.ttcIndex, &face);
-  if (err || !face->family_name) {
-    return nullptr;
-  }
-  if (!face->charmap) {
-    FT_Select_Charmap(face, FT_ENCODING_MS_SYMBOL);
-  }
-  return face;
+  return FTFace::OpenFace(FTLibrary::Get(), data);
 }
 
 std::shared_ptr<FTTypeface> FTTypeface::Make(FTFontData data) {
@@ -103,10 +100,83 @@ FTTypeface::FTTypeface(FTFontData data, FT_Face face)
 }
 
 FTTypeface::~FTTypeface() {
+  std::list<IdleFace> ownFaces = {};
+  {
+    std::lock_guard<std::mutex> autoLock(IdleFaceLocker());
+    auto& idleFaces = IdleFaces();
+    for (auto item = idleFaces.begin(); item != idleFaces.end();) {
+      auto next = std::next(item);
+      if (item->typefaceID == _uniqueID) {
+        ownFaces.splice(ownFaces.end(), idleFaces, item);
+      }
+      item = next;
+    }
+  }
+  // Destroy the idle faces outside the locker.
+  ownFaces.clear();
   std::lock_guard<std::mutex> autoLock(FTMutex());
   FT_Done_Face(face);
 }
 
+size_t FTTypeface::ReleaseIdleFaces() {
+  std::list<IdleFace> faces = {};
+  {
+    std::lock_guard<std::mutex> autoLock(IdleFaceLocker());
+    faces.swap(IdleFaces());
+  }
+  return faces.size();
+}
+
+std::unique_ptr<FTFace> FTTypeface::acquireFace() const {
+  auto threadID = std::this_thread::get_id();
+  {
+    std::lock_guard<std::mutex> autoLock(IdleFaceLocker());
+    auto& idleFaces = IdleFaces();
+    auto result = idleFaces.end();
+    for (auto item = idleFaces.begin(); item != idleFaces.end(); ++item) {
+      if (item->typefaceID != _uniqueID) {
+        continue;
+      }
+      if (item->ftFace->threadID == threadID) {
+        result = item;
+        break;
+      }
+      if (result == idleFaces.end()) {
+        result = item;
+      }
+    }
+    if (result != idleFaces.end()) {
+      auto ftFace = std::move(result->ftFace);
+      idleFaces.erase(result);
+      ftFace->threadID = threadID;
+      return ftFace;
+    }
+  }
+  // Opening a face can be slow, so do it outside the locker.
+  auto ftFace = FTFace::Make(data);
+  if (ftFace == nullptr) {
+    LOGE("FTTypeface::acquireFace() Failed to open the font data!");
+    return nullptr;
+  }
+  ftFace->threadID = threadID;
+  return ftFace;
+}
+
+void FTTypeface::releaseFace(std::unique_ptr<FTFace> ftFace) const {
+  std::unique_ptr<FTFace> expiredFace = nullptr;
+  {
+    std::lock_guard<std::mutex> autoLock(IdleFaceLocker());
+    auto& idleFaces = IdleFaces();
+    idleFaces.push_front({_uniqueID, std::move(ftFace)});
+    if (idleFaces.size() > MaxIdleFaceCount) {
+      expiredFace = std::move(idleFaces.back().ftFace);
+      idleFaces.pop_back();
+    }
+  }
+  // Too many idle faces, destroy the least recently used one outside the locker.
+  expiredFace = nullptr;
+}
+
 std::string FTTypeface::fontFamily() const {
   std::lock_guard<std::mutex> autoLock(locker);
   return face->family_name ? face->family_name : "";
@@ -124,10 +194,10 @@ size_t FTTypeface::glyphsCount() const {
 
 int FTTypeface::unitsPerEm() const {
   std::lock_guard<std::mutex> autoLock(locker);
-  return unitsPerEmInternal();
+  return UnitsPerEm(face);
 }
 
-int FTTypeface::unitsPerEmInternal() const {
+int FTTypeface::UnitsPerEm(FT_Face face) {
   auto upem = face->units_per_EM;
   // At least some versions of FreeType set face->units_per_EM to 0 for bitmap only fonts.
   if (upem == 0) {
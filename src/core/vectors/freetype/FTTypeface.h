@@ -22,6 +22,7 @@
 #include "ft2build.h"
 #include "tgfx/core/Stream.h"
 #include FT_FREETYPE_H
+#include "FTFace.h"
 #include "FTFontData.h"
 #include "tgfx/core/Font.h"
 #include "tgfx/core/Typeface.h"
@@ -31,6 +32,12 @@ class FTTypeface : public Typeface {
  public:
   static std::shared_ptr<FTTypeface> Make(FTFontData data);
 
+  /**
+   * Destroys the idle faces of all typefaces, which are cloned for glyph work on other threads and
+   * reopened on demand. Returns the number of faces destroyed.
+   */
+  static size_t ReleaseIdleFaces();
+
   ~FTTypeface() override;
 
   uint32_t uniqueID() const override {
@@ -67,18 +74,66 @@ class FTTypeface : public Typeface {
   std::shared_ptr<ScalerContext> onCreateScalerContext(float size) const override;
 
  private:
+  // Each idle face holds its own FT_Library and, for path fonts, an open file, so their total count
+  // is limited across all typefaces.
+  static constexpr size_t MaxIdleFaceCount = 16;
+
   uint32_t _uniqueID = 0;
   FTFontData data;
   FT_Face face = nullptr;
 
   FTTypeface(FTFontData data, FT_Face face);
 
-  int unitsPerEmInternal() const;
+  static int UnitsPerEm(FT_Face face);
+
+  /**
+   * Takes an idle face for exclusive use on the current thread, preferring the one used by the
+   * same thread last time, or creates a new one if there is none. Returns nullptr if the font
+   * data can't be opened.
+   */
+  std::unique_ptr<FTFace> acquireFace() const;
+
+  /**
+   * Returns a face taken by acquireFace() to the idle faces. The idle faces are shared by all
+   * typefaces, and the least recently used one is destroyed if there are too many.
+   */
+  void releaseFace(std::unique_ptr<FTFace> ftFace) const;
 
 #ifdef TGFX_USE_ADVANCED_TYPEFACE_PROPERTY
   bool isOpentypeFontDataStandardFormat() const;
 #endif
 
   friend class FTScalerContext;
+  friend class AutoFTFace;
+};
+
+/**
+ * AutoFTFace takes a face of the typeface for exclusive use during its lifetime, and returns it to
+ * the typeface when destroyed. Different threads get different faces, so they can load and render
+ * glyphs of the same typeface at the same time.
+ */
+class AutoFTFace {
+ public:
+  explicit AutoFTFace(const FTTypeface* typeface)
+      : typeface(typeface), ftFace(typeface->acquireFace()) {
+  }
+
+  ~AutoFTFace() {
+    if (ftFace != nullptr) {
+      typeface->releaseFace(std::move(ftFace));
+    }
+  }
+
+  AutoFTFace(const AutoFTFace&) = delete;
+
+  AutoFTFace& operator=(const AutoFTFace&) = delete;
+
+  FTFace* get() const {
+    return ftFace.get();
+  }
+
+ private:
+  const FTTypeface* typeface = nullptr;
+  std::unique_ptr<FTFace> ftFace = nullptr;
 };
 }  // namespace tgfx
@@ -26,6 +26,10 @@
 using namespace emscripten;
 
 namespace tgfx {
+void ScalerContext::ReleaseIdleResources() {
+  // The glyphs are rendered by the browser, which manages the memory of the fonts itself.
+}
+
 WebScalerContext::WebScalerContext(std::shared_ptr<Typeface> typeface, float size,
                                    val scalerContext)
     : ScalerContext(std::move(typeface), size), scalerContext(std::move(scalerContext)) {
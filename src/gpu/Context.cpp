@@ -18,6 +18,7 @@
 
 #include "tgfx/gpu/Context.h"
 #include "core/AtlasManager.h"
+#include "core/ScalerContext.h"
 #include "core/utils/BlockAllocator.h"
 #include "core/utils/Log.h"
 #include "core/utils/SlidingWindowTracker.h"
@@ -30,6 +31,8 @@
 #include "tgfx/gpu/GPU.h"
 
 namespace tgfx {
+// The number of recently used programs kept in the cache under moderate memory pressure.
+static constexpr size_t MODERATE_PRESSURE_PROGRAM_COUNT = 32;
 
 Context::Context(Device* device, GPU* gpu) : _device(device), _gpu(gpu) {
   _shaderCaps = new ShaderCaps(gpu);
@@ -57,6 +60,15 @@ BlockAllocator* Context::drawingAllocator() const {
   return _drawingManager->drawingAllocator();
 }
 
+std::shared_ptr<Data> Context::exportProgramKeys() const {
+  return _globalCache->exportProgramRecipes();
+}
+
+bool Context::precompilePrograms(std::shared_ptr<Data> data,
+                                 std::chrono::steady_clock::duration timeBudget) {
+  return _globalCache->precompilePrograms(std::move(data), timeBudget);
+}
+
 bool Context::wait(const BackendSemaphore& waitSemaphore) {
   auto semaphore = gpu()->importBackendSemaphore(waitSemaphore);
   if (semaphore == nullptr) {
@@ -114,12 +126,17 @@ void Context::submit(std::unique_ptr<Recording> recording, bool syncCpu) {
       auto commandBuffer = drawingBuffer->encode();
       _resourceCache->advanceFrameAndPurge();
       queue->submit(std::move(commandBuffer));
+      _submitSerial++;
+      _globalCache->resetStreamingBuffers();
       pendingDrawingBuffers.pop_front();
       if (drawingBuffer == targetBuffer) {
         break;
       }
     }
   }
+  if (pendingDrawingBuffers.empty()) {
+    checkMemorySoftLimit();
+  }
   if (syncCpu) {
     queue->waitUntilCompleted();
   }
@@ -134,8 +151,30 @@ bool Context::flushAndSubmit(bool syncCpu) {
   return hasRecording;
 }
 
+void Context::checkMemorySoftLimit() {
+  auto usage = memoryUsage();
+  if (usage <= _memorySoftLimit) {
+    overMemorySoftLimit = false;
+    return;
+  }
+  // Only respond when the usage crosses the limit. If the resources in use keep it above the limit,
+  // purging again at every submit would release nothing but the caches of the next frames.
+  if (overMemorySoftLimit || handlingMemoryPressure) {
+    return;
+  }
+  overMemorySoftLimit = true;
+  _proxyProvider->purgeExpiredProxies();
+  _drawingManager->releaseIdleBuffers(1);
+  // The atlas pages and the streaming buffers are not purgeable, so they come off the target.
+  auto reservedBytes = _atlasManager->memoryUsage() + _globalCache->bufferMemoryUsage();
+  _resourceCache->purgeUntilMemoryTo(
+      _memorySoftLimit > reservedBytes ? _memorySoftLimit - reservedBytes : 0);
+  memoryPressureCounts[static_cast<int>(MemoryPressure::Moderate)]++;
+}
+
 size_t Context::memoryUsage() const {
-  return _resourceCache->getResourceBytes();
+  return _resourceCache->getResourceBytes() + _atlasManager->memoryUsage() +
+         _globalCache->bufferMemoryUsage();
 }
 
 size_t Context::purgeableBytes() const {
@@ -150,6 +189,14 @@ void Context::setCacheLimit(size_t bytesLimit) {
   _resourceCache->setCacheLimit(bytesLimit);
 }
 
+size_t Context::cacheLimit(ResourceCategory category) const {
+  return _resourceCache->cacheLimit(category);
+}
+
+void Context::setCacheLimit(ResourceCategory category, size_t bytesLimit) {
+  _resourceCache->setCacheLimit(category, bytesLimit);
+}
+
 size_t Context::resourceExpirationFrames() const {
   return _resourceCache->expirationFrames();
 }
@@ -165,4 +212,35 @@ void Context::purgeResourcesNotUsedSince(std::chrono::steady_clock::time_point p
 bool Context::purgeResourcesUntilMemoryTo(size_t bytesLimit) {
   return _resourceCache->purgeUntilMemoryTo(bytesLimit);
 }
+
+size_t Context::onMemoryPressure(MemoryPressure level) {
+  if (handlingMemoryPressure) {
+    return 0;
+  }
+  handlingMemoryPressure = true;
+  // The atlas upload tasks refer to the plots of the atlases, so all pending drawing operations
+  // must be submitted before trimming the atlases.
+  flushAndSubmit();
+  auto oldUsage = memoryUsage();
+  auto oldResourceBytes = _resourceCache->getResourceBytes();
+  auto critical = level == MemoryPressure::Critical;
+  if (critical) {
+    _atlasManager->releaseAll();
+  } else {
+    _atlasManager->releaseIdlePages();
+  }
+  _proxyProvider->purgeExpiredProxies();
+  _drawingManager->releaseIdleBuffers(critical ? 0 : 1);
+  _globalCache->purgePrograms(critical ? 0 : MODERATE_PRESSURE_PROGRAM_COUNT);
+  ScalerContext::ReleaseIdleResources();
+  // Resources that are cheap to regenerate per byte, such as scratch render targets, are purged
+  // first, so the moderate level keeps the expensive ones like decoded images if possible. The
+  // target only counts the resource cache, like the soft limit, since the atlas pages and the
+  // streaming buffers are trimmed above and can't be purged from it.
+  _resourceCache->purgeUntilMemoryTo(critical ? 0 : oldResourceBytes / 2);
+  memoryPressureCounts[static_cast<int>(level)]++;
+  handlingMemoryPressure = false;
+  auto newUsage = memoryUsage();
+  return oldUsage > newUsage ? oldUsage - newUsage : 0;
+}
 }  // namespace tgfx
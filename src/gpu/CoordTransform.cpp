@@ -26,6 +26,8 @@ Matrix CoordTransform::getTotalMatrix() const {
   }
   auto textureView = textureProxy->getTextureView();
   auto combined = matrix;
+  auto offset = textureProxy->backingStoreOffset();
+  combined.postTranslate(offset.x, offset.y);
   // normalize
   auto scale = textureView->getTextureCoord(1, 1);
   combined.postScale(scale.x, scale.y);
@@ -56,9 +56,7 @@ std::shared_ptr<CommandBuffer> DrawingBuffer::encode() {
   }
   vertexMaxValueTracker.addValue(vertexAllocator.size());
   drawingMaxValueTracker.addValue(drawingAllocator.size());
-  auto commandBuffer = commandEncoder->finish();
-  context->globalCache()->resetUniformBuffer();
-  return commandBuffer;
+  return commandEncoder->finish();
 }
 
 bool DrawingBuffer::empty() const {
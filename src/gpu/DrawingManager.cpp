@@ -18,6 +18,7 @@
 
 #include "DrawingManager.h"
 #include "ProxyProvider.h"
+#include "RenderTaskGraph.h"
 #include "core/AtlasManager.h"
 #include "gpu/proxies/RenderTargetProxy.h"
 #include "gpu/proxies/TextureProxy.h"
@@ -44,6 +45,17 @@ DrawingBuffer* DrawingManager::createDrawingBuffer() {
   return currentBuffer.get();
 }
 
+void DrawingManager::releaseIdleBuffers(size_t keepCount) {
+  size_t idleCount = 0;
+  for (auto it = bufferPool.begin(); it != bufferPool.end();) {
+    if (it->use_count() == 1 && ++idleCount > keepCount) {
+      it = bufferPool.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 bool DrawingManager::fillRTWithFP(std::shared_ptr<RenderTargetProxy> renderTarget,
                                   PlacementPtr<FragmentProcessor> processor, uint32_t renderFlags) {
   if (renderTarget == nullptr || processor == nullptr) {
@@ -150,25 +162,37 @@ void DrawingManager::addResourceTask(PlacementPtr<ResourceTask> resourceTask) {
   drawingBuffer->resourceTasks.emplace_back(std::move(resourceTask));
 }
 
-void DrawingManager::addAtlasCellTask(std::shared_ptr<TextureProxy> textureProxy,
+void DrawingManager::addAtlasCellTask(std::shared_ptr<TextureProxy> textureProxy, Plot* plot,
                                       const Point& atlasOffset, std::shared_ptr<ImageCodec> codec) {
-  if (textureProxy == nullptr || codec == nullptr) {
+  if (textureProxy == nullptr || plot == nullptr || codec == nullptr) {
     return;
   }
-  auto drawingBuffer = getDrawingBuffer();
-  auto allocator = &drawingBuffer->drawingAllocator;
-  AtlasUploadTask* atlasUploadTask = nullptr;
+  auto atlasUploadTask = getAtlasUploadTask(std::move(textureProxy));
+  atlasUploadTask->addCell(std::move(codec), plot, atlasOffset);
+}
+
+void DrawingManager::addAtlasGlyphTask(std::shared_ptr<TextureProxy> textureProxy, Plot* plot,
+                                       const Point& atlasOffset,
+                                       std::shared_ptr<GlyphRasterizer> rasterizer) {
+  if (textureProxy == nullptr || plot == nullptr || rasterizer == nullptr) {
+    return;
+  }
+  auto atlasUploadTask = getAtlasUploadTask(std::move(textureProxy));
+  atlasUploadTask->addGlyphCell(std::move(rasterizer), plot, atlasOffset);
+}
+
+AtlasUploadTask* DrawingManager::getAtlasUploadTask(std::shared_ptr<TextureProxy> textureProxy) {
   auto taskKey = textureProxy.get();
   auto result = atlasTaskMap.find(taskKey);
   if (result != atlasTaskMap.end()) {
-    atlasUploadTask = result->second;
-  } else {
-    auto atlasTask = allocator->make<AtlasUploadTask>(std::move(textureProxy));
-    atlasUploadTask = atlasTask.get();
-    drawingBuffer->atlasTasks.emplace_back(std::move(atlasTask));
-    atlasTaskMap[taskKey] = atlasUploadTask;
-  }
-  atlasUploadTask->addCell(allocator, std::move(codec), atlasOffset);
+    return result->second;
+  }
+  auto drawingBuffer = getDrawingBuffer();
+  auto atlasTask = drawingBuffer->drawingAllocator.make<AtlasUploadTask>(std::move(textureProxy));
+  auto atlasUploadTask = atlasTask.get();
+  drawingBuffer->atlasTasks.emplace_back(std::move(atlasTask));
+  atlasTaskMap[taskKey] = atlasUploadTask;
+  return atlasUploadTask;
 }
 
 std::shared_ptr<DrawingBuffer> DrawingManager::flush() {
@@ -180,9 +204,14 @@ std::shared_ptr<DrawingBuffer> DrawingManager::flush() {
     // The makeClosed() method may add more compositors to the list.
     compositor->makeClosed();
   }
+  // No more cells can be added to the atlases, submit the glyph batches that are not full yet.
+  for (auto& item : atlasTaskMap) {
+    item.second->submitPendingGlyphs();
+  }
   // Flush the shared vertex buffer before executing the tasks. It may generate new resource tasks.
   context->proxyProvider()->flushSharedVertexBuffer();
   atlasTaskMap.clear();
+  RenderTaskGraph::Optimize(&currentBuffer->renderTasks);
 
   if (currentBuffer->empty()) {
     currentBuffer->reset();
@@ -73,8 +73,15 @@ class DrawingManager {
 
   void addResourceTask(PlacementPtr<ResourceTask> resourceTask);
 
-  void addAtlasCellTask(std::shared_ptr<TextureProxy> textureProxy, const Point& atlasOffset,
-                        std::shared_ptr<ImageCodec> codec);
+  void addAtlasCellTask(std::shared_ptr<TextureProxy> textureProxy, Plot* plot,
+                        const Point& atlasOffset, std::shared_ptr<ImageCodec> codec);
+
+  /**
+   * Adds a glyph cell to the atlas. Unlike addAtlasCellTask(), the glyphs sharing the same
+   * ScalerContext are rasterized in batches.
+   */
+  void addAtlasGlyphTask(std::shared_ptr<TextureProxy> textureProxy, Plot* plot,
+                         const Point& atlasOffset, std::shared_ptr<GlyphRasterizer> rasterizer);
 
   /**
    * Flushes all pending drawing operations and returns the DrawingBuffer. Returns nullptr if there
@@ -83,6 +90,12 @@ class DrawingManager {
    */
   std::shared_ptr<DrawingBuffer> flush();
 
+  /**
+   * Releases the pooled DrawingBuffers that are no longer referenced, along with the memory blocks
+   * of their allocators, keeping at most keepCount of them for reuse.
+   */
+  void releaseIdleBuffers(size_t keepCount);
+
  private:
   Context* context = nullptr;
   std::shared_ptr<DrawingBuffer> currentBuffer = nullptr;
@@ -96,6 +109,8 @@ class DrawingManager {
 
   DrawingBuffer* createDrawingBuffer();
 
+  AtlasUploadTask* getAtlasUploadTask(std::shared_ptr<TextureProxy> textureProxy);
+
   friend class OpsCompositor;
 };
 }  // namespace tgfx
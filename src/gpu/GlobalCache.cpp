@@ -17,9 +17,11 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GlobalCache.h"
+#include <algorithm>
 #include "AlignTo.h"
 #include "core/GradientGenerator.h"
 #include "core/PixelBuffer.h"
+#include "gpu/PipelineRecipe.h"
 #include "gpu/ProxyProvider.h"
 #include "gpu/ops/RRectDrawOp.h"
 #include "gpu/ops/RectDrawOp.h"
@@ -28,10 +30,20 @@
 
 namespace tgfx {
 static constexpr size_t MAX_PROGRAM_COUNT = 128;
+// The "TGPR" tag and the format version in front of the exported program recipes.
+static constexpr uint32_t PROGRAM_RECIPES_TAG = 0x52504754;
+static constexpr uint32_t PROGRAM_RECIPES_VERSION = 1;
+static constexpr size_t PROGRAM_RECIPES_HEADER_SIZE = 2 * sizeof(uint32_t);
 static constexpr size_t MAX_NUM_CACHED_GRADIENT_BITMAPS = 32;
 static constexpr uint16_t VERTICES_PER_NON_AA_QUAD = 4;
 static constexpr uint16_t VERTICES_PER_AA_QUAD = 8;
 static constexpr size_t MAX_UNIFORM_BUFFER_SIZE = 64 * 1024;
+// Matches the max block size of the vertex allocator in DrawingBuffer, so that each vertex block
+// fits in one streaming buffer.
+static constexpr size_t VERTEX_STREAMING_BLOCK_SIZE = 1 << 21;
+// Staging buffer sizes are rounded up so that images of similar sizes can share the same buffers.
+static constexpr size_t STAGING_BUFFER_ALIGNMENT = 64 * 1024;
+static constexpr size_t MAX_STAGING_BUFFER_COUNT = 4;
 static constexpr uint16_t VERTICES_PER_AA_MITER_STROKE_RECT = 16;
 static constexpr uint16_t VERTICES_PER_AA_BEVEL_STROKE_RECT = 24;
 static constexpr uint16_t VERTICES_PER_AA_ROUND_STROKE_RECT = 24;
@@ -43,12 +55,18 @@ GlobalCache::GlobalCache(Context* context) : context(context) {
 }
 
 std::shared_ptr<Program> GlobalCache::findProgram(const BytesKey& programKey) {
+  // BytesKey compares the pre-computed 64-bit hashes first, so a mismatch costs one comparison.
+  if (lastProgram != nullptr && lastProgram->programKey == programKey) {
+    // The last program is already at the front of the LRU list.
+    return lastProgram;
+  }
   auto result = programMap.find(programKey);
   if (result != programMap.end()) {
     auto program = result->second;
     programLRU.erase(program->cachedPosition);
     programLRU.push_front(program.get());
     program->cachedPosition = programLRU.begin();
+    lastProgram = program;
     return program;
   }
   return nullptr;
@@ -74,96 +92,227 @@ std::shared_ptr<GPUBuffer> GlobalCache::findOrCreateUniformBuffer(size_t bufferS
         bufferSize, maxUBOSize, __FILE__, __LINE__);
     return nullptr;
   }
-
-  auto& uniformBufferPacket = tripleUniformBuffer[tripleUniformBufferIndex];
-
-  auto getAverageUniformBufferSize = [this]() {
-    size_t totalUniformBufferSize = 0;
-    for (const auto& packet : tripleUniformBuffer) {
-      totalUniformBufferSize += packet.gpuBuffers.size();
-    }
-    return (totalUniformBufferSize + UNIFORM_BUFFER_COUNT - 1) / UNIFORM_BUFFER_COUNT;
-  };
-
-  if (uniformBufferPacket.gpuBuffers.empty()) {
-    auto buffer = context->gpu()->createBuffer(maxUBOSize, GPUBufferUsage::UNIFORM);
-    if (buffer == nullptr) {
-      LOGE(
-          "[GlobalCache::findOrCreateUniformBuffer] failed to create initial uniform buffer, "
-          "request buffer size: %zu, %s:%d",
-          bufferSize, __FILE__, __LINE__);
-      return nullptr;
-    }
-    uniformBufferPacket.gpuBuffers.emplace_back(std::move(buffer));
-    uniformBufferPacket.bufferIndex = 0;
-    uniformBufferPacket.cursor = 0;
-    maxUniformBufferTracker.addValue(getAverageUniformBufferSize());
-  }
-
-  // Check if triple buffer has enough space
-  if (uniformBufferPacket.bufferIndex < uniformBufferPacket.gpuBuffers.size() &&
-      uniformBufferPacket.cursor + alignedBufferSize <=
-          uniformBufferPacket.gpuBuffers[uniformBufferPacket.bufferIndex]->size()) {
-    *lastBufferOffset = uniformBufferPacket.cursor;
-    uniformBufferPacket.cursor += alignedBufferSize;
-    return uniformBufferPacket.gpuBuffers[uniformBufferPacket.bufferIndex];
-  }
-
-  // Need to move to next buffer or create a new one
-  uniformBufferPacket.bufferIndex++;
-  uniformBufferPacket.cursor = 0;
-
-  if (uniformBufferPacket.bufferIndex >= uniformBufferPacket.gpuBuffers.size()) {
-    // Need to create a new buffer
-    auto buffer = context->gpu()->createBuffer(maxUBOSize, GPUBufferUsage::UNIFORM);
-    if (buffer == nullptr) {
-      LOGE(
-          "[GlobalCache::findOrCreateUniformBuffer] failed to create uniform buffer, request "
-          "buffer size: %zu, %s:%d",
-          bufferSize, __FILE__, __LINE__);
-      return nullptr;
-    }
-    uniformBufferPacket.gpuBuffers.emplace_back(std::move(buffer));
-    maxUniformBufferTracker.addValue(getAverageUniformBufferSize());
+  if (uniformBufferAllocator == nullptr) {
+    uniformBufferAllocator = std::make_unique<StreamingBufferAllocator>(
+        context, GPUBufferUsage::UNIFORM, maxUBOSize, uboOffsetAlignment);
   }
+  return uniformBufferAllocator->allocate(bufferSize, lastBufferOffset);
+}
 
-  *lastBufferOffset = uniformBufferPacket.cursor;
-  uniformBufferPacket.cursor += alignedBufferSize;
-
-  return uniformBufferPacket.gpuBuffers[uniformBufferPacket.bufferIndex];
+std::shared_ptr<GPUBuffer> GlobalCache::allocateVertexBuffer(size_t bufferSize, size_t* offset) {
+  if (vertexBufferAllocator == nullptr) {
+    vertexBufferAllocator = std::make_unique<StreamingBufferAllocator>(
+        context, GPUBufferUsage::VERTEX, VERTEX_STREAMING_BLOCK_SIZE, sizeof(float));
+  }
+  return vertexBufferAllocator->allocate(bufferSize, offset);
 }
 
-void GlobalCache::resetUniformBuffer() {
-  counter++;
-  tripleUniformBufferIndex = counter % UNIFORM_BUFFER_COUNT;
-  if (counter == UNIFORM_BUFFER_COUNT) {
-    counter = 0;
+void GlobalCache::resetStreamingBuffers() {
+  if (uniformBufferAllocator != nullptr) {
+    uniformBufferAllocator->advanceFrame();
   }
+  if (vertexBufferAllocator != nullptr) {
+    vertexBufferAllocator->advanceFrame();
+  }
+}
 
-  auto& currentBuffer = tripleUniformBuffer[tripleUniformBufferIndex];
+size_t GlobalCache::bufferMemoryUsage() const {
+  size_t totalBytes = 0;
+  if (uniformBufferAllocator != nullptr) {
+    totalBytes += uniformBufferAllocator->memoryUsage();
+  }
+  if (vertexBufferAllocator != nullptr) {
+    totalBytes += vertexBufferAllocator->memoryUsage();
+  }
+  for (const auto& buffer : stagingBuffers) {
+    totalBytes += buffer->size();
+  }
+  return totalBytes;
+}
 
-  size_t maxReuseSize = maxUniformBufferTracker.getMaxValue();
-  if (maxReuseSize > 0 && currentBuffer.gpuBuffers.size() > maxReuseSize) {
-    currentBuffer.gpuBuffers.resize(maxReuseSize);
+std::shared_ptr<GPUBuffer> GlobalCache::acquireStagingBuffer(size_t size) {
+  if (size == 0) {
+    return nullptr;
+  }
+  auto bestFit = stagingBuffers.end();
+  for (auto iter = stagingBuffers.begin(); iter != stagingBuffers.end(); ++iter) {
+    auto& buffer = *iter;
+    if (buffer->size() < size || !buffer->isReady()) {
+      continue;
+    }
+    if (bestFit == stagingBuffers.end() || buffer->size() < (*bestFit)->size()) {
+      bestFit = iter;
+    }
   }
+  if (bestFit != stagingBuffers.end()) {
+    auto buffer = std::move(*bestFit);
+    stagingBuffers.erase(bestFit);
+    return buffer;
+  }
+  return context->gpu()->createBuffer(AlignTo(size, STAGING_BUFFER_ALIGNMENT),
+                                      GPUBufferUsage::STAGING);
+}
 
-  currentBuffer.bufferIndex = 0;
-  currentBuffer.cursor = 0;
+void GlobalCache::releaseStagingBuffer(std::shared_ptr<GPUBuffer> buffer) {
+  if (buffer == nullptr) {
+    return;
+  }
+  if (stagingBuffers.size() >= MAX_STAGING_BUFFER_COUNT) {
+    // Drops the least recently released buffer, which is the most likely to be idle already.
+    stagingBuffers.pop_front();
+  }
+  stagingBuffers.push_back(std::move(buffer));
 }
 
-void GlobalCache::addProgram(const BytesKey& programKey, std::shared_ptr<Program> program) {
+void GlobalCache::addProgram(const BytesKey& programKey, std::shared_ptr<Program> program,
+                             std::string recipe) {
   if (program == nullptr) {
     return;
   }
   program->programKey = programKey;
+  if (!recipe.empty()) {
+    auto result = programRecipes.emplace(std::move(recipe), 0).first;
+    result->second++;
+    program->recipe = &result->first;
+  }
   programLRU.push_front(program.get());
   program->cachedPosition = programLRU.begin();
+  lastProgram = program;
   programMap[programKey] = std::move(program);
-  while (programLRU.size() > MAX_PROGRAM_COUNT) {
+  purgePrograms(MAX_PROGRAM_COUNT);
+}
+
+void GlobalCache::purgePrograms(size_t maxCount) {
+  auto pipelineCount = maxCount > programLRU.size() ? maxCount - programLRU.size() : 0;
+  while (precompiledPipelines.size() > pipelineCount) {
+    precompiledPipelines.erase(precompiledPipelines.begin());
+  }
+  while (programLRU.size() > maxCount) {
     auto oldProgram = programLRU.back();
     programLRU.pop_back();
-    programMap.erase(oldProgram->programKey);
+    removeProgram(oldProgram);
+  }
+}
+
+void GlobalCache::removeProgram(Program* program) {
+  if (lastProgram.get() == program) {
+    lastProgram = nullptr;
+  }
+  if (program->recipe != nullptr) {
+    auto result = programRecipes.find(*program->recipe);
+    program->recipe = nullptr;
+    if (result != programRecipes.end() && --result->second == 0) {
+      programRecipes.erase(result);
+    }
+  }
+  // Erasing the program from the map may release it, so this must be done last.
+  programMap.erase(program->programKey);
+}
+
+void GlobalCache::purgeExpiredPipelines() {
+  auto now = std::chrono::steady_clock::now();
+  for (auto item = precompiledPipelines.begin(); item != precompiledPipelines.end();) {
+    if (item->second.expirationTime <= now) {
+      item = precompiledPipelines.erase(item);
+    } else {
+      ++item;
+    }
+  }
+}
+
+std::shared_ptr<Data> GlobalCache::exportProgramRecipes() const {
+  if (programLRU.empty()) {
+    return nullptr;
+  }
+  // Each recipe is stored as its size followed by its bytes.
+  std::string bytes = {};
+  bytes.append(reinterpret_cast<const char*>(&PROGRAM_RECIPES_TAG), sizeof(uint32_t));
+  bytes.append(reinterpret_cast<const char*>(&PROGRAM_RECIPES_VERSION), sizeof(uint32_t));
+  for (auto& program : programLRU) {
+    auto& recipe = program->getRecipe();
+    if (recipe.empty()) {
+      continue;
+    }
+    auto size = static_cast<uint32_t>(recipe.size());
+    bytes.append(reinterpret_cast<const char*>(&size), sizeof(uint32_t));
+    bytes.append(recipe);
+  }
+  return Data::MakeWithCopy(bytes.data(), bytes.size());
+}
+
+static bool IsProgramRecipes(const Data& data) {
+  if (data.size() < PROGRAM_RECIPES_HEADER_SIZE) {
+    return false;
+  }
+  uint32_t header[2] = {};
+  memcpy(header, data.data(), PROGRAM_RECIPES_HEADER_SIZE);
+  return header[0] == PROGRAM_RECIPES_TAG && header[1] == PROGRAM_RECIPES_VERSION;
+}
+
+bool GlobalCache::precompilePrograms(std::shared_ptr<Data> data,
+                                     std::chrono::steady_clock::duration timeBudget) {
+  if (data == nullptr) {
+    return true;
+  }
+  if (data != precompileData) {
+    if (!IsProgramRecipes(*data)) {
+      LOGE("GlobalCache::precompilePrograms() Invalid program recipes!");
+      return true;
+    }
+    precompileData = data;
+    precompileOffset = PROGRAM_RECIPES_HEADER_SIZE;
+  }
+  purgeExpiredPipelines();
+  auto startTime = std::chrono::steady_clock::now();
+  auto bytes = data->bytes();
+  auto size = data->size();
+  while (precompileOffset < size) {
+    if (programLRU.size() + precompiledPipelines.size() >= MAX_PROGRAM_COUNT) {
+      // The cache is full. Keeps the position, so a later call continues once programs have taken
+      // their pipelines or the unused ones have expired.
+      return false;
+    }
+    uint32_t recipeSize = 0;
+    if (size - precompileOffset >= sizeof(uint32_t)) {
+      memcpy(&recipeSize, bytes + precompileOffset, sizeof(uint32_t));
+    }
+    if (size - precompileOffset < sizeof(uint32_t) + recipeSize || recipeSize == 0) {
+      LOGE("GlobalCache::precompilePrograms() Truncated program recipes!");
+      break;
+    }
+    auto recipeBytes = bytes + precompileOffset + sizeof(uint32_t);
+    precompileOffset += sizeof(uint32_t) + recipeSize;
+    std::string recipeKey(reinterpret_cast<const char*>(recipeBytes), recipeSize);
+    PipelineRecipe recipe = {};
+    if (programRecipes.count(recipeKey) > 0 || precompiledPipelines.count(recipeKey) > 0 ||
+        !PipelineRecipe::Decode(recipeBytes, recipeSize, &recipe)) {
+      continue;
+    }
+    auto pipeline = recipe.makePipeline(context);
+    if (pipeline != nullptr) {
+      auto expirationTime = std::chrono::steady_clock::now() + PrecompiledPipelineLifetime;
+      precompiledPipelines[std::move(recipeKey)] = {std::move(pipeline), expirationTime};
+    }
+    if (precompileOffset < size && std::chrono::steady_clock::now() - startTime >= timeBudget) {
+      return false;
+    }
+  }
+  precompileData = nullptr;
+  precompileOffset = 0;
+  return true;
+}
+
+std::shared_ptr<RenderPipeline> GlobalCache::takePrecompiledPipeline(const std::string& recipe) {
+  if (precompiledPipelines.empty()) {
+    return nullptr;
+  }
+  auto result = precompiledPipelines.find(recipe);
+  if (result == precompiledPipelines.end()) {
+    return nullptr;
   }
+  auto pipeline = std::move(result->second.pipeline);
+  precompiledPipelines.erase(result);
+  return pipeline;
 }
 
 std::shared_ptr<TextureProxy> GlobalCache::getGradient(const Color* colors, const float* positions,
@@ -18,12 +18,12 @@
 
 #pragma once
 
-#include <array>
+#include <chrono>
 #include <list>
 #include <optional>
 #include <unordered_map>
-#include "core/utils/SlidingWindowTracker.h"
 #include "gpu/Program.h"
+#include "gpu/StreamingBufferAllocator.h"
 #include "gpu/proxies/GPUBufferProxy.h"
 #include "gpu/proxies/TextureProxy.h"
 #include "tgfx/core/Color.h"
@@ -39,10 +39,20 @@ class GlobalCache {
 
   /**
    * Finds a program in the cache by its key. Returns nullptr if no program is found. The program
-   * will be kept alive for the lifetime of the GlobalCache.
+   * will be kept alive for the lifetime of the GlobalCache. Consecutive draws usually share the
+   * same pipeline, so the last program found is compared first to skip the hash map lookup.
    */
   std::shared_ptr<Program> findProgram(const BytesKey& programKey);
 
+  /**
+   * Returns a cleared key for building the program key of a draw. The key keeps its capacity
+   * between draws, so building it doesn't allocate.
+   */
+  BytesKey* getProgramKeyBuffer() {
+    programKeyBuffer.clear();
+    return &programKeyBuffer;
+  }
+
   /**
    * Find or creates a uniform GPUBuffer with specified size. If a suitable buffer already exists,
    * it will be reused. If no suitable buffer exists, a new buffer will be created.
@@ -53,18 +63,76 @@ class GlobalCache {
   std::shared_ptr<GPUBuffer> findOrCreateUniformBuffer(size_t bufferSize, size_t* lastBufferOffset);
 
   /**
-   * After calling Context::flush(), the cached buffer can be reused once the GPU has
-   * finished processing commands for the current frame.
-   * Typically, this is done at the start of each frame to allow buffer reuse.
-   * This approach minimizes buffer creation and destruction, improving performance.
+   * Allocates a region of the shared streaming vertex buffers for the current flush. Returns the
+   * GPU buffer holding the region and writes the offset of the region via the offset parameter.
+   * Returns nullptr if the buffer creation fails.
+   */
+  std::shared_ptr<GPUBuffer> allocateVertexBuffer(size_t bufferSize, size_t* offset);
+
+  /**
+   * After the commands of a flush are submitted, fences the streaming uniform and vertex buffers
+   * written for it and switches to the buffers of the next flush. The fenced buffers are reused
+   * once the GPU has finished processing the commands reading them. This approach minimizes buffer
+   * creation and destruction, improving performance.
+   */
+  void resetStreamingBuffers();
+
+  /**
+   * Returns the total size of the streaming and staging buffers held by the cache.
    */
-  void resetUniformBuffer();
+  size_t bufferMemoryUsage() const;
+
+  /**
+   * Takes an idle staging buffer of at least the specified size out of the pool, or creates a new
+   * one if none is available. A buffer is idle once the GPU has finished copying out of it. Returns
+   * nullptr if the GPU doesn't support staging buffers.
+   */
+  std::shared_ptr<GPUBuffer> acquireStagingBuffer(size_t size);
+
+  /**
+   * Returns a staging buffer taken by acquireStagingBuffer() to the pool after the copy out of it
+   * has been encoded, so it can be reused once the GPU has finished the copy.
+   */
+  void releaseStagingBuffer(std::shared_ptr<GPUBuffer> buffer);
 
   /**
    * Adds a program to the cache with the specified key. If a program with the same key already
-   * exists, it will be replaced with the new program.
+   * exists, it will be replaced with the new program. The recipe is the encoded PipelineRecipe of
+   * the program, which is exported by exportProgramRecipes().
+   */
+  void addProgram(const BytesKey& programKey, std::shared_ptr<Program> program,
+                  std::string recipe = {});
+
+  /**
+   * Returns the encoded pipeline recipes of all cached programs, from the most recently used to the
+   * least. Returns nullptr if there is no cached program.
    */
-  void addProgram(const BytesKey& programKey, std::shared_ptr<Program> program);
+  std::shared_ptr<Data> exportProgramRecipes() const;
+
+  /**
+   * Removes the least recently used programs until at most maxCount programs remain in the cache.
+   * The programs still referenced elsewhere are released once they are no longer used. The
+   * precompiled pipelines not taken yet count as programs and are removed first.
+   */
+  void purgePrograms(size_t maxCount);
+
+  /**
+   * Creates the pipelines of the program recipes returned by exportProgramRecipes() until the
+   * timeBudget runs out, and keeps them until the programs are created. At least one pipeline is
+   * created per call. Passing the same data again continues from where the last call stopped.
+   * The precompiled pipelines and the cached programs together never exceed the program count
+   * limit, and the pipelines not taken within PrecompiledPipelineLifetime are released. Returns
+   * true if all pipelines in the data have been processed, or false if some are left because the
+   * time budget ran out or the cache is full.
+   */
+  bool precompilePrograms(std::shared_ptr<Data> data,
+                          std::chrono::steady_clock::duration timeBudget);
+
+  /**
+   * Removes the precompiled pipeline of the specified encoded recipe from the cache and returns it.
+   * Returns nullptr if there is no such pipeline.
+   */
+  std::shared_ptr<RenderPipeline> takePrecompiledPipeline(const std::string& recipe);
 
   /**
    * Returns a texture that represents a gradient created from the specified colors and positions.
@@ -96,7 +164,17 @@ class GlobalCache {
    */
   void addStaticResource(const UniqueKey& uniqueKey, std::shared_ptr<Resource> resource);
 
+  /**
+   * How long a precompiled pipeline is kept if no program takes it.
+   */
+  static constexpr std::chrono::seconds PrecompiledPipelineLifetime = std::chrono::seconds(60);
+
  private:
+  struct PrecompiledPipeline {
+    std::shared_ptr<RenderPipeline> pipeline = nullptr;
+    std::chrono::steady_clock::time_point expirationTime = {};
+  };
+
   struct GradientTexture {
     GradientTexture(std::shared_ptr<TextureProxy> textureProxy, BytesKey gradientKey)
         : textureProxy(std::move(textureProxy)), gradientKey(std::move(gradientKey)) {
@@ -107,19 +185,24 @@ class GlobalCache {
     std::list<GradientTexture*>::iterator cachedPosition = {};
   };
 
-  struct UniformBufferPacket {
-    std::vector<std::shared_ptr<GPUBuffer>> gpuBuffers = {};
-    size_t bufferIndex = 0;
-    size_t cursor = 0;
-  };
-
   std::shared_ptr<GPUBufferProxy> getMiterStrokeIndexBuffer(bool antialias);
   std::shared_ptr<GPUBufferProxy> getBevelStrokeIndexBuffer(bool antialias);
   std::shared_ptr<GPUBufferProxy> getRoundStrokeIndexBuffer(bool antialias);
 
+  void removeProgram(Program* program);
+
+  void purgeExpiredPipelines();
+
   Context* context = nullptr;
   std::list<Program*> programLRU = {};
   BytesKeyMap<std::shared_ptr<Program>> programMap = {};
+  std::shared_ptr<Program> lastProgram = nullptr;
+  BytesKey programKeyBuffer = {};
+  std::shared_ptr<Data> precompileData = nullptr;
+  size_t precompileOffset = 0;
+  // The recipes of the cached programs, each mapped to the number of programs sharing it.
+  std::unordered_map<std::string, int> programRecipes = {};
+  std::unordered_map<std::string, PrecompiledPipeline> precompiledPipelines = {};
   std::list<GradientTexture*> gradientLRU = {};
   BytesKeyMap<std::unique_ptr<GradientTexture>> gradientTextures = {};
   std::shared_ptr<GPUBufferProxy> aaQuadIndexBuffer = nullptr;
@@ -134,11 +217,8 @@ class GlobalCache {
   std::shared_ptr<GPUBufferProxy> nonAARectRoundStrokeIndexBuffer = nullptr;
 
   ResourceKeyMap<std::shared_ptr<Resource>> staticResources = {};
-  // Triple buffering for uniform buffer management
-  static constexpr uint32_t UNIFORM_BUFFER_COUNT = 3;
-  std::array<UniformBufferPacket, UNIFORM_BUFFER_COUNT> tripleUniformBuffer = {};
-  uint32_t tripleUniformBufferIndex = 0;
-  uint64_t counter = 0;
-  SlidingWindowTracker maxUniformBufferTracker = {10};
+  std::unique_ptr<StreamingBufferAllocator> uniformBufferAllocator = nullptr;
+  std::unique_ptr<StreamingBufferAllocator> vertexBufferAllocator = nullptr;
+  std::list<std::shared_ptr<GPUBuffer>> stagingBuffers = {};
 };
 }  // namespace tgfx
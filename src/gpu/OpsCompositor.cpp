@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "OpsCompositor.h"
+#include "core/AtlasManager.h"
 #include "core/PathRasterizer.h"
 #include "core/PathRef.h"
 #include "core/PathTriangulator.h"
@@ -28,12 +29,15 @@
 #include "gpu/DrawingManager.h"
 #include "gpu/ProxyProvider.h"
 #include "gpu/ops/AtlasTextOp.h"
+#include "gpu/ops/RectDrawOp.h"
 #include "gpu/ops/ShapeDrawOp.h"
+#include "gpu/ops/StencilPathOp.h"
 #include "gpu/processors/AARectEffect.h"
 #include "gpu/processors/DeviceSpaceTextureEffect.h"
 #include "inspect/InspectorMark.h"
 #include "processors/ColorSpaceXFormEffect.h"
 #include "processors/PorterDuffXferProcessor.h"
+#include "tgfx/core/RenderFlags.h"
 
 namespace tgfx {
 /**
@@ -43,6 +47,10 @@ namespace tgfx {
  * 0.5 * 1/256 of its intended value, it shouldn't affect the final pixel values.
  */
 static constexpr float BOUNDS_TOLERANCE = 1e-3f;
+// The max width or height in pixels of a path drawn from the coverage atlas.
+static constexpr float MAX_ATLAS_PATH_SIZE = 128.0f;
+// The number of subpixel positions per pixel that a path in the coverage atlas is rasterized at.
+static constexpr float ATLAS_PATH_SUBPIXEL_COUNT = 4.0f;
 
 static bool HasDifferentViewMatrix(const std::vector<PlacementPtr<RectRecord>>& rects) {
   if (rects.size() <= 1) {
@@ -166,11 +174,17 @@ static Rect ClipLocalBounds(const Rect& localBounds, const Matrix& viewMatrix,
 void OpsCompositor::drawShape(std::shared_ptr<Shape> shape, const MCState& state,
                               const Brush& brush) {
   DEBUG_ASSERT(shape != nullptr);
+  if (drawAsAtlasPath(shape, state, brush)) {
+    return;
+  }
   flushPendingOps();
   Matrix uvMatrix = {};
   if (!state.matrix.invert(&uvMatrix)) {
     return;
   }
+  if (drawAsStencilPath(shape, state, brush)) {
+    return;
+  }
   std::optional<Rect> localBounds = std::nullopt;
   std::optional<Rect> deviceBounds = std::nullopt;
   float drawScale = 1.0f;
@@ -203,6 +217,166 @@ void OpsCompositor::drawShape(std::shared_ptr<Shape> shape, const MCState& state
   addDrawOp(std::move(drawOp), clip, brush, localBounds, deviceBounds, drawScale);
 }
 
+bool OpsCompositor::drawAsStencilPath(const std::shared_ptr<Shape>& shape, const MCState& state,
+                                      const Brush& brush) {
+  // The stencil buffer can't hold partial coverage, so the path is only antialiased with MSAA.
+  if (getAAType(brush) == AAType::Coverage || !shape->isSimplePath() ||
+      shape->isInverseFillType()) {
+    return false;
+  }
+  // A simple path shape holds its path, so getting it doesn't compute anything.
+  auto path = shape->getPath();
+  if (!PathTriangulator::ShouldStencilPath(path, state.matrix)) {
+    return false;
+  }
+  auto shapeBounds = path.getBounds();
+  auto stencilOp = StencilPathOp::Make(context, Shape::ApplyMatrix(shape, state.matrix),
+                                       path.getFillType(), renderFlags);
+  if (stencilOp == nullptr) {
+    return false;
+  }
+  std::optional<Rect> localBounds = std::nullopt;
+  std::optional<Rect> deviceBounds = std::nullopt;
+  float drawScale = 1.0f;
+  auto [needLocalBounds, needDeviceBounds] = needComputeBounds(brush, true);
+  if (needLocalBounds) {
+    localBounds = ClipLocalBounds(shapeBounds, state.matrix, getClipBounds(state.clip));
+    drawScale = std::min(state.matrix.getMaxScale(), 1.0f);
+  }
+  if (needDeviceBounds) {
+    deviceBounds = state.matrix.mapRect(shapeBounds);
+  }
+  std::vector<PlacementPtr<RectRecord>> rects = {};
+  rects.push_back(drawingAllocator()->make<RectRecord>(shapeBounds, state.matrix, brush.color));
+  auto provider =
+      RectsVertexProvider::MakeFrom(drawingAllocator(), std::move(rects), {}, AAType::None, false,
+                                    UVSubsetMode::None, {}, dstColorSpace);
+  auto coverOp = RectDrawOp::Make(context, std::move(provider), renderFlags);
+  if (coverOp == nullptr) {
+    return false;
+  }
+  coverOp->setDepthStencil(StencilPathOp::CoverStencil());
+  auto opCount = drawOps.size();
+  addDrawOp(std::move(coverOp), state.clip, brush, localBounds, deviceBounds, drawScale);
+  if (drawOps.size() > opCount) {
+    // The cover op resets the stencil values only within its scissor rect, so the stencil op must
+    // not write outside of it.
+    stencilOp->setScissorRect(drawOps.back()->getScissorRect());
+    drawOps.insert(drawOps.end() - 1, std::move(stencilOp));
+  }
+  return true;
+}
+
+bool OpsCompositor::drawAsAtlasPath(const std::shared_ptr<Shape>& shape, const MCState& state,
+                                    const Brush& brush) {
+  if ((renderFlags & RenderFlags::DisableCache) || shape->isInverseFillType()) {
+    return false;
+  }
+  auto& viewMatrix = state.matrix;
+  if (viewMatrix.rectStaysRect()) {
+    // The bounds of the shape are cached, while the raster shape below computes its bounds from
+    // scratch. Mapping them is exact here, so large shapes are rejected without that cost.
+    auto deviceBounds = viewMatrix.mapRect(shape->getBounds());
+    if (deviceBounds.width() > MAX_ATLAS_PATH_SIZE || deviceBounds.height() > MAX_ATLAS_PATH_SIZE) {
+      return false;
+    }
+  }
+  // Snap the translation to subpixel positions, so that every draw of the same path at the same
+  // scale shares one of a few cells in the atlas, and the integer part moves the cell on screen.
+  auto translateX =
+      roundf(viewMatrix.getTranslateX() * ATLAS_PATH_SUBPIXEL_COUNT) / ATLAS_PATH_SUBPIXEL_COUNT;
+  auto translateY =
+      roundf(viewMatrix.getTranslateY() * ATLAS_PATH_SUBPIXEL_COUNT) / ATLAS_PATH_SUBPIXEL_COUNT;
+  auto offsetX = floorf(translateX);
+  auto offsetY = floorf(translateY);
+  auto rasterMatrix = viewMatrix;
+  rasterMatrix.setTranslateX(translateX - offsetX);
+  rasterMatrix.setTranslateY(translateY - offsetY);
+  auto rasterShape = Shape::ApplyMatrix(shape, rasterMatrix);
+  if (rasterShape == nullptr) {
+    return false;
+  }
+  Path hairlinePath = {};
+  auto cap = LineCap::Butt;
+  if (ShapeUtils::GetHairlinePath(rasterShape, &hairlinePath, &cap)) {
+    return false;
+  }
+  auto antiAlias = getAAType(brush) != AAType::None;
+  auto bounds = rasterShape->getBounds();
+  if (antiAlias) {
+    bounds.outset(1.0f, 1.0f);
+  }
+  bounds.roundOut();
+  if (bounds.isEmpty() || bounds.width() > MAX_ATLAS_PATH_SIZE ||
+      bounds.height() > MAX_ATLAS_PATH_SIZE) {
+    return false;
+  }
+  static const auto PathAtlasType = UniqueID::Next();
+  BytesKey pathKey = {};
+  pathKey.write(PathAtlasType);
+  shape->getUniqueKey().writeTo(&pathKey);
+  pathKey.write(rasterMatrix.getScaleX());
+  pathKey.write(rasterMatrix.getSkewX());
+  pathKey.write(rasterMatrix.getSkewY());
+  pathKey.write(rasterMatrix.getScaleY());
+  pathKey.write(rasterMatrix.getTranslateX());
+  pathKey.write(rasterMatrix.getTranslateY());
+  pathKey.write(static_cast<uint32_t>(antiAlias));
+
+  auto atlasManager = context->atlasManager();
+  auto& textureProxies = atlasManager->getTextureProxies(MaskFormat::A8);
+  auto nextFlushToken = atlasManager->nextFlushToken();
+  AtlasCellLocator cellLocator;
+  auto& atlasLocator = cellLocator.atlasLocator;
+  if (!atlasManager->getCellLocator(MaskFormat::A8, pathKey, cellLocator)) {
+    // Convex paths are drawn as a triangle fan, and the triangulated paths as triangles, both of
+    // which are cheaper than rasterizing them into the atlas.
+    auto path = rasterShape->getPath();
+    if (path.isConvex() || PathTriangulator::ShouldTriangulatePath(path)) {
+      return false;
+    }
+    auto width = static_cast<int>(bounds.width());
+    auto height = static_cast<int>(bounds.height());
+    auto rasterizeMatrix = Matrix::MakeTrans(-bounds.left, -bounds.top);
+    auto rasterizer =
+        PathRasterizer::MakeFrom(width, height, std::move(path), antiAlias, &rasterizeMatrix);
+    if (rasterizer == nullptr) {
+      return false;
+    }
+    AtlasCell cell;
+    cell.key = std::move(pathKey);
+    cell.offset = Point::Make(bounds.left, bounds.top);
+    cell.maskFormat = MaskFormat::A8;
+    cell.width = static_cast<uint16_t>(width);
+    cell.height = static_cast<uint16_t>(height);
+    if (!atlasManager->addCellToAtlas(cell, nextFlushToken, atlasLocator)) {
+      return false;
+    }
+    cellLocator.offset = cell.offset;
+    auto& location = atlasLocator.getLocation();
+    auto plot = atlasManager->getPlot(MaskFormat::A8, atlasLocator.plotLocator());
+    context->drawingManager()->addAtlasCellTask(textureProxies[atlasLocator.pageIndex()], plot,
+                                                Point::Make(location.left, location.top),
+                                                std::move(rasterizer));
+  }
+  PlotUseUpdater plotUseUpdater;
+  atlasManager->setPlotUseToken(plotUseUpdater, atlasLocator.plotLocator(), MaskFormat::A8,
+                                nextFlushToken);
+  auto textureProxy = textureProxies[atlasLocator.pageIndex()];
+  if (textureProxy == nullptr) {
+    return false;
+  }
+  auto& location = atlasLocator.getLocation();
+  auto cellState = state;
+  cellState.matrix = Matrix::MakeTrans(offsetX + cellLocator.offset.x - location.left,
+                                       offsetY + cellLocator.offset.y - location.top);
+  // The atlas op reads the brush in device space, like the glyphs drawn from the same atlas.
+  auto cellBrush = brush.makeWithMatrix(viewMatrix);
+  fillTextAtlas(std::move(textureProxy), location,
+                SamplingOptions(FilterMode::Nearest, MipmapMode::None), cellState, cellBrush);
+  return true;
+}
+
 void OpsCompositor::discardAll() {
   drawOps.clear();
   clearColor.reset();
@@ -224,6 +398,7 @@ void OpsCompositor::resetPendingOps(PendingOpType type, Path clip, Brush brush)
   pendingRRects.clear();
   pendingStrokes.clear();
   pendingAtlasTexture = nullptr;
+  pendingDistanceField = false;
 }
 
 bool OpsCompositor::CompareBrush(const Brush& a, const Brush& b) {
@@ -398,7 +573,8 @@ void OpsCompositor::flushPendingOps(PendingOpType type, Path clip, Brush brush)
           RectsVertexProvider::MakeFrom(drawingAllocator(), std::move(pendingRects), {},
                                         AAType::None, true, UVSubsetMode::None, {}, dstColorSpace);
       drawOp = AtlasTextOp::Make(context, std::move(provider), renderFlags,
-                                 std::move(pendingAtlasTexture), pendingSampling);
+                                 std::move(pendingAtlasTexture), pendingSampling,
+                                 pendingDistanceField);
     } break;
     default:
       break;
@@ -717,14 +893,15 @@ void OpsCompositor::addDrawOp(PlacementPtr<DrawOp> op, const Path& clip, const B
 
 void OpsCompositor::fillTextAtlas(std::shared_ptr<TextureProxy> textureProxy, const Rect& rect,
                                   const SamplingOptions& sampling, const MCState& state,
-                                  const Brush& brush) {
+                                  const Brush& brush, bool distanceField) {
   DEBUG_ASSERT(textureProxy != nullptr);
   DEBUG_ASSERT(!rect.isEmpty());
   if (!canAppend(PendingOpType::Atlas, state.clip, brush) || pendingAtlasTexture != textureProxy ||
-      pendingSampling != sampling) {
+      pendingSampling != sampling || pendingDistanceField != distanceField) {
     flushPendingOps(PendingOpType::Atlas, state.clip, brush);
     pendingAtlasTexture = std::move(textureProxy);
     pendingSampling = sampling;
+    pendingDistanceField = distanceField;
   }
   auto record = drawingAllocator()->make<RectRecord>(rect, state.matrix, brush.color);
   pendingRects.emplace_back(std::move(record));
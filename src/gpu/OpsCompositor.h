@@ -78,10 +78,12 @@ class OpsCompositor {
   void drawShape(std::shared_ptr<Shape> shape, const MCState& state, const Brush& brush);
 
   /**
-   * Fills the given rect with the given atlas textureProxy, sampling options, state and fill.
+   * Fills the given rect with the given atlas textureProxy, sampling options, state and fill. If
+   * distanceField is true, the atlas stores signed distance fields instead of coverage masks.
    */
   void fillTextAtlas(std::shared_ptr<TextureProxy> textureProxy, const Rect& rect,
-                     const SamplingOptions& sampling, const MCState& state, const Brush& brush);
+                     const SamplingOptions& sampling, const MCState& state, const Brush& brush,
+                     bool distanceField = false);
 
   /**
    * Discard all pending operations.
@@ -116,6 +118,7 @@ class OpsCompositor {
   SrcRectConstraint pendingConstraint = SrcRectConstraint::Fast;
   SamplingOptions pendingSampling = {};
   std::shared_ptr<TextureProxy> pendingAtlasTexture = nullptr;
+  bool pendingDistanceField = false;
   std::vector<PlacementPtr<RectRecord>> pendingRects = {};
   std::vector<PlacementPtr<Rect>> pendingUVRects = {};
   std::vector<PlacementPtr<RRectRecord>> pendingRRects = {};
@@ -135,6 +138,10 @@ class OpsCompositor {
   }
 
   bool drawAsClear(const Rect& rect, const MCState& state, const Brush& brush);
+  bool drawAsStencilPath(const std::shared_ptr<Shape>& shape, const MCState& state,
+                         const Brush& brush);
+  bool drawAsAtlasPath(const std::shared_ptr<Shape>& shape, const MCState& state,
+                       const Brush& brush);
   bool canAppend(PendingOpType type, const Path& clip, const Brush& brush) const;
   void flushPendingOps(PendingOpType currentType = PendingOpType::Unknown, Path currentClip = {},
                        Brush currentBrush = {});
@@ -0,0 +1,270 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "PipelineRecipe.h"
+#include <cstring>
+#include "tgfx/gpu/GPU.h"
+#include "tgfx/gpu/ProgramBinaryStore.h"
+
+namespace tgfx {
+static void WriteUint32(std::string* bytes, uint32_t value) {
+  bytes->append(reinterpret_cast<const char*>(&value), sizeof(uint32_t));
+}
+
+template <typename T>
+static void WriteEnum(std::string* bytes, T value) {
+  WriteUint32(bytes, static_cast<uint32_t>(value));
+}
+
+static void WriteString(std::string* bytes, const std::string& value) {
+  WriteUint32(bytes, static_cast<uint32_t>(value.size()));
+  bytes->append(value);
+}
+
+static void WriteStencil(std::string* bytes, const StencilDescriptor& stencil) {
+  WriteEnum(bytes, stencil.compare);
+  WriteEnum(bytes, stencil.depthFailOp);
+  WriteEnum(bytes, stencil.failOp);
+  WriteEnum(bytes, stencil.passOp);
+}
+
+static void WriteBindings(std::string* bytes, const std::vector<BindingEntry>& entries) {
+  WriteUint32(bytes, static_cast<uint32_t>(entries.size()));
+  for (auto& entry : entries) {
+    WriteString(bytes, entry.name);
+    WriteUint32(bytes, entry.binding);
+  }
+}
+
+class RecipeReader {
+ public:
+  RecipeReader(const uint8_t* bytes, size_t length) : bytes(bytes), length(length) {
+  }
+
+  bool atEnd() const {
+    return offset == length;
+  }
+
+  bool readUint32(uint32_t* value) {
+    if (length - offset < sizeof(uint32_t)) {
+      return false;
+    }
+    memcpy(value, bytes + offset, sizeof(uint32_t));
+    offset += sizeof(uint32_t);
+    return true;
+  }
+
+  template <typename T>
+  bool readEnum(T* value) {
+    uint32_t result = 0;
+    if (!readUint32(&result)) {
+      return false;
+    }
+    *value = static_cast<T>(result);
+    return true;
+  }
+
+  bool readBool(bool* value) {
+    uint32_t result = 0;
+    if (!readUint32(&result)) {
+      return false;
+    }
+    *value = result != 0;
+    return true;
+  }
+
+  bool readString(std::string* value) {
+    uint32_t size = 0;
+    if (!readUint32(&size) || length - offset < size) {
+      return false;
+    }
+    value->assign(reinterpret_cast<const char*>(bytes + offset), size);
+    offset += size;
+    return true;
+  }
+
+  bool readStencil(StencilDescriptor* stencil) {
+    return readEnum(&stencil->compare) && readEnum(&stencil->depthFailOp) &&
+           readEnum(&stencil->failOp) && readEnum(&stencil->passOp);
+  }
+
+  bool readBindings(std::vector<BindingEntry>* entries) {
+    uint32_t count = 0;
+    if (!readUint32(&count)) {
+      return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+      std::string name = {};
+      uint32_t binding = 0;
+      if (!readString(&name) || !readUint32(&binding)) {
+        return false;
+      }
+      entries->emplace_back(std::move(name), binding);
+    }
+    return true;
+  }
+
+ private:
+  const uint8_t* bytes = nullptr;
+  size_t length = 0;
+  size_t offset = 0;
+};
+
+bool PipelineRecipe::Decode(const uint8_t* bytes, size_t length, PipelineRecipe* recipe) {
+  RecipeReader reader(bytes, length);
+  if (!reader.readString(&recipe->vertexCode) || !reader.readString(&recipe->fragmentCode)) {
+    return false;
+  }
+  auto& descriptor = recipe->descriptor;
+  uint32_t count = 0;
+  if (!reader.readUint32(&count)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    std::string name = {};
+    VertexFormat format = VertexFormat::Float;
+    if (!reader.readString(&name) || !reader.readEnum(&format)) {
+      return false;
+    }
+    descriptor.vertex.attributes.emplace_back(std::move(name), format);
+  }
+  uint32_t vertexStride = 0;
+  if (!reader.readUint32(&vertexStride) || !reader.readUint32(&count)) {
+    return false;
+  }
+  descriptor.vertex.vertexStride = vertexStride;
+  for (uint32_t i = 0; i < count; i++) {
+    PipelineColorAttachment attachment = {};
+    if (!reader.readEnum(&attachment.format) || !reader.readBool(&attachment.blendEnable) ||
+        !reader.readEnum(&attachment.srcColorBlendFactor) ||
+        !reader.readEnum(&attachment.dstColorBlendFactor) ||
+        !reader.readEnum(&attachment.colorBlendOp) ||
+        !reader.readEnum(&attachment.srcAlphaBlendFactor) ||
+        !reader.readEnum(&attachment.dstAlphaBlendFactor) ||
+        !reader.readEnum(&attachment.alphaBlendOp) ||
+        !reader.readUint32(&attachment.colorWriteMask)) {
+      return false;
+    }
+    descriptor.fragment.colorAttachments.push_back(attachment);
+  }
+  auto& depthStencil = descriptor.depthStencil;
+  return reader.readBindings(&descriptor.layout.uniformBlocks) &&
+         reader.readBindings(&descriptor.layout.textureSamplers) &&
+         reader.readEnum(&depthStencil.depthCompare) &&
+         reader.readBool(&depthStencil.depthWriteEnabled) &&
+         reader.readStencil(&depthStencil.stencilBack) &&
+         reader.readStencil(&depthStencil.stencilFront) &&
+         reader.readUint32(&depthStencil.stencilReadMask) &&
+         reader.readUint32(&depthStencil.stencilWriteMask) &&
+         reader.readEnum(&descriptor.primitive.cullMode) &&
+         reader.readEnum(&descriptor.primitive.frontFace) && reader.atEnd();
+}
+
+std::string PipelineRecipe::encode() const {
+  std::string bytes = {};
+  bytes.reserve(vertexCode.size() + fragmentCode.size() + 256);
+  WriteString(&bytes, vertexCode);
+  WriteString(&bytes, fragmentCode);
+  WriteUint32(&bytes, static_cast<uint32_t>(descriptor.vertex.attributes.size()));
+  for (auto& attribute : descriptor.vertex.attributes) {
+    WriteString(&bytes, attribute.name());
+    WriteEnum(&bytes, attribute.format());
+  }
+  WriteUint32(&bytes, static_cast<uint32_t>(descriptor.vertex.vertexStride));
+  WriteUint32(&bytes, static_cast<uint32_t>(descriptor.fragment.colorAttachments.size()));
+  for (auto& attachment : descriptor.fragment.colorAttachments) {
+    WriteEnum(&bytes, attachment.format);
+    WriteUint32(&bytes, attachment.blendEnable ? 1 : 0);
+    WriteEnum(&bytes, attachment.srcColorBlendFactor);
+    WriteEnum(&bytes, attachment.dstColorBlendFactor);
+    WriteEnum(&bytes, attachment.colorBlendOp);
+    WriteEnum(&bytes, attachment.srcAlphaBlendFactor);
+    WriteEnum(&bytes, attachment.dstAlphaBlendFactor);
+    WriteEnum(&bytes, attachment.alphaBlendOp);
+    WriteUint32(&bytes, attachment.colorWriteMask);
+  }
+  WriteBindings(&bytes, descriptor.layout.uniformBlocks);
+  WriteBindings(&bytes, descriptor.layout.textureSamplers);
+  auto& depthStencil = descriptor.depthStencil;
+  WriteEnum(&bytes, depthStencil.depthCompare);
+  WriteUint32(&bytes, depthStencil.depthWriteEnabled ? 1 : 0);
+  WriteStencil(&bytes, depthStencil.stencilBack);
+  WriteStencil(&bytes, depthStencil.stencilFront);
+  WriteUint32(&bytes, depthStencil.stencilReadMask);
+  WriteUint32(&bytes, depthStencil.stencilWriteMask);
+  WriteEnum(&bytes, descriptor.primitive.cullMode);
+  WriteEnum(&bytes, descriptor.primitive.frontFace);
+  return bytes;
+}
+
+static std::shared_ptr<Data> MakeProgramBinaryKey(const GPU* gpu, const std::string& vertexCode,
+                                                  const std::string& fragmentCode) {
+  // A binary can only be loaded by the same driver that produced it, so the driver strings are
+  // part of the key along with the shader code.
+  auto info = gpu->info();
+  std::string key = {};
+  key.reserve(info->vendor.size() + info->renderer.size() + info->version.size() +
+              vertexCode.size() + fragmentCode.size() + 5);
+  for (auto part : {&info->vendor, &info->renderer, &info->version, &vertexCode, &fragmentCode}) {
+    key += *part;
+    key += '\0';
+  }
+  return Data::MakeWithCopy(key.data(), key.size());
+}
+
+std::shared_ptr<RenderPipeline> PipelineRecipe::makePipeline(Context* context) const {
+  auto gpu = context->gpu();
+  auto pipelineDescriptor = descriptor;
+  std::shared_ptr<RenderPipeline> pipeline = nullptr;
+  auto binaryStore = context->programBinaryStore();
+  std::shared_ptr<Data> binaryKey = nullptr;
+  if (binaryStore != nullptr) {
+    binaryKey = MakeProgramBinaryKey(gpu, vertexCode, fragmentCode);
+    pipelineDescriptor.binary = binaryStore->load(*binaryKey);
+    if (pipelineDescriptor.binary != nullptr) {
+      pipeline = gpu->createRenderPipeline(pipelineDescriptor);
+      pipelineDescriptor.binary = nullptr;
+    }
+  }
+  if (pipeline != nullptr) {
+    return pipeline;
+  }
+  ShaderModuleDescriptor vertexModule = {};
+  vertexModule.code = vertexCode;
+  vertexModule.stage = ShaderStage::Vertex;
+  pipelineDescriptor.vertex.module = gpu->createShaderModule(vertexModule);
+  if (pipelineDescriptor.vertex.module == nullptr) {
+    return nullptr;
+  }
+  ShaderModuleDescriptor fragmentModule = {};
+  fragmentModule.code = fragmentCode;
+  fragmentModule.stage = ShaderStage::Fragment;
+  pipelineDescriptor.fragment.module = gpu->createShaderModule(fragmentModule);
+  if (pipelineDescriptor.fragment.module == nullptr) {
+    return nullptr;
+  }
+  pipeline = gpu->createRenderPipeline(pipelineDescriptor);
+  if (pipeline != nullptr && binaryKey != nullptr) {
+    auto binary = gpu->getPipelineBinary(pipeline.get());
+    if (binary != nullptr) {
+      binaryStore->save(*binaryKey, std::move(binary));
+    }
+  }
+  return pipeline;
+}
+}  // namespace tgfx
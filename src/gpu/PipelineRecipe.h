@@ -0,0 +1,59 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <string>
+#include "tgfx/gpu/Context.h"
+#include "tgfx/gpu/RenderPipeline.h"
+
+namespace tgfx {
+/**
+ * PipelineRecipe holds everything needed to create the RenderPipeline of a program: the generated
+ * shader code and the pipeline descriptor. Unlike the program keys, which depend on the processor
+ * class IDs assigned at runtime, the encoded recipe stays the same across processes, so it can be
+ * recorded in one run and used to precompile the program in another.
+ */
+class PipelineRecipe {
+ public:
+  /**
+   * Decodes a recipe from the bytes returned by encode(). Returns false if the bytes are malformed.
+   */
+  static bool Decode(const uint8_t* bytes, size_t length, PipelineRecipe* recipe);
+
+  std::string vertexCode = {};
+  std::string fragmentCode = {};
+
+  /**
+   * The descriptor of the pipeline. The shader modules and the binary are not part of the recipe.
+   */
+  RenderPipelineDescriptor descriptor = {};
+
+  /**
+   * Encodes the recipe into bytes, which also serve as the key to identify the pipeline.
+   */
+  std::string encode() const;
+
+  /**
+   * Creates the pipeline described by the recipe. The binary is loaded from the ProgramBinaryStore
+   * of the context if possible, otherwise the shader code is compiled and the linked binary is
+   * saved to the store. Returns nullptr if the pipeline can't be created.
+   */
+  std::shared_ptr<RenderPipeline> makePipeline(Context* context) const;
+};
+}  // namespace tgfx
@@ -26,6 +26,11 @@ Program::Program(std::shared_ptr<RenderPipeline> pipeline,
       fragmentUniformData(std::move(fragmentUniformData)) {
 }
 
+const std::string& Program::getRecipe() const {
+  static const std::string EmptyRecipe = {};
+  return recipe ? *recipe : EmptyRecipe;
+}
+
 UniformData* Program::getUniformData(ShaderStage stage) const {
   if (stage == ShaderStage::Vertex) {
     return vertexUniformData.get();
@@ -19,6 +19,7 @@
 #pragma once
 
 #include <list>
+#include <string>
 #include "gpu/UniformData.h"
 #include "tgfx/core/BytesKey.h"
 #include "tgfx/gpu/RenderPipeline.h"
@@ -36,12 +37,20 @@ class Program {
 
   UniformData* getUniformData(ShaderStage stage) const;
 
+  /**
+   * Returns the encoded PipelineRecipe of the program, which is used to precompile the program in
+   * another process. Returns an empty string if the program is not cached by the GlobalCache.
+   */
+  const std::string& getRecipe() const;
+
  private:
   BytesKey programKey = {};
   std::list<Program*>::iterator cachedPosition;
   std::shared_ptr<RenderPipeline> pipeline = nullptr;
   std::unique_ptr<UniformData> vertexUniformData = nullptr;
   std::unique_ptr<UniformData> fragmentUniformData = nullptr;
+  // Points to the key of the recipe in GlobalCache, which keeps every recipe only once.
+  const std::string* recipe = nullptr;
 
   friend class GlobalCache;
 };
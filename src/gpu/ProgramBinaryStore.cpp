@@ -0,0 +1,261 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "tgfx/gpu/ProgramBinaryStore.h"
+#include <cstdio>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include "core/utils/Log.h"
+#include "tgfx/core/Task.h"
+#include "tgfx/core/WriteStream.h"
+
+namespace tgfx {
+static constexpr char INDEX_FILE_NAME[] = "index";
+
+static std::string MakeFileName(const Data& key) {
+  // The 64-bit FNV-1a hash of the key. Collisions are detected by the full key stored in the file.
+  uint64_t hash = 14695981039346656037ull;
+  auto bytes = key.bytes();
+  for (size_t i = 0; i < key.size(); i++) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  char name[17] = {};
+  snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(hash));
+  return name;
+}
+
+static bool IsFileOfKey(const Data& data, const Data& key) {
+  auto headerSize = sizeof(uint32_t) + key.size();
+  if (data.size() <= headerSize) {
+    return false;
+  }
+  uint32_t keySize = 0;
+  memcpy(&keySize, data.bytes(), sizeof(uint32_t));
+  return keySize == key.size() &&
+         memcmp(data.bytes() + sizeof(uint32_t), key.bytes(), key.size()) == 0;
+}
+
+/**
+ * FileProgramBinaryStore saves each binary as a file named by the hash of its key, prefixed with
+ * the size and the content of the key. The recently used order of the files is kept in an index
+ * file, so the least recently used ones can be removed across processes. The index file is
+ * rewritten on a background task, which covers all the binaries saved before it runs.
+ */
+class FileProgramBinaryStore : public ProgramBinaryStore {
+ public:
+  FileProgramBinaryStore(std::string directory, size_t maxBytes)
+      : directory(std::move(directory)), maxBytes(maxBytes) {
+    loadIndex();
+  }
+
+  ~FileProgramBinaryStore() override {
+    if (indexTask != nullptr) {
+      indexTask->wait();
+    }
+    // An older task may still be writing the index if a newer one was scheduled meanwhile.
+    std::lock_guard<std::mutex> indexLock(indexLocker);
+    if (indexChanged) {
+      writeIndex(makeIndexContent());
+    }
+  }
+
+  std::shared_ptr<Data> load(const Data& key) override {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto name = MakeFileName(key);
+    auto result = entryMap.find(name);
+    if (result == entryMap.end()) {
+      return nullptr;
+    }
+    auto data = Data::MakeFromFile(getFilePath(name));
+    if (data == nullptr || !IsFileOfKey(*data, key)) {
+      // The file is missing, broken, or belongs to another key with the same hash.
+      removeEntry(result->second);
+      indexChanged = true;
+      return nullptr;
+    }
+    entries.splice(entries.begin(), entries, result->second);
+    indexChanged = true;
+    auto headerSize = sizeof(uint32_t) + key.size();
+    return Data::MakeWithCopy(data->bytes() + headerSize, data->size() - headerSize);
+  }
+
+  void save(const Data& key, std::shared_ptr<Data> binary) override {
+    if (binary == nullptr || binary->empty()) {
+      return;
+    }
+    if (saveBinary(key, *binary)) {
+      // Task::Run() executes the task on the current thread if no worker thread is available, so
+      // it must be called outside the locker.
+      scheduleIndexSaving();
+    }
+  }
+
+ private:
+  struct Entry {
+    std::string name;
+    size_t size = 0;
+  };
+
+  std::mutex locker = {};
+  std::string directory;
+  size_t maxBytes = 0;
+  size_t totalBytes = 0;
+  std::list<Entry> entries = {};
+  std::unordered_map<std::string, std::list<Entry>::iterator> entryMap = {};
+  bool indexChanged = false;
+  bool indexSavingScheduled = false;
+  // Serializes the scheduling of the index tasks, so indexTask always holds the newest one.
+  std::mutex taskLocker = {};
+  std::shared_ptr<Task> indexTask = nullptr;
+  // Serializes the tasks writing the index, as a new one may start before the last one is done.
+  std::mutex indexLocker = {};
+
+  /**
+   * Writes the binary file and adds it to the entries. Returns true if the index saving needs to
+   * be scheduled.
+   */
+  bool saveBinary(const Data& key, const Data& binary) {
+    std::lock_guard<std::mutex> autoLock(locker);
+    auto name = MakeFileName(key);
+    auto result = entryMap.find(name);
+    if (result != entryMap.end()) {
+      removeEntry(result->second);
+    }
+    auto stream = WriteStream::MakeFromFile(getFilePath(name));
+    if (stream == nullptr) {
+      LOGE("FileProgramBinaryStore::save() Failed to create the file in '%s'!", directory.c_str());
+      return false;
+    }
+    auto keySize = static_cast<uint32_t>(key.size());
+    if (!stream->write(&keySize, sizeof(uint32_t)) || !stream->write(key.data(), key.size()) ||
+        !stream->write(binary.data(), binary.size())) {
+      stream = nullptr;
+      std::remove(getFilePath(name).c_str());
+      return false;
+    }
+    stream = nullptr;
+    auto size = sizeof(uint32_t) + key.size() + binary.size();
+    entries.push_front({name, size});
+    entryMap[name] = entries.begin();
+    totalBytes += size;
+    while (totalBytes > maxBytes && entries.size() > 1) {
+      auto& entry = entries.back();
+      std::remove(getFilePath(entry.name).c_str());
+      removeEntry(--entries.end());
+    }
+    indexChanged = true;
+    if (indexSavingScheduled) {
+      return false;
+    }
+    indexSavingScheduled = true;
+    return true;
+  }
+
+  std::string getFilePath(const std::string& name) const {
+    return directory + "/" + name;
+  }
+
+  void removeEntry(std::list<Entry>::iterator position) {
+    totalBytes -= position->size;
+    entryMap.erase(position->name);
+    entries.erase(position);
+  }
+
+  void loadIndex() {
+    auto data = Data::MakeFromFile(getFilePath(INDEX_FILE_NAME));
+    if (data == nullptr) {
+      return;
+    }
+    // Each line holds the name and the size of a file, from the most recently used to the least.
+    std::string content(reinterpret_cast<const char*>(data->bytes()), data->size());
+    size_t start = 0;
+    while (start < content.size()) {
+      auto end = content.find('\n', start);
+      if (end == std::string::npos) {
+        end = content.size();
+      }
+      auto line = content.substr(start, end - start);
+      start = end + 1;
+      auto space = line.find(' ');
+      if (space == std::string::npos) {
+        continue;
+      }
+      auto name = line.substr(0, space);
+      auto size = static_cast<size_t>(strtoull(line.c_str() + space + 1, nullptr, 10));
+      if (name.empty() || size == 0 || entryMap.count(name) > 0) {
+        continue;
+      }
+      entries.push_back({name, size});
+      entryMap[name] = --entries.end();
+      totalBytes += size;
+    }
+  }
+
+  // Must be called without the locker held.
+  void scheduleIndexSaving() {
+    std::lock_guard<std::mutex> taskLock(taskLocker);
+    indexTask = Task::Run(
+        [this] {
+          // Holds the indexLocker while taking the content, so that a newer index is never
+          // overwritten by an older one.
+          std::lock_guard<std::mutex> indexLock(indexLocker);
+          std::string content = {};
+          {
+            std::lock_guard<std::mutex> autoLock(locker);
+            indexSavingScheduled = false;
+            content = makeIndexContent();
+          }
+          writeIndex(content);
+        },
+        TaskPriority::Low);
+  }
+
+  // Must be called with the locker held.
+  std::string makeIndexContent() {
+    std::string content = {};
+    for (auto& entry : entries) {
+      content += entry.name + " " + std::to_string(entry.size) + "\n";
+    }
+    indexChanged = false;
+    return content;
+  }
+
+  void writeIndex(const std::string& content) {
+    auto stream = WriteStream::MakeFromFile(getFilePath(INDEX_FILE_NAME));
+    if (stream == nullptr) {
+      return;
+    }
+    stream->write(content.data(), content.size());
+  }
+};
+
+std::shared_ptr<ProgramBinaryStore> ProgramBinaryStore::MakeFrom(const std::string& directory,
+                                                                 size_t maxBytes) {
+  if (directory.empty()) {
+    return nullptr;
+  }
+  auto path = directory;
+  if (path.back() == '/' || path.back() == '\\') {
+    path.pop_back();
+  }
+  return std::make_shared<FileProgramBinaryStore>(std::move(path), maxBytes);
+}
+}  // namespace tgfx
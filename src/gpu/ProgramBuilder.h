@@ -29,9 +29,10 @@ namespace tgfx {
 class ProgramBuilder {
  public:
   /**
-   * Generates a shader program.
+   * Generates a shader program and writes its encoded PipelineRecipe to the recipe parameter.
    */
-  static std::shared_ptr<Program> CreateProgram(Context* context, const ProgramInfo* programInfo);
+  static std::shared_ptr<Program> CreateProgram(Context* context, const ProgramInfo* programInfo,
+                                                std::string* recipe);
 
   virtual ~ProgramBuilder() = default;
 
@@ -53,6 +54,12 @@ class ProgramBuilder {
    */
   std::string nameVariable(const std::string& name) const;
 
+  /**
+   * Returns the index of the processor currently emitting code in the program, or -1 if no
+   * processor is emitting code.
+   */
+  int currentProcessorIndex() const;
+
   virtual UniformHandler* uniformHandler() = 0;
 
   virtual const UniformHandler* uniformHandler() const = 0;
@@ -63,6 +63,7 @@ Swizzle ProgramInfo::getOutputSwizzle() const {
 PipelineColorAttachment ProgramInfo::getPipelineColorAttachment() const {
   PipelineColorAttachment colorAttachment = {};
   colorAttachment.format = renderTarget->format();
+  colorAttachment.colorWriteMask = colorWriteMask;
   if (xferProcessor != nullptr || blendMode == BlendMode::Src) {
     return colorAttachment;
   }
@@ -77,7 +78,6 @@ PipelineColorAttachment ProgramInfo::getPipelineColorAttachment() const {
   colorAttachment.srcAlphaBlendFactor = blendFormula.srcFactor();
   colorAttachment.dstAlphaBlendFactor = blendFormula.dstFactor();
   colorAttachment.alphaBlendOp = blendFormula.operation();
-  colorAttachment.colorWriteMask = ColorWriteMask::All;
   return colorAttachment;
 }
 
@@ -110,9 +110,25 @@ std::string ProgramInfo::getMangledSuffix(const Processor* processor) const {
   return "_P" + std::to_string(processorIndex);
 }
 
+static uint32_t StencilKey(const StencilDescriptor& stencil) {
+  return static_cast<uint32_t>(stencil.compare) | static_cast<uint32_t>(stencil.failOp) << 4 |
+         static_cast<uint32_t>(stencil.depthFailOp) << 8 |
+         static_cast<uint32_t>(stencil.passOp) << 12;
+}
+
+static void WriteStencilKey(const DepthStencilDescriptor& depthStencil, BytesKey* programKey) {
+  auto depthKey = static_cast<uint32_t>(depthStencil.depthCompare) |
+                  static_cast<uint32_t>(depthStencil.depthWriteEnabled) << 4;
+  programKey->write(depthKey | StencilKey(depthStencil.stencilFront) << 8);
+  programKey->write(StencilKey(depthStencil.stencilBack));
+  programKey->write(depthStencil.stencilReadMask);
+  programKey->write(depthStencil.stencilWriteMask);
+}
+
 std::shared_ptr<Program> ProgramInfo::getProgram() const {
   auto context = renderTarget->getContext();
-  BytesKey programKey = {};
+  auto globalCache = context->globalCache();
+  auto& programKey = *globalCache->getProgramKeyBuffer();
   geometryProcessor->computeProcessorKey(context, &programKey);
   for (const auto& processor : fragmentProcessors) {
     processor->computeProcessorKey(context, &programKey);
@@ -123,15 +139,18 @@ std::shared_ptr<Program> ProgramInfo::getProgram() const {
   programKey.write(static_cast<uint32_t>(blendMode));
   programKey.write(static_cast<uint32_t>(getOutputSwizzle().asKey()));
   programKey.write(static_cast<uint32_t>(cullMode));
+  programKey.write(colorWriteMask);
+  WriteStencilKey(depthStencil, &programKey);
   CAPUTRE_PROGRAM_INFO(programKey, context, this);
-  auto program = context->globalCache()->findProgram(programKey);
+  auto program = globalCache->findProgram(programKey);
   if (program == nullptr) {
-    program = ProgramBuilder::CreateProgram(context, this);
+    std::string recipe = {};
+    program = ProgramBuilder::CreateProgram(context, this, &recipe);
     if (program == nullptr) {
       LOGE("ProgramInfo::getProgram() Failed to create the program!");
       return nullptr;
     }
-    context->globalCache()->addProgram(programKey, program);
+    globalCache->addProgram(programKey, program, std::move(recipe));
   }
   return program;
 }
@@ -232,7 +251,7 @@ void ProgramInfo::setUniformsAndSamplers(RenderPass* renderPass, Program* progra
   if (vertexUniformData != nullptr) {
     vertexUniformData->setData(RTAdjustName, array);
   }
-  updateUniformDataSuffix(vertexUniformData, fragmentUniformData, geometryProcessor);
+  updateUniformDataProcessor(vertexUniformData, fragmentUniformData, geometryProcessor);
 
   FragmentProcessor::CoordTransformIter coordTransformIter(this);
   geometryProcessor->setData(vertexUniformData, fragmentUniformData, &coordTransformIter);
@@ -241,15 +260,15 @@ void ProgramInfo::setUniformsAndSamplers(RenderPass* renderPass, Program* progra
     FragmentProcessor::Iter iter(fragmentProcessor);
     const FragmentProcessor* fp = iter.next();
     while (fp) {
-      updateUniformDataSuffix(vertexUniformData, fragmentUniformData, fp);
+      updateUniformDataProcessor(vertexUniformData, fragmentUniformData, fp);
       fp->setData(vertexUniformData, fragmentUniformData);
       fp = iter.next();
     }
   }
   const auto processor = getXferProcessor();
-  updateUniformDataSuffix(vertexUniformData, fragmentUniformData, processor);
+  updateUniformDataProcessor(vertexUniformData, fragmentUniformData, processor);
   processor->setData(vertexUniformData, fragmentUniformData);
-  updateUniformDataSuffix(vertexUniformData, fragmentUniformData, nullptr);
+  updateUniformDataProcessor(vertexUniformData, fragmentUniformData, nullptr);
 
   bindUniformBufferAndUnloadToGPU(program, std::move(uniformBuffer), renderPass, vertexOffset,
                                   fragmentOffset);
@@ -288,16 +307,16 @@ std::vector<SamplerInfo> ProgramInfo::getSamplers() const {
   return samplers;
 }
 
-void ProgramInfo::updateUniformDataSuffix(UniformData* vertexUniformData,
-                                          UniformData* fragmentUniformData,
-                                          const Processor* processor) const {
-  auto suffix = getMangledSuffix(processor);
+void ProgramInfo::updateUniformDataProcessor(UniformData* vertexUniformData,
+                                             UniformData* fragmentUniformData,
+                                             const Processor* processor) const {
+  auto processorIndex = processor != nullptr ? getProcessorIndex(processor) : -1;
   if (vertexUniformData != nullptr) {
-    vertexUniformData->nameSuffix = suffix;
+    vertexUniformData->processorIndex = processorIndex;
   }
 
   if (fragmentUniformData != nullptr) {
-    fragmentUniformData->nameSuffix = suffix;
+    fragmentUniformData->processorIndex = processorIndex;
   }
 }
 }  // namespace tgfx
@@ -106,6 +106,28 @@ class ProgramInfo {
     cullMode = mode;
   }
 
+  /**
+   * Returns the depth and stencil state used for rendering.
+   */
+  const DepthStencilDescriptor& getDepthStencil() const {
+    return depthStencil;
+  }
+
+  /**
+   * Sets the depth and stencil state used for rendering.
+   */
+  void setDepthStencil(const DepthStencilDescriptor& descriptor) {
+    depthStencil = descriptor;
+  }
+
+  /**
+   * Sets the bitmask of color channels written to the render target. See ColorWriteMask for
+   * definitions.
+   */
+  void setColorWriteMask(uint32_t mask) {
+    colorWriteMask = mask;
+  }
+
  private:
   RenderTarget* renderTarget = nullptr;
   GeometryProcessor* geometryProcessor = nullptr;
@@ -116,12 +138,14 @@ class ProgramInfo {
   XferProcessor* xferProcessor = nullptr;
   BlendMode blendMode = BlendMode::SrcOver;
   CullMode cullMode = CullMode::None;
+  DepthStencilDescriptor depthStencil = {};
+  uint32_t colorWriteMask = ColorWriteMask::All;
 
   void updateProcessorIndices();
 
   std::vector<SamplerInfo> getSamplers() const;
 
-  void updateUniformDataSuffix(UniformData* vertexUniformData, UniformData* fragmentUniformData,
-                               const Processor* processor) const;
+  void updateUniformDataProcessor(UniformData* vertexUniformData, UniformData* fragmentUniformData,
+                                  const Processor* processor) const;
 };
 }  // namespace tgfx
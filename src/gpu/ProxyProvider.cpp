@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "ProxyProvider.h"
+#include "core/PathTriangulator.h"
 #include "core/ShapeRasterizer.h"
 #include "core/shapes/MatrixShape.h"
 #include "core/utils/HardwareBufferUtil.h"
@@ -24,6 +25,7 @@
 #include "core/utils/USE.h"
 #include "core/utils/UniqueID.h"
 #include "gpu/DrawingManager.h"
+#include "gpu/proxies/AtlasRenderTargetProxy.h"
 #include "gpu/proxies/DefaultTextureProxy.h"
 #include "gpu/proxies/ExternalTextureRenderTargetProxy.h"
 #include "gpu/proxies/HardwareRenderTargetProxy.h"
@@ -231,6 +233,52 @@ std::shared_ptr<GPUShapeProxy> ProxyProvider::createGPUShapeProxy(std::shared_pt
   return std::make_shared<GPUShapeProxy>(drawingMatrix, triangleProxy, textureProxy);
 }
 
+class StencilVertexSource : public DataSource<Data> {
+ public:
+  explicit StencilVertexSource(std::shared_ptr<Shape> shape) : shape(std::move(shape)) {
+  }
+
+  std::shared_ptr<Data> getData() const override {
+    std::vector<float> vertices = {};
+    if (PathTriangulator::ToStencilTriangles(shape->getPath(), &vertices) == 0) {
+      return nullptr;
+    }
+    return Data::MakeWithCopy(vertices.data(), vertices.size() * sizeof(float));
+  }
+
+ private:
+  std::shared_ptr<Shape> shape = nullptr;
+};
+
+std::shared_ptr<GPUBufferProxy> ProxyProvider::createStencilBufferProxy(
+    std::shared_ptr<Shape> shape, uint32_t renderFlags) {
+  if (shape == nullptr) {
+    return nullptr;
+  }
+  static const auto StencilTriangleType = UniqueID::Next();
+  auto uniqueKey = UniqueKey::Append(shape->getUniqueKey(), &StencilTriangleType, 1);
+  auto proxy = findOrWrapGPUBufferProxy(uniqueKey);
+  if (proxy != nullptr) {
+    return proxy;
+  }
+  std::unique_ptr<DataSource<Data>> source =
+      std::make_unique<StencilVertexSource>(std::move(shape));
+#ifdef TGFX_USE_THREADS
+  if (!(renderFlags & RenderFlags::DisableAsyncTask)) {
+    source = DataSource<Data>::Async(std::move(source));
+  }
+#endif
+  proxy = std::shared_ptr<GPUBufferProxy>(new GPUBufferProxy());
+  addResourceProxy(proxy, uniqueKey);
+  if (!(renderFlags & RenderFlags::DisableCache)) {
+    proxy->uniqueKey = uniqueKey;
+  }
+  auto task = context->drawingAllocator()->make<GPUBufferUploadTask>(
+      proxy, BufferType::CachedVertex, std::move(source));
+  context->drawingManager()->addResourceTask(std::move(task));
+  return proxy;
+}
+
 std::shared_ptr<TextureProxy> ProxyProvider::createTextureProxyByImageSource(
     std::shared_ptr<DataSource<ImageBuffer>> source, int width, int height, bool alphaOnly,
     bool mipmapped) {
@@ -271,11 +319,37 @@ std::shared_ptr<TextureProxy> ProxyProvider::createTextureProxy(
   USE(renderFlags);
   auto asyncDecoding = false;
 #endif
-  // Ensure the image source is retained so it won't be destroyed prematurely during async decoding.
-  auto source = ImageSource::MakeFrom(std::move(generator), !mipmapped, asyncDecoding);
+  std::unique_ptr<DataSource<ImageBuffer>> source = nullptr;
+  // Compressing on the calling thread would block it, so only asynchronous decoding compresses.
+  if (renderFlags & RenderFlags::CompressImages && asyncDecoding && !mipmapped && !alphaOnly &&
+      generator->isImageCodec() && generator->asyncSupport() &&
+      context->gpu()->features()->textureCompressionETC2) {
+    auto codec = std::static_pointer_cast<ImageCodec>(std::move(generator));
+    source = ImageSource::MakeCompressed(std::move(codec), asyncDecoding);
+  } else if (auto stagingBuffer = makeStagingBuffer(generator.get(), mipmapped, asyncDecoding)) {
+    // The worker decodes straight into the mapped staging buffer, and the GPU copies the pixels
+    // to the texture, so neither the decoding nor the upload blocks the context thread.
+    auto codec = std::static_pointer_cast<ImageCodec>(std::move(generator));
+    source = ImageSource::MakeStaging(std::move(codec), std::move(stagingBuffer), asyncDecoding);
+  } else {
+    // Ensure the image source is retained so it won't be destroyed prematurely during async
+    // decoding.
+    source = ImageSource::MakeFrom(std::move(generator), !mipmapped, asyncDecoding);
+  }
   return createTextureProxyByImageSource(std::move(source), width, height, alphaOnly, mipmapped);
 }
 
+std::shared_ptr<StagingImageBuffer> ProxyProvider::makeStagingBuffer(
+    const ImageGenerator* generator, bool mipmapped, bool asyncDecoding) const {
+  // Hardware buffers already upload without copying the pixels, but they have no mipmaps.
+  if (!asyncDecoding || !generator->isImageCodec() || !generator->asyncSupport() ||
+      (!mipmapped && HardwareBufferAvailable())) {
+    return nullptr;
+  }
+  return StagingImageBuffer::Make(context, generator->width(), generator->height(),
+                                  generator->isAlphaOnly(), generator->colorSpace());
+}
+
 std::shared_ptr<TextureProxy> ProxyProvider::createTextureProxy(
     std::shared_ptr<DataSource<ImageBuffer>> source, int width, int height, bool alphaOnly,
     bool mipmapped) {
@@ -320,6 +394,7 @@ std::shared_ptr<TextureProxy> ProxyProvider::createTextureProxy(
   auto textureProxy = std::shared_ptr<DefaultTextureProxy>(
       new DefaultTextureProxy(width, height, format, mipmapped, origin));
   if (backingFit == BackingFit::Approx) {
+    textureProxy->_backingFit = BackingFit::Approx;
     textureProxy->_backingStoreWidth = GetApproxSize(width);
     textureProxy->_backingStoreHeight = GetApproxSize(height);
   }
@@ -393,6 +468,15 @@ std::shared_ptr<RenderTargetProxy> ProxyProvider::createRenderTargetProxy(
   return proxy;
 }
 
+static bool CanPackIntoAtlas(const UniqueKey& uniqueKey, int width, int height, int sampleCount,
+                             bool mipmapped, ImageOrigin origin, BackingFit backingFit) {
+  // Only small transient targets that are never exposed outside the rendering pipeline can share
+  // their backing store with others.
+  return backingFit == BackingFit::Approx && uniqueKey.empty() && sampleCount == 1 && !mipmapped &&
+         origin == ImageOrigin::TopLeft && width <= AtlasRenderTargetProxy::MaxEntrySize &&
+         height <= AtlasRenderTargetProxy::MaxEntrySize;
+}
+
 std::shared_ptr<RenderTargetProxy> ProxyProvider::createRenderTargetProxy(
     const UniqueKey& uniqueKey, int width, int height, PixelFormat format, int sampleCount,
     bool mipmapped, ImageOrigin origin, BackingFit backingFit, uint32_t renderFlags) {
@@ -409,9 +493,16 @@ std::shared_ptr<RenderTargetProxy> ProxyProvider::createRenderTargetProxy(
     return nullptr;
   }
   sampleCount = gpu->getSampleCount(sampleCount, format);
-  auto proxy = std::shared_ptr<TextureRenderTargetProxy>(
-      new TextureRenderTargetProxy(width, height, format, sampleCount, mipmapped, origin));
+  std::shared_ptr<TextureRenderTargetProxy> proxy = nullptr;
+  if (CanPackIntoAtlas(uniqueKey, width, height, sampleCount, mipmapped, origin, backingFit)) {
+    proxy = std::shared_ptr<TextureRenderTargetProxy>(
+        new AtlasRenderTargetProxy(width, height, format));
+  } else {
+    proxy = std::shared_ptr<TextureRenderTargetProxy>(
+        new TextureRenderTargetProxy(width, height, format, sampleCount, mipmapped, origin));
+  }
   if (backingFit == BackingFit::Approx) {
+    proxy->_backingFit = BackingFit::Approx;
     proxy->_backingStoreWidth = GetApproxSize(width);
     proxy->_backingStoreHeight = GetApproxSize(height);
   }
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "core/StagingImageBuffer.h"
 #include "core/utils/BlockAllocator.h"
 #include "core/utils/SlidingWindowTracker.h"
 #include "gpu/AAType.h"
@@ -78,6 +79,13 @@ class ProxyProvider {
                                                      const Rect& clipBounds,
                                                      uint32_t renderFlags = 0);
 
+  /**
+   * Creates a GPUBufferProxy holding the stencil triangles of the given Shape, which is in device
+   * space. Returns the existing proxy if the triangles of the same Shape are cached already.
+   */
+  std::shared_ptr<GPUBufferProxy> createStencilBufferProxy(std::shared_ptr<Shape> shape,
+                                                           uint32_t renderFlags = 0);
+
   /*
    * Creates a TextureProxy for the given ImageBuffer. The image buffer will be released after being
    * uploaded to the GPU.
@@ -176,5 +184,8 @@ class ProxyProvider {
   std::shared_ptr<TextureProxy> createTextureProxyByImageSource(
       std::shared_ptr<DataSource<ImageBuffer>> source, int width, int height, bool alphaOnly,
       bool mipmapped = false);
+
+  std::shared_ptr<StagingImageBuffer> makeStagingBuffer(const ImageGenerator* generator,
+                                                        bool mipmapped, bool asyncDecoding) const;
 };
 }  // namespace tgfx
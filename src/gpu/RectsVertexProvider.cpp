@@ -17,12 +17,15 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "RectsVertexProvider.h"
+#include <algorithm>
 #include <array>
+#include <utility>
 #include "core/ColorSpaceXformSteps.h"
 #include "core/utils/ColorHelper.h"
 #include "core/utils/ColorSpaceHelper.h"
 #include "core/utils/MathExtra.h"
 #include "gpu/Quad.h"
+#include "gpu/RectsVertexSIMD.h"
 #include "tgfx/core/Stroke.h"
 
 namespace tgfx {
@@ -37,167 +40,270 @@ inline void ApplySubsetMode(UVSubsetMode mode, Rect* rect) {
   rect->inset(0.5f, 0.5f);
 }
 
-inline void WriteSubset(float* vertices, size_t& index, const Rect& subset) {
-  vertices[index++] = subset.left;
-  vertices[index++] = subset.top;
-  vertices[index++] = subset.right;
-  vertices[index++] = subset.bottom;
+inline bool IsHalfExact(float value) {
+  return HalfToFloat(FloatToHalf(value)) == value;
 }
 
-class AARectsVertexProvider : public RectsVertexProvider {
- public:
-  AARectsVertexProvider(PlacementArray<RectRecord>&& rects, PlacementArray<Rect>&& uvRects,
-                        AAType aaType, bool hasUVCoord, bool hasColor, UVSubsetMode subsetMode,
-                        std::shared_ptr<BlockAllocator> reference,
-                        std::shared_ptr<ColorSpace> colorSpace = nullptr)
-      : RectsVertexProvider(std::move(rects), std::move(uvRects), aaType, hasUVCoord, hasColor,
-                            subsetMode, std::move(reference), std::move(colorSpace)) {
+inline bool IsHalfExact(const Rect& rect) {
+  return IsHalfExact(rect.left) && IsHalfExact(rect.top) && IsHalfExact(rect.right) &&
+         IsHalfExact(rect.bottom);
+}
+
+// Packs two values into a single float slot, read back as a Half2 vertex attribute.
+inline float PackHalf2(float x, float y) {
+  uint16_t halves[2] = {FloatToHalf(x), FloatToHalf(y)};
+  float result;
+  memcpy(&result, halves, sizeof(float));
+  return result;
+}
+
+template <bool HalfUV>
+inline float* WriteUVCoord(float* vertices, float u, float v) {
+  if constexpr (HalfUV) {
+    *vertices++ = PackHalf2(u, v);
+  } else {
+    *vertices++ = u;
+    *vertices++ = v;
   }
+  return vertices;
+}
 
-  size_t vertexCount() const override {
-    size_t perVertexCount = bitFields.hasUVCoord ? 5 : 3;
-    if (bitFields.hasColor) {
-      perVertexCount += 1;
-    }
-    if (static_cast<UVSubsetMode>(bitFields.subsetMode) != UVSubsetMode::None) {
-      perVertexCount += 4;
-    }
-    return rects.size() * 2 * 4 * perVertexCount;
+template <bool HalfUV>
+inline float* WriteSubset(float* vertices, const Rect& subset) {
+  if constexpr (HalfUV) {
+    *vertices++ = PackHalf2(subset.left, subset.top);
+    *vertices++ = PackHalf2(subset.right, subset.bottom);
+  } else {
+    *vertices++ = subset.left;
+    *vertices++ = subset.top;
+    *vertices++ = subset.right;
+    *vertices++ = subset.bottom;
   }
+  return vertices;
+}
 
-  void getVertices(float* vertices) const override {
-    size_t index = 0;
-    bool needSubset = static_cast<UVSubsetMode>(bitFields.subsetMode) != UVSubsetMode::None;
-    auto hasUVRect = !uvRects.empty();
-    auto rectCount = rects.size();
-    std::unique_ptr<ColorSpaceXformSteps> steps = nullptr;
-    if (bitFields.hasColor && NeedConvertColorSpace(ColorSpace::SRGB(), _dstColorSpace)) {
-      steps =
-          std::make_unique<ColorSpaceXformSteps>(ColorSpace::SRGB().get(), AlphaType::Premultiplied,
-                                                 _dstColorSpace.get(), AlphaType::Premultiplied);
-    }
-    for (size_t i = 0; i < rectCount; ++i) {
-      auto& record = rects[i];
-      auto& viewMatrix = record->viewMatrix;
-      auto& rect = record->rect;
-      float compressedColor = 0.f;
-      if (bitFields.hasColor) {
-        uint32_t uintColor = ToUintPMColor(record->color, steps.get());
-        compressedColor = *reinterpret_cast<float*>(&uintColor);
+static void GatherRectBatch(const PlacementArray<RectRecord>& rects,
+                            const PlacementArray<Rect>& uvRects, size_t start, size_t count,
+                            RectBatch* batch) {
+  auto hasUVRect = !uvRects.empty();
+  for (size_t i = 0; i < count; ++i) {
+    auto& record = rects[start + i];
+    auto& rect = record->rect;
+    auto& matrix = record->viewMatrix;
+    auto& uvRect = hasUVRect ? *uvRects[start + i] : rect;
+    batch->left[i] = rect.left;
+    batch->top[i] = rect.top;
+    batch->right[i] = rect.right;
+    batch->bottom[i] = rect.bottom;
+    batch->scaleX[i] = matrix.getScaleX();
+    batch->skewX[i] = matrix.getSkewX();
+    batch->transX[i] = matrix.getTranslateX();
+    batch->skewY[i] = matrix.getSkewY();
+    batch->scaleY[i] = matrix.getScaleY();
+    batch->transY[i] = matrix.getTranslateY();
+    batch->uvLeft[i] = uvRect.left;
+    batch->uvTop[i] = uvRect.top;
+    batch->uvRight[i] = uvRect.right;
+    batch->uvBottom[i] = uvRect.bottom;
+  }
+}
+
+/**
+ * The per-rect attributes that are copied to every vertex of the rect.
+ */
+struct RectAttributeBatch {
+  float colors[RECT_BATCH_SIZE];
+  Rect subsets[RECT_BATCH_SIZE];
+};
+
+// The corners of a quad are ordered left-top, left-bottom, right-top and right-bottom, so the
+// second bit of a corner index selects the right edge and the first bit selects the bottom edge.
+template <bool HasUV, bool HasColor, bool HasSubset, bool HalfUV>
+float* WriteAAVertices(const RectBatch&, const AAQuadBatch& quads,
+                       const RectAttributeBatch& attributes, size_t count, float* vertices) {
+  for (size_t i = 0; i < count; ++i) {
+    for (int j = 0; j < 2; ++j) {
+      auto& quad = j == 0 ? quads.inset : quads.outset;
+      auto& uvBounds = j == 0 ? quads.uvInset : quads.uvOutset;
+      auto coverage = j == 0 ? 1.0f : 0.0f;
+      for (size_t k = 0; k < 4; ++k) {
+        *vertices++ = quad.x[k][i];
+        *vertices++ = quad.y[k][i];
+        *vertices++ = coverage;
+        if constexpr (HasUV) {
+          auto u = (k & 2) ? uvBounds[2][i] : uvBounds[0][i];
+          auto v = (k & 1) ? uvBounds[3][i] : uvBounds[1][i];
+          vertices = WriteUVCoord<HalfUV>(vertices, u, v);
+        }
+        if constexpr (HasColor) {
+          *vertices++ = attributes.colors[i];
+        }
+        if constexpr (HasSubset) {
+          vertices = WriteSubset<HalfUV>(vertices, attributes.subsets[i]);
+        }
       }
+    }
+  }
+  return vertices;
+}
 
-      auto scale = sqrtf(viewMatrix.getScaleX() * viewMatrix.getScaleX() +
-                         viewMatrix.getSkewY() * viewMatrix.getSkewY());
-      // we want the new edge to be .5px away from the old line.
-      auto padding = 0.5f / scale;
-      auto insetBounds = rect.makeInset(padding, padding);
-      auto insetQuad = Quad::MakeFrom(insetBounds, &viewMatrix);
-      auto outsetBounds = rect.makeOutset(padding, padding);
-      auto outsetQuad = Quad::MakeFrom(outsetBounds, &viewMatrix);
-      auto insetUV = insetBounds;
-      auto outsetUV = outsetBounds;
-      auto subset = rect;
-      if (hasUVRect) {
-        auto& uvRect = *uvRects[i];
-        insetUV = uvRect.makeInset(padding, padding);
-        outsetUV = uvRect.makeOutset(padding, padding);
-        subset = uvRect;
+template <bool HasUV, bool HasColor, bool HasSubset, bool HalfUV>
+float* WriteNonAAVertices(const RectBatch& batch, const QuadBatch& quad,
+                          const RectAttributeBatch& attributes, size_t count, float* vertices) {
+  for (size_t i = 0; i < count; ++i) {
+    for (size_t j = 4; j >= 1; --j) {
+      auto k = j - 1;
+      *vertices++ = quad.x[k][i];
+      *vertices++ = quad.y[k][i];
+      if constexpr (HasUV) {
+        auto u = (k & 2) ? batch.uvRight[i] : batch.uvLeft[i];
+        auto v = (k & 1) ? batch.uvBottom[i] : batch.uvTop[i];
+        vertices = WriteUVCoord<HalfUV>(vertices, u, v);
       }
-      if (needSubset) {
-        ApplySubsetMode(static_cast<UVSubsetMode>(bitFields.subsetMode), &subset);
+      if constexpr (HasColor) {
+        *vertices++ = attributes.colors[i];
       }
-      auto uvInsetQuad = Quad::MakeFrom(insetUV);
-      auto uvOutsetQuad = Quad::MakeFrom(outsetUV);
-      for (int j = 0; j < 2; ++j) {
-        auto& quad = j == 0 ? insetQuad : outsetQuad;
-        auto& uvQuad = j == 0 ? uvInsetQuad : uvOutsetQuad;
-        auto coverage = j == 0 ? 1.0f : 0.0f;
-        for (size_t k = 0; k < 4; ++k) {
-          vertices[index++] = quad.point(k).x;
-          vertices[index++] = quad.point(k).y;
-          vertices[index++] = coverage;
-          if (bitFields.hasUVCoord) {
-            vertices[index++] = uvQuad.point(k).x;
-            vertices[index++] = uvQuad.point(k).y;
-          }
-          if (bitFields.hasColor) {
-            vertices[index++] = compressedColor;
-          }
-          if (needSubset) {
-            WriteSubset(vertices, index, subset);
-          }
-        }
+      if constexpr (HasSubset) {
+        vertices = WriteSubset<HalfUV>(vertices, attributes.subsets[i]);
       }
     }
   }
-};
+  return vertices;
+}
+
+template <typename QuadBatchType>
+using VertexWriter = float* (*)(const RectBatch&, const QuadBatchType&, const RectAttributeBatch&,
+                                size_t, float*);
 
-class NonAARectsVertexProvider : public RectsVertexProvider {
+template <size_t... Layouts>
+constexpr std::array<VertexWriter<AAQuadBatch>, sizeof...(Layouts)> MakeAAVertexWriters(
+    std::index_sequence<Layouts...>) {
+  return {{WriteAAVertices<(Layouts & 1) != 0, (Layouts & 2) != 0, (Layouts & 4) != 0,
+                           (Layouts & 8) != 0>...}};
+}
+
+template <size_t... Layouts>
+constexpr std::array<VertexWriter<QuadBatch>, sizeof...(Layouts)> MakeNonAAVertexWriters(
+    std::index_sequence<Layouts...>) {
+  return {{WriteNonAAVertices<(Layouts & 1) != 0, (Layouts & 2) != 0, (Layouts & 4) != 0,
+                              (Layouts & 8) != 0>...}};
+}
+
+// One specialized writer for each combination of hasUVCoord, hasColor, hasSubset and halfUV.
+static constexpr auto AAVertexWriters = MakeAAVertexWriters(std::make_index_sequence<16>());
+static constexpr auto NonAAVertexWriters = MakeNonAAVertexWriters(std::make_index_sequence<16>());
+
+/**
+ * BatchedRectsVertexProvider generates the vertices of unstroked rects in batches of
+ * RECT_BATCH_SIZE: the geometry of a batch is computed by the SIMD kernels, then written by a loop
+ * specialized for the vertex layout of the provider.
+ */
+template <typename QuadBatchType>
+class BatchedRectsVertexProvider : public RectsVertexProvider {
  public:
-  NonAARectsVertexProvider(PlacementArray<RectRecord>&& rects, PlacementArray<Rect>&& uvRects,
-                           AAType aaType, bool hasUVCoord, bool hasColor, UVSubsetMode subsetMode,
-                           std::shared_ptr<BlockAllocator> reference,
-                           std::shared_ptr<ColorSpace> colorSpace = nullptr)
+  BatchedRectsVertexProvider(PlacementArray<RectRecord>&& rects, PlacementArray<Rect>&& uvRects,
+                             AAType aaType, bool hasUVCoord, bool hasColor,
+                             UVSubsetMode subsetMode, std::shared_ptr<BlockAllocator> reference,
+                             std::shared_ptr<ColorSpace> colorSpace)
       : RectsVertexProvider(std::move(rects), std::move(uvRects), aaType, hasUVCoord, hasColor,
                             subsetMode, std::move(reference), std::move(colorSpace)) {
   }
 
-  size_t vertexCount() const override {
-    size_t perVertexCount = bitFields.hasUVCoord ? 4 : 2;
+ protected:
+  size_t perVertexCount(size_t positionCount) const {
+    size_t count = positionCount;
+    if (bitFields.hasUVCoord) {
+      count += bitFields.halfUV ? 1 : 2;
+    }
     if (bitFields.hasColor) {
-      perVertexCount += 1;
+      count += 1;
     }
     if (static_cast<UVSubsetMode>(bitFields.subsetMode) != UVSubsetMode::None) {
-      perVertexCount += 4;
+      count += bitFields.halfUV ? 2 : 4;
     }
-    return rects.size() * 4 * perVertexCount;
+    return count;
   }
 
-  void getVertices(float* vertices) const override {
-    size_t index = 0;
-    bool needSubset = static_cast<UVSubsetMode>(bitFields.subsetMode) != UVSubsetMode::None;
-    auto hasUVRect = !uvRects.empty();
-    auto rectCount = rects.size();
+  void writeVertices(float* vertices, const std::array<VertexWriter<QuadBatchType>, 16>& writers,
+                     void (*computeQuads)(const RectBatch&, size_t, QuadBatchType*)) const {
+    auto subsetMode = static_cast<UVSubsetMode>(bitFields.subsetMode);
+    auto hasSubset = subsetMode != UVSubsetMode::None;
+    auto layout = (bitFields.hasUVCoord ? 1 : 0) | (bitFields.hasColor ? 2 : 0) |
+                  (hasSubset ? 4 : 0) | (bitFields.halfUV ? 8 : 0);
+    auto writer = writers[static_cast<size_t>(layout)];
     std::unique_ptr<ColorSpaceXformSteps> steps = nullptr;
     if (bitFields.hasColor && NeedConvertColorSpace(ColorSpace::SRGB(), _dstColorSpace)) {
       steps =
           std::make_unique<ColorSpaceXformSteps>(ColorSpace::SRGB().get(), AlphaType::Premultiplied,
                                                  _dstColorSpace.get(), AlphaType::Premultiplied);
     }
-    for (size_t i = 0; i < rectCount; ++i) {
-      auto& record = rects[i];
-      auto& viewMatrix = record->viewMatrix;
-      auto& rect = record->rect;
-      float compressedColor = 0.f;
-      if (bitFields.hasColor) {
-        uint32_t uintColor = ToUintPMColor(record->color, steps.get());
-        compressedColor = *reinterpret_cast<float*>(&uintColor);
-      }
-      auto quad = Quad::MakeFrom(rect, &viewMatrix);
-      auto& uvRect = hasUVRect ? *uvRects[i] : rect;
-      auto uvQuad = Quad::MakeFrom(uvRect);
-      auto subset = uvRect;
-      if (needSubset) {
-        ApplySubsetMode(static_cast<UVSubsetMode>(bitFields.subsetMode), &subset);
-      }
-      for (size_t j = 4; j >= 1; --j) {
-        vertices[index++] = quad.point(j - 1).x;
-        vertices[index++] = quad.point(j - 1).y;
-        if (bitFields.hasUVCoord) {
-          vertices[index++] = uvQuad.point(j - 1).x;
-          vertices[index++] = uvQuad.point(j - 1).y;
-        }
+    auto hasUVRect = !uvRects.empty();
+    auto rectCount = rects.size();
+    // Zero-initialized so that the unused lanes of the last batch hold no garbage.
+    RectBatch batch = {};
+    QuadBatchType quads = {};
+    RectAttributeBatch attributes = {};
+    for (size_t start = 0; start < rectCount; start += RECT_BATCH_SIZE) {
+      auto count = std::min(RECT_BATCH_SIZE, rectCount - start);
+      GatherRectBatch(rects, uvRects, start, count, &batch);
+      for (size_t i = 0; i < count; ++i) {
+        auto& record = rects[start + i];
         if (bitFields.hasColor) {
-          vertices[index++] = compressedColor;
+          uint32_t uintColor = ToUintPMColor(record->color, steps.get());
+          attributes.colors[i] = *reinterpret_cast<float*>(&uintColor);
         }
-        if (needSubset) {
-          WriteSubset(vertices, index, subset);
+        if (hasSubset) {
+          auto& subset = attributes.subsets[i];
+          subset = hasUVRect ? *uvRects[start + i] : record->rect;
+          ApplySubsetMode(subsetMode, &subset);
         }
       }
+      computeQuads(batch, count, &quads);
+      vertices = writer(batch, quads, attributes, count, vertices);
     }
   }
 };
 
+class AARectsVertexProvider : public BatchedRectsVertexProvider<AAQuadBatch> {
+ public:
+  AARectsVertexProvider(PlacementArray<RectRecord>&& rects, PlacementArray<Rect>&& uvRects,
+                        AAType aaType, bool hasUVCoord, bool hasColor, UVSubsetMode subsetMode,
+                        std::shared_ptr<BlockAllocator> reference,
+                        std::shared_ptr<ColorSpace> colorSpace = nullptr)
+      : BatchedRectsVertexProvider(std::move(rects), std::move(uvRects), aaType, hasUVCoord,
+                                   hasColor, subsetMode, std::move(reference),
+                                   std::move(colorSpace)) {
+  }
+
+  size_t vertexCount() const override {
+    return rects.size() * 2 * 4 * perVertexCount(3);
+  }
+
+  void getVertices(float* vertices) const override {
+    writeVertices(vertices, AAVertexWriters, ComputeAAQuadBatch);
+  }
+};
+
+class NonAARectsVertexProvider : public BatchedRectsVertexProvider<QuadBatch> {
+ public:
+  NonAARectsVertexProvider(PlacementArray<RectRecord>&& rects, PlacementArray<Rect>&& uvRects,
+                           AAType aaType, bool hasUVCoord, bool hasColor, UVSubsetMode subsetMode,
+                           std::shared_ptr<BlockAllocator> reference,
+                           std::shared_ptr<ColorSpace> colorSpace = nullptr)
+      : BatchedRectsVertexProvider(std::move(rects), std::move(uvRects), aaType, hasUVCoord,
+                                   hasColor, subsetMode, std::move(reference),
+                                   std::move(colorSpace)) {
+  }
+
+  size_t vertexCount() const override {
+    return rects.size() * 4 * perVertexCount(2);
+  }
+
+  void getVertices(float* vertices) const override {
+    writeVertices(vertices, NonAAVertexWriters, ComputeQuadBatch);
+  }
+};
+
 // Anti-aliased angular stroke joins: Miter and Bevel.
 class AAAngularStrokeRectsVertexProvider final : public RectsVertexProvider {
   PlacementArray<Stroke> strokes = {};
@@ -905,4 +1011,47 @@ RectsVertexProvider::RectsVertexProvider(PlacementArray<RectRecord>&& rects,
   bitFields.hasColor = hasColor;
   bitFields.subsetMode = static_cast<uint8_t>(subsetMode);
 }
+
+bool RectsVertexProvider::enableHalfUV() {
+  auto subsetMode = static_cast<UVSubsetMode>(bitFields.subsetMode);
+  if (_lineJoin.has_value() || (!bitFields.hasUVCoord && subsetMode == UVSubsetMode::None)) {
+    return false;
+  }
+  auto hasUVRect = !uvRects.empty();
+  auto isAA = aaType() == AAType::Coverage;
+  auto rectCount = rects.size();
+  RectBatch batch = {};
+  AAQuadBatch quads = {};
+  for (size_t start = 0; start < rectCount; start += RECT_BATCH_SIZE) {
+    auto count = std::min(RECT_BATCH_SIZE, rectCount - start);
+    for (size_t i = 0; i < count; ++i) {
+      auto& uvRect = hasUVRect ? *uvRects[start + i] : rects[start + i]->rect;
+      if (subsetMode != UVSubsetMode::None) {
+        auto subset = uvRect;
+        ApplySubsetMode(subsetMode, &subset);
+        if (!IsHalfExact(subset)) {
+          return false;
+        }
+      }
+      if (bitFields.hasUVCoord && !isAA && !IsHalfExact(uvRect)) {
+        return false;
+      }
+    }
+    if (!bitFields.hasUVCoord || !isAA) {
+      continue;
+    }
+    // Checks the padded UVs exactly as getVertices() computes them.
+    GatherRectBatch(rects, uvRects, start, count, &batch);
+    ComputeAAQuadBatch(batch, count, &quads);
+    for (size_t i = 0; i < count; ++i) {
+      for (size_t edge = 0; edge < 4; ++edge) {
+        if (!IsHalfExact(quads.uvInset[edge][i]) || !IsHalfExact(quads.uvOutset[edge][i])) {
+          return false;
+        }
+      }
+    }
+  }
+  bitFields.halfUV = true;
+  return true;
+}
 }  // namespace tgfx
@@ -126,6 +126,21 @@ class RectsVertexProvider : public VertexProvider {
     return static_cast<UVSubsetMode>(bitFields.subsetMode) != UVSubsetMode::None;
   }
 
+  /**
+   * Returns true if the provider packs UV coordinates and subset rects as half floats.
+   */
+  bool hasHalfUV() const {
+    return bitFields.halfUV;
+  }
+
+  /**
+   * Switches the provider to pack UV coordinates and subset rects as half floats if every value it
+   * generates can be represented exactly, which halves their vertex size without changing the
+   * rendering result. Stroked rects are never packed. Must be called before getVertices(). Returns
+   * true if the packed layout is enabled.
+   */
+  bool enableHalfUV();
+
   const std::shared_ptr<ColorSpace>& dstColorSpace() const {
     return _dstColorSpace;
   }
@@ -140,6 +155,7 @@ class RectsVertexProvider : public VertexProvider {
     bool hasUVCoord : 1;
     bool hasColor : 1;
     uint8_t subsetMode : 2;
+    bool halfUV : 1;
   } bitFields = {};
 
   RectsVertexProvider(PlacementArray<RectRecord>&& rects, PlacementArray<Rect>&& uvRects,
@@ -0,0 +1,127 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "RectsVertexSIMD.h"
+// First undef to prevent error when re-included.
+#undef HWY_TARGET_INCLUDE
+// For dynamic dispatch, specify the name of the current file (unfortunately
+// __FILE__ is not reliable) so that foreach_target.h can re-include it.
+#define HWY_TARGET_INCLUDE "gpu/RectsVertexSIMD.cpp"
+// Generates code for each enabled target by re-including this source file.
+#include "hwy/foreach_target.h"  // IWYU pragma: keep
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wgnu-zero-variadic-macro-arguments"
+// Must come after foreach_target.h to avoid redefinition errors.
+#include "hwy/highway.h"
+#pragma clang diagnostic pop
+
+HWY_BEFORE_NAMESPACE();
+namespace tgfx {
+namespace HWY_NAMESPACE {
+namespace hn = hwy::HWY_NAMESPACE;
+using BatchTag = hn::CappedTag<float, RECT_BATCH_SIZE>;
+using BatchVec = hn::Vec<BatchTag>;
+
+// Uses the same operations as AffinePointsHWYImpl() so that the results match Matrix::mapPoints().
+HWY_INLINE void StoreQuad(const RectBatch& batch, size_t offset, BatchVec left, BatchVec top,
+                          BatchVec right, BatchVec bottom, QuadBatch* quad) {
+  const BatchTag d;
+  auto scaleX = hn::LoadU(d, &batch.scaleX[offset]);
+  auto skewX = hn::LoadU(d, &batch.skewX[offset]);
+  auto transX = hn::LoadU(d, &batch.transX[offset]);
+  auto skewY = hn::LoadU(d, &batch.skewY[offset]);
+  auto scaleY = hn::LoadU(d, &batch.scaleY[offset]);
+  auto transY = hn::LoadU(d, &batch.transY[offset]);
+  auto topX = hn::MulAdd(top, skewX, transX);
+  auto bottomX = hn::MulAdd(bottom, skewX, transX);
+  hn::StoreU(hn::MulAdd(left, scaleX, topX), d, &quad->x[0][offset]);
+  hn::StoreU(hn::MulAdd(left, scaleX, bottomX), d, &quad->x[1][offset]);
+  hn::StoreU(hn::MulAdd(right, scaleX, topX), d, &quad->x[2][offset]);
+  hn::StoreU(hn::MulAdd(right, scaleX, bottomX), d, &quad->x[3][offset]);
+  auto leftY = hn::MulAdd(left, skewY, transY);
+  auto rightY = hn::MulAdd(right, skewY, transY);
+  hn::StoreU(hn::MulAdd(top, scaleY, leftY), d, &quad->y[0][offset]);
+  hn::StoreU(hn::MulAdd(bottom, scaleY, leftY), d, &quad->y[1][offset]);
+  hn::StoreU(hn::MulAdd(top, scaleY, rightY), d, &quad->y[2][offset]);
+  hn::StoreU(hn::MulAdd(bottom, scaleY, rightY), d, &quad->y[3][offset]);
+}
+
+HWY_INLINE void StoreBounds(BatchVec left, BatchVec top, BatchVec right, BatchVec bottom,
+                            float bounds[4][RECT_BATCH_SIZE], size_t offset) {
+  const BatchTag d;
+  hn::StoreU(left, d, &bounds[0][offset]);
+  hn::StoreU(top, d, &bounds[1][offset]);
+  hn::StoreU(right, d, &bounds[2][offset]);
+  hn::StoreU(bottom, d, &bounds[3][offset]);
+}
+
+void ComputeQuadBatchHWYImpl(const RectBatch& batch, size_t count, QuadBatch* quads) {
+  const BatchTag d;
+  // RECT_BATCH_SIZE is a multiple of the lane count, so the last iteration never overflows.
+  for (size_t i = 0; i < count; i += hn::Lanes(d)) {
+    StoreQuad(batch, i, hn::LoadU(d, &batch.left[i]), hn::LoadU(d, &batch.top[i]),
+              hn::LoadU(d, &batch.right[i]), hn::LoadU(d, &batch.bottom[i]), quads);
+  }
+}
+
+void ComputeAAQuadBatchHWYImpl(const RectBatch& batch, size_t count, AAQuadBatch* quads) {
+  const BatchTag d;
+  auto half = hn::Set(d, 0.5f);
+  for (size_t i = 0; i < count; i += hn::Lanes(d)) {
+    auto scaleX = hn::LoadU(d, &batch.scaleX[i]);
+    auto skewY = hn::LoadU(d, &batch.skewY[i]);
+    auto scale = hn::Sqrt(hn::Add(hn::Mul(scaleX, scaleX), hn::Mul(skewY, skewY)));
+    // we want the new edge to be .5px away from the old line.
+    auto padding = hn::Div(half, scale);
+    auto left = hn::LoadU(d, &batch.left[i]);
+    auto top = hn::LoadU(d, &batch.top[i]);
+    auto right = hn::LoadU(d, &batch.right[i]);
+    auto bottom = hn::LoadU(d, &batch.bottom[i]);
+    StoreQuad(batch, i, hn::Add(left, padding), hn::Add(top, padding), hn::Sub(right, padding),
+              hn::Sub(bottom, padding), &quads->inset);
+    StoreQuad(batch, i, hn::Sub(left, padding), hn::Sub(top, padding), hn::Add(right, padding),
+              hn::Add(bottom, padding), &quads->outset);
+    auto uvLeft = hn::LoadU(d, &batch.uvLeft[i]);
+    auto uvTop = hn::LoadU(d, &batch.uvTop[i]);
+    auto uvRight = hn::LoadU(d, &batch.uvRight[i]);
+    auto uvBottom = hn::LoadU(d, &batch.uvBottom[i]);
+    StoreBounds(hn::Add(uvLeft, padding), hn::Add(uvTop, padding), hn::Sub(uvRight, padding),
+                hn::Sub(uvBottom, padding), quads->uvInset, i);
+    StoreBounds(hn::Sub(uvLeft, padding), hn::Sub(uvTop, padding), hn::Add(uvRight, padding),
+                hn::Add(uvBottom, padding), quads->uvOutset, i);
+  }
+}
+}  // namespace HWY_NAMESPACE
+}  // namespace tgfx
+HWY_AFTER_NAMESPACE();
+
+#if HWY_ONCE
+namespace tgfx {
+HWY_EXPORT(ComputeQuadBatchHWYImpl);
+HWY_EXPORT(ComputeAAQuadBatchHWYImpl);
+
+void ComputeQuadBatch(const RectBatch& batch, size_t count, QuadBatch* quads) {
+  return HWY_DYNAMIC_DISPATCH(ComputeQuadBatchHWYImpl)(batch, count, quads);
+}
+
+void ComputeAAQuadBatch(const RectBatch& batch, size_t count, AAQuadBatch* quads) {
+  return HWY_DYNAMIC_DISPATCH(ComputeAAQuadBatchHWYImpl)(batch, count, quads);
+}
+}  // namespace tgfx
+#endif
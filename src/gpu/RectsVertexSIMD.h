@@ -0,0 +1,80 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+namespace tgfx {
+/**
+ * The number of rects processed by the SIMD vertex kernels in one batch.
+ */
+static constexpr size_t RECT_BATCH_SIZE = 8;
+
+/**
+ * RectBatch holds up to RECT_BATCH_SIZE rects in the structure-of-arrays layout used by the SIMD
+ * vertex kernels. Each rect comes with the affine components of its view matrix and the rect used
+ * to generate its UV coordinates.
+ */
+struct RectBatch {
+  float left[RECT_BATCH_SIZE];
+  float top[RECT_BATCH_SIZE];
+  float right[RECT_BATCH_SIZE];
+  float bottom[RECT_BATCH_SIZE];
+  float scaleX[RECT_BATCH_SIZE];
+  float skewX[RECT_BATCH_SIZE];
+  float transX[RECT_BATCH_SIZE];
+  float skewY[RECT_BATCH_SIZE];
+  float scaleY[RECT_BATCH_SIZE];
+  float transY[RECT_BATCH_SIZE];
+  float uvLeft[RECT_BATCH_SIZE];
+  float uvTop[RECT_BATCH_SIZE];
+  float uvRight[RECT_BATCH_SIZE];
+  float uvBottom[RECT_BATCH_SIZE];
+};
+
+/**
+ * The device space corners of a batch of rects, in the same order as Quad::MakeFrom():
+ * left-top, left-bottom, right-top and right-bottom.
+ */
+struct QuadBatch {
+  float x[4][RECT_BATCH_SIZE];
+  float y[4][RECT_BATCH_SIZE];
+};
+
+/**
+ * The anti-aliased geometry of a batch of rects. The inset and outset quads are the rects moved
+ * half a device pixel inwards and outwards, and the UV bounds are moved by the same distance.
+ */
+struct AAQuadBatch {
+  QuadBatch inset;
+  QuadBatch outset;
+  float uvInset[4][RECT_BATCH_SIZE];
+  float uvOutset[4][RECT_BATCH_SIZE];
+};
+
+/**
+ * Maps the corners of the first count rects in the batch through their view matrices.
+ */
+void ComputeQuadBatch(const RectBatch& batch, size_t count, QuadBatch* quads);
+
+/**
+ * Computes the inset and outset quads and UV bounds of the first count rects in the batch.
+ */
+void ComputeAAQuadBatch(const RectBatch& batch, size_t count, AAQuadBatch* quads);
+}  // namespace tgfx
@@ -21,6 +21,7 @@
 #include "core/Atlas.h"
 #include "core/AtlasCell.h"
 #include "core/AtlasManager.h"
+#include "core/DistanceFieldRasterizer.h"
 #include "core/GlyphRasterizer.h"
 #include "core/PathRasterizer.h"
 #include "core/PathRef.h"
@@ -33,8 +34,15 @@
 #include "core/utils/PixelFormatUtil.h"
 #include "core/utils/StrokeUtils.h"
 #include "gpu/DrawingManager.h"
+#include "tgfx/core/RenderFlags.h"
 
 namespace tgfx {
+/**
+ * The font size at which glyphs are rasterized into distance fields. The fields are then scaled to
+ * any font size on screen, so a single atlas entry serves all scales of the same glyph.
+ */
+static constexpr float DistanceFieldReferenceSize = 64.0f;
+
 static uint32_t GetTypefaceID(const Typeface* typeface, bool isCustom) {
   return isCustom ? static_cast<const UserTypeface*>(typeface)->builderID() : typeface->uniqueID();
 }
@@ -91,9 +99,14 @@ static float FindMaxGlyphDimension(const Font& font, const std::vector<GlyphID>&
   return maxDimension;
 }
 
+/**
+ * Returns the codec that rasterizes the glyph into the atlas. If the glyph can be rasterized by the
+ * ScalerContext directly, the returned codec is also stored in glyphRasterizer, which allows it to
+ * be rasterized in batches with other glyphs of the same ScalerContext.
+ */
 static std::shared_ptr<ImageCodec> GetGlyphCodec(
     const Font& font, const std::shared_ptr<ScalerContext>& scalerContext, GlyphID glyphID,
-    const Stroke* stroke, Point* glyphOffset) {
+    const Stroke* stroke, Point* glyphOffset, std::shared_ptr<GlyphRasterizer>* glyphRasterizer) {
   if (glyphID == 0) {
     return nullptr;
   }
@@ -105,8 +118,9 @@ static std::shared_ptr<ImageCodec> GetGlyphCodec(
     glyphOffset->y = bounds.top;
     auto width = static_cast<int>(ceilf(bounds.width()));
     auto height = static_cast<int>(ceilf(bounds.height()));
-    return std::make_shared<GlyphRasterizer>(width, height, scalerContext, glyphID, hasFauxBold,
-                                             stroke);
+    *glyphRasterizer = std::make_shared<GlyphRasterizer>(width, height, scalerContext, glyphID,
+                                                         hasFauxBold, stroke);
+    return *glyphRasterizer;
   }
 
   std::shared_ptr<Shape> shape = nullptr;
@@ -142,6 +156,19 @@ static std::shared_ptr<ImageCodec> GetGlyphCodec(
   );
 }
 
+static void AddGlyphToAtlas(DrawingManager* drawingManager,
+                            std::shared_ptr<TextureProxy> textureProxy, Plot* plot,
+                            const Point& atlasOffset, std::shared_ptr<ImageCodec> glyphCodec,
+                            std::shared_ptr<GlyphRasterizer> glyphRasterizer) {
+  if (glyphRasterizer != nullptr) {
+    drawingManager->addAtlasGlyphTask(std::move(textureProxy), plot, atlasOffset,
+                                      std::move(glyphRasterizer));
+  } else {
+    drawingManager->addAtlasCellTask(std::move(textureProxy), plot, atlasOffset,
+                                     std::move(glyphCodec));
+  }
+}
+
 static void ComputeGlyphFinalMatrix(const Rect& atlasLocation, const Matrix& stateMatrix,
                                     float scale, const Point& position, Matrix* glyphMatrix,
                                     bool needsPixelAlignment) {
@@ -315,13 +342,18 @@ void RenderContext::drawGlyphRunList(std::shared_ptr<GlyphRunList> glyphRunList,
   inverseMatrix.mapRect(&localClipBounds);
 
   std::vector<GlyphRun> rejectedGlyphRuns = {};
+  auto distanceFieldText = (renderFlags & RenderFlags::DistanceFieldText) != 0;
   const auto& glyphRuns = glyphRunList->glyphRuns();
   for (const auto& run : glyphRuns) {
     if (run.font.getTypeface() == nullptr) {
       continue;
     }
     GlyphRun rejectedGlyphRun = {};
-    drawGlyphsAsDirectMask(run, state, brush, stroke, localClipBounds, &rejectedGlyphRun);
+    if (distanceFieldText && !run.font.hasColor()) {
+      drawGlyphsAsDistanceField(run, state, brush, stroke, localClipBounds, &rejectedGlyphRun);
+    } else {
+      drawGlyphsAsDirectMask(run, state, brush, stroke, localClipBounds, &rejectedGlyphRun);
+    }
     if (rejectedGlyphRun.glyphs.empty()) {
       continue;
     }
@@ -481,8 +513,9 @@ void RenderContext::drawGlyphsAsDirectMask(const GlyphRun& sourceGlyphRun, const
     if (atlasManager->getCellLocator(maskFormat, glyphKey, glyphLocator)) {
       glyphOffset = glyphLocator.offset;
     } else {
-      auto glyphCodec =
-          GetGlyphCodec(font, font.scalerContext, glyphID, scaledStroke.get(), &glyphOffset);
+      std::shared_ptr<GlyphRasterizer> glyphRasterizer = nullptr;
+      auto glyphCodec = GetGlyphCodec(font, font.scalerContext, glyphID, scaledStroke.get(),
+                                      &glyphOffset, &glyphRasterizer);
       if (glyphCodec == nullptr) {
         rejectedGlyphRun->glyphs.push_back(glyphID);
         rejectedGlyphRun->positions.push_back(glyphPosition);
@@ -498,8 +531,9 @@ void RenderContext::drawGlyphsAsDirectMask(const GlyphRun& sourceGlyphRun, const
         auto pageIndex = atlasLocator.pageIndex();
         auto atlasOffset =
             Point::Make(atlasLocator.getLocation().left, atlasLocator.getLocation().top);
-        drawingManager->addAtlasCellTask(textureProxies[pageIndex], atlasOffset,
-                                         std::move(glyphCodec));
+        auto plot = atlasManager->getPlot(maskFormat, atlasLocator.plotLocator());
+        AddGlyphToAtlas(drawingManager, textureProxies[pageIndex], plot, atlasOffset,
+                        std::move(glyphCodec), std::move(glyphRasterizer));
       } else {
         rejectedGlyphRun->glyphs.push_back(glyphID);
         rejectedGlyphRun->positions.push_back(glyphPosition);
@@ -526,6 +560,109 @@ void RenderContext::drawGlyphsAsDirectMask(const GlyphRun& sourceGlyphRun, const
                               brush.makeWithMatrix(state.matrix));
   }
 }
+
+void RenderContext::drawGlyphsAsDistanceField(const GlyphRun& sourceGlyphRun,
+                                              const MCState& state, const Brush& brush,
+                                              const Stroke* stroke, const Rect& localClipBounds,
+                                              GlyphRun* rejectedGlyphRun) {
+  auto compositor = getOpsCompositor();
+  if (compositor == nullptr) {
+    return;
+  }
+  auto fontSize = sourceGlyphRun.font.getSize();
+  if (fontSize <= 0.0f) {
+    return;
+  }
+  // Unlike the direct masks, the glyphs are rasterized at the reference size regardless of the
+  // matrix, so they are not rasterized again while the matrix keeps changing.
+  auto font = sourceGlyphRun.font.makeWithSize(DistanceFieldReferenceSize);
+  auto referenceScale = DistanceFieldReferenceSize / fontSize;
+  auto inverseScale = 1.0f / referenceScale;
+  std::unique_ptr<Stroke> scaledStroke = nullptr;
+  if (stroke != nullptr) {
+    scaledStroke = std::make_unique<Stroke>(*stroke);
+    scaledStroke->width *= referenceScale;
+  }
+  static constexpr auto Spread = DistanceFieldRasterizer::Spread;
+  static const SamplingOptions FieldSampling(FilterMode::Linear, MipmapMode::None);
+  auto typeface = font.getTypeface();
+  AtlasCell atlasCell;
+  atlasCell.maskFormat = MaskFormat::SDF;
+  PlotUseUpdater plotUseUpdater;
+  auto atlasManager = getContext()->atlasManager();
+  auto drawingManager = getContext()->drawingManager();
+  auto nextFlushToken = atlasManager->nextFlushToken();
+  size_t index = 0;
+
+  for (auto& glyphID : sourceGlyphRun.glyphs) {
+    auto glyphPosition = sourceGlyphRun.positions[index++];
+    int maxDimension = 0;
+    if (!IsGlyphVisible(font, glyphID, localClipBounds, scaledStroke.get(), inverseScale,
+                        glyphPosition, &maxDimension)) {
+      continue;
+    }
+    if (maxDimension + 2 * Spread >= Atlas::MaxCellSize) {
+      rejectedGlyphRun->glyphs.push_back(glyphID);
+      rejectedGlyphRun->positions.push_back(glyphPosition);
+      continue;
+    }
+
+    auto& textureProxies = atlasManager->getTextureProxies(MaskFormat::SDF);
+    AtlasCellLocator glyphLocator;
+    auto& atlasLocator = glyphLocator.atlasLocator;
+    Point glyphOffset = {};
+    BytesKey glyphKey;
+    ComputeAtlasKey(font, font.scalerContext, GetTypefaceID(typeface.get(), typeface->isCustom()),
+                    glyphID, scaledStroke.get(), glyphKey);
+    if (atlasManager->getCellLocator(MaskFormat::SDF, glyphKey, glyphLocator)) {
+      glyphOffset = glyphLocator.offset;
+    } else {
+      std::shared_ptr<GlyphRasterizer> glyphRasterizer = nullptr;
+      auto glyphCodec = GetGlyphCodec(font, font.scalerContext, glyphID, scaledStroke.get(),
+                                      &glyphOffset, &glyphRasterizer);
+      auto fieldCodec = DistanceFieldRasterizer::MakeFrom(std::move(glyphCodec));
+      if (fieldCodec == nullptr) {
+        rejectedGlyphRun->glyphs.push_back(glyphID);
+        rejectedGlyphRun->positions.push_back(glyphPosition);
+        continue;
+      }
+      glyphOffset.x -= static_cast<float>(Spread);
+      glyphOffset.y -= static_cast<float>(Spread);
+      atlasCell.key = std::move(glyphKey);
+      atlasCell.offset = glyphOffset;
+      atlasCell.width = static_cast<uint16_t>(fieldCodec->width());
+      atlasCell.height = static_cast<uint16_t>(fieldCodec->height());
+      if (!atlasManager->addCellToAtlas(atlasCell, nextFlushToken, atlasLocator)) {
+        rejectedGlyphRun->glyphs.push_back(glyphID);
+        rejectedGlyphRun->positions.push_back(glyphPosition);
+        continue;
+      }
+      auto atlasOffset =
+          Point::Make(atlasLocator.getLocation().left, atlasLocator.getLocation().top);
+      auto plot = atlasManager->getPlot(MaskFormat::SDF, atlasLocator.plotLocator());
+      drawingManager->addAtlasCellTask(textureProxies[atlasLocator.pageIndex()], plot, atlasOffset,
+                                       std::move(fieldCodec));
+    }
+
+    atlasManager->setPlotUseToken(plotUseUpdater, atlasLocator.plotLocator(), MaskFormat::SDF,
+                                  nextFlushToken);
+    auto textureProxy = textureProxies[atlasLocator.pageIndex()];
+    if (textureProxy == nullptr) {
+      rejectedGlyphRun->glyphs.push_back(glyphID);
+      rejectedGlyphRun->positions.push_back(glyphPosition);
+      continue;
+    }
+
+    auto glyphState = state;
+    GetGlyphMatrix(font.scalerContext, glyphOffset, font.isFauxItalic(), &glyphState.matrix);
+    const auto rect = atlasLocator.getLocation();
+    ComputeGlyphFinalMatrix(rect, state.matrix, inverseScale, glyphPosition, &glyphState.matrix,
+                            false);
+    compositor->fillTextAtlas(std::move(textureProxy), rect, FieldSampling, glyphState,
+                              brush.makeWithMatrix(state.matrix), true);
+  }
+}
+
 void RenderContext::drawGlyphsAsPath(std::shared_ptr<GlyphRunList> glyphRunList,
                                      const MCState& state, const Brush& brush, const Stroke* stroke,
                                      Rect& localClipBounds) {
@@ -597,8 +734,9 @@ void RenderContext::drawGlyphsAsTransformedMask(const GlyphRun& sourceGlyphRun,
     if (atlasManager->getCellLocator(maskFormat, glyphKey, glyphLocator)) {
       glyphOffset = glyphLocator.offset;
     } else {
-      auto glyphCodec =
-          GetGlyphCodec(font, font.scalerContext, glyphID, scaledStroke.get(), &glyphOffset);
+      std::shared_ptr<GlyphRasterizer> glyphRasterizer = nullptr;
+      auto glyphCodec = GetGlyphCodec(font, font.scalerContext, glyphID, scaledStroke.get(),
+                                      &glyphOffset, &glyphRasterizer);
       if (glyphCodec == nullptr) {
         continue;
       }
@@ -613,7 +751,9 @@ void RenderContext::drawGlyphsAsTransformedMask(const GlyphRun& sourceGlyphRun,
       }
       auto pageIndex = atlasLocator.pageIndex();
       auto offset = Point::Make(atlasLocator.getLocation().left, atlasLocator.getLocation().top);
-      drawingManager->addAtlasCellTask(textureProxies[pageIndex], offset, std::move(glyphCodec));
+      auto plot = atlasManager->getPlot(maskFormat, atlasLocator.plotLocator());
+      AddGlyphToAtlas(drawingManager, textureProxies[pageIndex], plot, offset,
+                      std::move(glyphCodec), std::move(glyphRasterizer));
     }
     atlasManager->setPlotUseToken(plotUseUpdater, atlasLocator.plotLocator(), maskFormat,
                                   nextFlushToken);
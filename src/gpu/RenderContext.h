@@ -77,6 +77,10 @@ class RenderContext : public DrawContext {
                               const Brush& brush, const Stroke* stroke, const Rect& localClipBounds,
                               GlyphRun* rejectedGlyphRun);
 
+  void drawGlyphsAsDistanceField(const GlyphRun& sourceGlyphRun, const MCState& state,
+                                 const Brush& brush, const Stroke* stroke,
+                                 const Rect& localClipBounds, GlyphRun* rejectedGlyphRun);
+
   void drawGlyphsAsPath(std::shared_ptr<GlyphRunList> glyphRunList, const MCState& state,
                         const Brush& brush, const Stroke* stroke, Rect& localClipBounds);
 
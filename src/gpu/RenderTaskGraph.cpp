@@ -0,0 +1,513 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "RenderTaskGraph.h"
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include "core/RectPackSkyline.h"
+#include "core/utils/MathExtra.h"
+#include "gpu/ProxyProvider.h"
+#include "gpu/proxies/AtlasRenderTargetProxy.h"
+#include "gpu/tasks/OpsRenderTask.h"
+#include "tgfx/gpu/GPU.h"
+
+namespace tgfx {
+struct TaskNode {
+  const void* output = nullptr;
+  std::vector<const void*> inputs = {};
+  std::vector<size_t> dependents = {};
+  size_t dependencyCount = 0;
+  bool isProducer = false;
+};
+
+static void CullTasks(std::vector<PlacementPtr<RenderTask>>* renderTasks,
+                      std::vector<TaskNode>* nodes) {
+  auto& tasks = *renderTasks;
+  std::unordered_map<const void*, long> writerCounts = {};
+  for (auto& node : *nodes) {
+    if (node.output != nullptr) {
+      writerCounts[node.output]++;
+    }
+  }
+  // Walks backwards so that culling a reader also releases its references to the proxies written
+  // by earlier tasks, which may then be culled as well.
+  std::unordered_set<const void*> neededProxies = {};
+  for (auto i = tasks.size(); i > 0; --i) {
+    auto& task = tasks[i - 1];
+    auto& node = (*nodes)[i - 1];
+    if (node.output != nullptr && neededProxies.count(node.output) == 0 &&
+        task->isOutputTransient(writerCounts[node.output])) {
+      writerCounts[node.output]--;
+      task = nullptr;
+      continue;
+    }
+    neededProxies.insert(node.inputs.begin(), node.inputs.end());
+    if (node.output != nullptr) {
+      // Tasks that load the previous content of the proxy depend on the earlier writers.
+      neededProxies.insert(node.output);
+    }
+  }
+}
+
+static void BuildDependencies(const std::vector<PlacementPtr<RenderTask>>& tasks,
+                              std::vector<TaskNode>* nodes) {
+  std::unordered_map<const void*, size_t> lastWriters = {};
+  std::unordered_map<const void*, std::vector<size_t>> pendingReaders = {};
+  auto addDependency = [nodes](size_t from, size_t to) {
+    (*nodes)[from].dependents.push_back(to);
+    (*nodes)[to].dependencyCount++;
+  };
+  for (size_t i = 0; i < tasks.size(); i++) {
+    if (tasks[i] == nullptr) {
+      continue;
+    }
+    auto& node = (*nodes)[i];
+    for (auto& input : node.inputs) {
+      if (input == node.output) {
+        continue;
+      }
+      auto result = lastWriters.find(input);
+      if (result != lastWriters.end()) {
+        addDependency(result->second, i);
+        (*nodes)[result->second].isProducer = true;
+      }
+      pendingReaders[input].push_back(i);
+    }
+    if (node.output == nullptr) {
+      continue;
+    }
+    auto result = lastWriters.find(node.output);
+    if (result != lastWriters.end()) {
+      addDependency(result->second, i);
+    }
+    // The task must not overwrite the proxy before all previous readers are done with it.
+    auto& readers = pendingReaders[node.output];
+    for (auto& reader : readers) {
+      addDependency(reader, i);
+    }
+    readers.clear();
+    lastWriters[node.output] = i;
+  }
+}
+
+static std::vector<size_t> SortTasks(const std::vector<PlacementPtr<RenderTask>>& tasks,
+                                     std::vector<TaskNode>* nodes) {
+  std::vector<size_t> readyTasks = {};
+  for (size_t i = 0; i < tasks.size(); i++) {
+    if (tasks[i] != nullptr && (*nodes)[i].dependencyCount == 0) {
+      readyTasks.push_back(i);
+    }
+  }
+  std::vector<size_t> sortedTasks = {};
+  sortedTasks.reserve(tasks.size());
+  const void* lastOutput = nullptr;
+  while (!readyTasks.empty()) {
+    // Producers run first, so the tasks drawing into the same target can be merged afterward.
+    // Otherwise, prefer the task continuing on the last target, then the earliest recorded one.
+    size_t bestIndex = 0;
+    int bestRank = 3;
+    for (size_t i = 0; i < readyTasks.size(); i++) {
+      auto& node = (*nodes)[readyTasks[i]];
+      int rank = 2;
+      if (node.isProducer) {
+        rank = 0;
+      } else if (node.output != nullptr && node.output == lastOutput) {
+        rank = 1;
+      }
+      if (rank < bestRank || (rank == bestRank && readyTasks[i] < readyTasks[bestIndex])) {
+        bestRank = rank;
+        bestIndex = i;
+      }
+    }
+    auto taskIndex = readyTasks[bestIndex];
+    readyTasks.erase(readyTasks.begin() + static_cast<std::ptrdiff_t>(bestIndex));
+    sortedTasks.push_back(taskIndex);
+    auto& node = (*nodes)[taskIndex];
+    lastOutput = node.output;
+    for (auto& dependent : node.dependents) {
+      if (--(*nodes)[dependent].dependencyCount == 0) {
+        readyTasks.push_back(dependent);
+      }
+    }
+  }
+  return sortedTasks;
+}
+
+static void MergeTasks(std::vector<PlacementPtr<RenderTask>>* renderTasks,
+                       const std::vector<TaskNode>& nodes, const std::vector<size_t>& order) {
+  std::vector<PlacementPtr<RenderTask>> sortedTasks = {};
+  sortedTasks.reserve(order.size());
+  OpsRenderTask* lastOpsTask = nullptr;
+  for (auto& index : order) {
+    auto& task = (*renderTasks)[index];
+    auto opsTask = task->asOpsRenderTask();
+    if (opsTask == nullptr || lastOpsTask == nullptr ||
+        lastOpsTask->renderTarget() != opsTask->renderTarget()) {
+      lastOpsTask = opsTask;
+      sortedTasks.push_back(std::move(task));
+      continue;
+    }
+    if (opsTask->hasClearColor()) {
+      // The clear discards everything drawn by the previous task, and nothing reads the render
+      // target in between.
+      sortedTasks.back() = std::move(task);
+      lastOpsTask = opsTask;
+      continue;
+    }
+    auto& inputs = nodes[index].inputs;
+    if (std::find(inputs.begin(), inputs.end(), nodes[index].output) != inputs.end()) {
+      // The task samples its own render target, which requires the previous content to be
+      // resolved before it starts.
+      lastOpsTask = opsTask;
+      sortedTasks.push_back(std::move(task));
+      continue;
+    }
+    lastOpsTask->merge(opsTask);
+    task = nullptr;
+  }
+  *renderTasks = std::move(sortedTasks);
+}
+
+// Readers may sample the entries with linear filtering, which reaches one texel beyond the edges.
+// Two texels of padding keep those samples within the transparent gap between the entries.
+static constexpr int AtlasPadding = 2;
+static constexpr int MaxAtlasPageSize = 1024;
+
+struct AtlasEntry {
+  size_t taskIndex = 0;
+  AtlasRenderTargetProxy* proxy = nullptr;
+};
+
+static void CreateAtlasPage(std::vector<PlacementPtr<RenderTask>>* renderTasks,
+                            const std::vector<AtlasEntry>& entries,
+                            const std::vector<Point>& locations, int pageSize) {
+  if (entries.size() < 2) {
+    return;
+  }
+  auto firstProxy = entries.front().proxy;
+  auto context = firstProxy->getContext();
+  auto page = context->proxyProvider()->createRenderTargetProxy({}, pageSize, pageSize,
+                                                                firstProxy->format());
+  if (page == nullptr) {
+    return;
+  }
+  auto& tasks = *renderTasks;
+  auto headTask = tasks[entries.front().taskIndex]->asOpsRenderTask();
+  for (size_t i = 0; i < entries.size(); i++) {
+    auto& entry = entries[i];
+    entry.proxy->setAtlasPage(page, static_cast<int>(locations[i].x),
+                              static_cast<int>(locations[i].y));
+    if (i > 0) {
+      headTask->addAtlasTask(std::move(tasks[entry.taskIndex]));
+    }
+  }
+}
+
+static void PackAtlasEntries(std::vector<PlacementPtr<RenderTask>>* renderTasks,
+                             const std::vector<AtlasEntry>& entries) {
+  if (entries.size() < 2) {
+    return;
+  }
+  auto context = entries.front().proxy->getContext();
+  auto maxPageSize = std::min(MaxAtlasPageSize, context->gpu()->limits()->maxTextureDimension2D);
+  int area = 0;
+  int maxSize = 0;
+  for (auto& entry : entries) {
+    auto width = entry.proxy->width() + AtlasPadding;
+    auto height = entry.proxy->height() + AtlasPadding;
+    area += width * height;
+    maxSize = std::max(maxSize, std::max(width, height));
+  }
+  auto pageSize = NextPow2(static_cast<int>(std::ceil(std::sqrt(static_cast<float>(area)))));
+  pageSize = std::min(std::max(pageSize, NextPow2(maxSize)), maxPageSize);
+  if (maxSize > pageSize) {
+    return;
+  }
+  RectPackSkyline packer(pageSize, pageSize);
+  std::vector<AtlasEntry> pageEntries = {};
+  std::vector<Point> locations = {};
+  for (auto& entry : entries) {
+    auto width = entry.proxy->width() + AtlasPadding;
+    auto height = entry.proxy->height() + AtlasPadding;
+    Point location = {};
+    if (!packer.addRect(width, height, location)) {
+      // The page is full, start a new one for the remaining entries.
+      CreateAtlasPage(renderTasks, pageEntries, locations, pageSize);
+      pageEntries.clear();
+      locations.clear();
+      packer.reset();
+      packer.addRect(width, height, location);
+    }
+    pageEntries.push_back(entry);
+    locations.push_back(location);
+  }
+  CreateAtlasPage(renderTasks, pageEntries, locations, pageSize);
+}
+
+static AtlasRenderTargetProxy* GetAtlasProxy(RenderTask* task) {
+  auto opsTask = task->asOpsRenderTask();
+  if (opsTask == nullptr) {
+    return nullptr;
+  }
+  auto proxy = opsTask->renderTarget()->asAtlasRenderTargetProxy();
+  if (proxy == nullptr || !proxy->isPending() || !opsTask->isAtlasCompatible()) {
+    return nullptr;
+  }
+  return proxy;
+}
+
+static bool IsTransientAtlasProxy(AtlasRenderTargetProxy* proxy, long readerCount) {
+  // The render target proxy returned below holds one extra reference, and the task writing to the
+  // proxy holds another one. Any reference beyond those held by the tasks may read the content
+  // after the flush, e.g. through an image wrapping the proxy, which must not see the atlas page.
+  auto renderTarget = proxy->asRenderTargetProxy();
+  return renderTarget.use_count() <= readerCount + 2;
+}
+
+static void PackAtlasTasks(std::vector<PlacementPtr<RenderTask>>* renderTasks) {
+  auto& tasks = *renderTasks;
+  std::vector<std::vector<const void*>> inputs(tasks.size());
+  std::unordered_map<const void*, int> writerCounts = {};
+  std::unordered_map<const void*, long> readerCounts = {};
+  std::unordered_set<const void*> excludedProxies = {};
+  for (size_t i = 0; i < tasks.size(); i++) {
+    auto& task = tasks[i];
+    auto output = task->outputProxyID();
+    task->collectInputProxyIDs(&inputs[i]);
+    if (output != nullptr) {
+      writerCounts[output]++;
+    }
+    for (auto& input : inputs[i]) {
+      // Every draw op reading the proxy holds a reference to it.
+      readerCounts[input]++;
+    }
+    if (task->asOpsRenderTask() == nullptr) {
+      // Only draw ops know how to render into a region of the atlas page.
+      excludedProxies.insert(output);
+      excludedProxies.insert(inputs[i].begin(), inputs[i].end());
+    } else if (std::find(inputs[i].begin(), inputs[i].end(), output) != inputs[i].end()) {
+      excludedProxies.insert(output);
+    }
+  }
+  // Packs the runs of adjacent candidate tasks, which are independent of each other and thus can
+  // be drawn within the same render pass.
+  std::vector<AtlasEntry> entries = {};
+  std::unordered_set<const void*> runOutputs = {};
+  auto format = PixelFormat::Unknown;
+  for (size_t i = 0; i < tasks.size(); i++) {
+    auto proxy = GetAtlasProxy(tasks[i].get());
+    auto output = tasks[i]->outputProxyID();
+    if (proxy != nullptr && (writerCounts[output] != 1 || excludedProxies.count(output) > 0 ||
+                             !IsTransientAtlasProxy(proxy, readerCounts[output]))) {
+      proxy = nullptr;
+    }
+    bool continuesRun = proxy != nullptr && proxy->format() == format;
+    for (auto& input : inputs[i]) {
+      if (!continuesRun) {
+        break;
+      }
+      continuesRun = runOutputs.count(input) == 0;
+    }
+    if (!continuesRun) {
+      PackAtlasEntries(renderTasks, entries);
+      entries.clear();
+      runOutputs.clear();
+      format = proxy != nullptr ? proxy->format() : PixelFormat::Unknown;
+    }
+    if (proxy != nullptr) {
+      entries.push_back({i, proxy});
+      runOutputs.insert(output);
+    }
+  }
+  PackAtlasEntries(renderTasks, entries);
+  tasks.erase(std::remove_if(tasks.begin(), tasks.end(),
+                             [](const PlacementPtr<RenderTask>& task) { return task == nullptr; }),
+              tasks.end());
+}
+
+// A transient render target only takes over a released backing texture if the texture area is at
+// most this many times its own backing area.
+static constexpr int MaxAliasAreaRatio = 2;
+
+struct AliasEntry {
+  TextureProxy* proxy = nullptr;
+  PixelFormat format = PixelFormat::Unknown;
+  int sampleCount = 1;
+  size_t firstTask = 0;
+  size_t lastTask = 0;
+  long taskRefCount = 0;
+  bool excluded = false;
+};
+
+static TextureProxy* GetAliasProxy(OpsRenderTask* task) {
+  auto renderTarget = task->renderTarget();
+  if (renderTarget->externallyOwned() || renderTarget->origin() != ImageOrigin::TopLeft) {
+    return nullptr;
+  }
+  auto atlasProxy = renderTarget->asAtlasRenderTargetProxy();
+  if (atlasProxy != nullptr && atlasProxy->isPacked()) {
+    return nullptr;
+  }
+  auto textureProxy = renderTarget->asTextureProxy();
+  if (textureProxy == nullptr || textureProxy->backingFit() != BackingFit::Approx ||
+      textureProxy->isInstantiated() || textureProxy->hasMipmaps() ||
+      !textureProxy->getUniqueKey().empty()) {
+    return nullptr;
+  }
+  return textureProxy.get();
+}
+
+static std::vector<AliasEntry> CollectAliasEntries(
+    const std::vector<PlacementPtr<RenderTask>>& tasks) {
+  std::vector<AliasEntry> entries = {};
+  std::unordered_map<const void*, size_t> entryIndices = {};
+  std::vector<const void*> inputs = {};
+  for (size_t i = 0; i < tasks.size(); i++) {
+    auto& task = tasks[i];
+    auto opsTask = task->asOpsRenderTask();
+    inputs.clear();
+    task->collectInputProxyIDs(&inputs);
+    for (auto& input : inputs) {
+      auto result = entryIndices.find(input);
+      if (result == entryIndices.end()) {
+        // The proxy is read before being written in this flush, so it holds content from outside.
+        entryIndices[input] = entries.size();
+        entries.push_back({});
+        entries.back().excluded = true;
+        continue;
+      }
+      auto& entry = entries[result->second];
+      entry.lastTask = i;
+      // Every draw op reading the proxy holds a reference to it.
+      entry.taskRefCount++;
+      if (opsTask == nullptr) {
+        entry.excluded = true;
+      }
+    }
+    auto output = task->outputProxyID();
+    if (output == nullptr) {
+      continue;
+    }
+    auto result = entryIndices.find(output);
+    if (result == entryIndices.end()) {
+      entryIndices[output] = entries.size();
+      entries.push_back({});
+      auto& entry = entries.back();
+      if (opsTask != nullptr) {
+        entry.proxy = GetAliasProxy(opsTask);
+        entry.format = opsTask->renderTarget()->format();
+        entry.sampleCount = opsTask->renderTarget()->sampleCount();
+      }
+      entry.firstTask = i;
+      entry.excluded = entry.proxy == nullptr;
+      result = entryIndices.find(output);
+    }
+    auto& entry = entries[result->second];
+    entry.lastTask = i;
+    entry.taskRefCount++;
+    if (opsTask == nullptr) {
+      entry.excluded = true;
+    }
+  }
+  return entries;
+}
+
+static bool CanAlias(const AliasEntry& entry, const AliasEntry& released) {
+  auto proxy = entry.proxy;
+  auto releasedProxy = released.proxy;
+  if (entry.format != released.format || entry.sampleCount != released.sampleCount) {
+    return false;
+  }
+  auto width = releasedProxy->backingStoreWidth();
+  auto height = releasedProxy->backingStoreHeight();
+  if (width < proxy->width() || height < proxy->height()) {
+    return false;
+  }
+  auto area = static_cast<int64_t>(proxy->backingStoreWidth()) * proxy->backingStoreHeight();
+  return static_cast<int64_t>(width) * height <= area * MaxAliasAreaRatio;
+}
+
+static void AliasTransientTargets(const std::vector<PlacementPtr<RenderTask>>& tasks) {
+  auto entries = CollectAliasEntries(tasks);
+  std::vector<std::vector<size_t>> firstUses(tasks.size());
+  std::vector<std::vector<size_t>> lastUses(tasks.size());
+  for (size_t i = 0; i < entries.size(); i++) {
+    auto& entry = entries[i];
+    if (entry.excluded) {
+      continue;
+    }
+    // The render target proxy returned below holds one extra reference to the same proxy. Any
+    // reference beyond those held by the tasks may read the content after the flush.
+    auto renderTarget = entry.proxy->asRenderTargetProxy();
+    if (renderTarget.use_count() > entry.taskRefCount + 1) {
+      continue;
+    }
+    firstUses[entry.firstTask].push_back(i);
+    lastUses[entry.lastTask].push_back(i);
+  }
+  // Tasks and draw ops are released right after execution, so the backing texture of a transient
+  // target returns to the scratch pool once its last task is done. Resizing a later target to the
+  // same backing size makes it pick up that texture instead of allocating a new one.
+  std::vector<size_t> releasedEntries = {};
+  for (size_t i = 0; i < tasks.size(); i++) {
+    for (auto& index : firstUses[i]) {
+      auto& entry = entries[index];
+      auto bestPosition = releasedEntries.end();
+      int64_t bestArea = 0;
+      for (auto position = releasedEntries.begin(); position != releasedEntries.end(); ++position) {
+        auto& released = entries[*position];
+        if (!CanAlias(entry, released)) {
+          continue;
+        }
+        auto area = static_cast<int64_t>(released.proxy->backingStoreWidth()) *
+                    released.proxy->backingStoreHeight();
+        if (bestPosition == releasedEntries.end() || area < bestArea) {
+          bestPosition = position;
+          bestArea = area;
+        }
+      }
+      if (bestPosition != releasedEntries.end()) {
+        auto releasedProxy = entries[*bestPosition].proxy;
+        entry.proxy->setBackingStoreSize(releasedProxy->backingStoreWidth(),
+                                         releasedProxy->backingStoreHeight());
+        releasedEntries.erase(bestPosition);
+      }
+    }
+    releasedEntries.insert(releasedEntries.end(), lastUses[i].begin(), lastUses[i].end());
+  }
+}
+
+void RenderTaskGraph::Optimize(std::vector<PlacementPtr<RenderTask>>* renderTasks) {
+  if (renderTasks->empty()) {
+    return;
+  }
+  std::vector<TaskNode> nodes(renderTasks->size());
+  for (size_t i = 0; i < renderTasks->size(); i++) {
+    auto& task = (*renderTasks)[i];
+    nodes[i].output = task->outputProxyID();
+    task->collectInputProxyIDs(&nodes[i].inputs);
+  }
+  CullTasks(renderTasks, &nodes);
+  BuildDependencies(*renderTasks, &nodes);
+  auto order = SortTasks(*renderTasks, &nodes);
+  MergeTasks(renderTasks, nodes, order);
+  PackAtlasTasks(renderTasks);
+  AliasTransientTargets(*renderTasks);
+}
+}  // namespace tgfx
@@ -0,0 +1,44 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <vector>
+#include "core/utils/PlacementPtr.h"
+#include "gpu/tasks/RenderTask.h"
+
+namespace tgfx {
+/**
+ * RenderTaskGraph builds a dependency graph over the render tasks of a flush from the proxies each
+ * task reads and writes, and uses it to reduce the number of render passes. Tasks whose outputs
+ * are never read are culled, independent tasks are reordered so that offscreen producers run
+ * before the tasks drawing into the final targets, and adjacent OpsRenderTasks drawing into the
+ * same render target are merged into one. Then, small transient render targets drawn by adjacent
+ * tasks are packed into shared atlas pages, so each page is drawn in a single pass. Finally,
+ * transient render targets whose lifetimes don't overlap are assigned the same backing size, so
+ * they share one scratch texture within the flush.
+ */
+class RenderTaskGraph {
+ public:
+  /**
+   * Culls, reorders, merges, packs, and aliases the given render tasks in place. The relative order
+   * of any two tasks accessing the same proxy is always preserved.
+   */
+  static void Optimize(std::vector<PlacementPtr<RenderTask>>* renderTasks);
+};
+}  // namespace tgfx
@@ -17,6 +17,8 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "gpu/ResourceCache.h"
+#include <algorithm>
+#include <limits>
 #include <unordered_map>
 #include "core/utils/Log.h"
 #include "gpu/resources/Resource.h"
@@ -25,6 +27,12 @@ namespace tgfx {
 static constexpr size_t MAX_EXPIRATION_FRAMES = 1000000;  // About 4.5 hours at 60 FPS
 static constexpr size_t SCRATCH_EXPIRATION_FRAMES = 2;
 
+std::array<size_t, ResourceCache::CategoryCount> ResourceCache::MakeCategoryLimits() {
+  std::array<size_t, CategoryCount> limits = {};
+  limits.fill(std::numeric_limits<size_t>::max());
+  return limits;
+}
+
 ResourceCache::ResourceCache(Context* context) : context(context) {
 }
 
@@ -44,6 +52,15 @@ void ResourceCache::setCacheLimit(size_t bytesLimit) {
   purgeAsNeeded();
 }
 
+void ResourceCache::setCacheLimit(ResourceCategory category, size_t bytesLimit) {
+  auto& limit = categoryLimits[static_cast<size_t>(category)];
+  if (limit == bytesLimit) {
+    return;
+  }
+  limit = bytesLimit;
+  purgeAsNeeded();
+}
+
 void ResourceCache::setExpirationFrames(size_t frames) {
   if (frames > MAX_EXPIRATION_FRAMES) {
     frames = MAX_EXPIRATION_FRAMES;
@@ -66,7 +83,7 @@ void ResourceCache::purgeNotUsedSince(std::chrono::steady_clock::time_point purg
 
 bool ResourceCache::purgeUntilMemoryTo(size_t bytesLimit) {
   processUnreferencedResources();
-  purgeResourcesByLRU(false, [&](Resource*) { return totalBytes <= bytesLimit; });
+  purgeResourcesByCost(bytesLimit);
   return totalBytes <= bytesLimit;
 }
 
@@ -83,12 +100,10 @@ void ResourceCache::purgeAsNeeded() {
   processUnreferencedResources();
   if (frameTimes.size() > _expirationFrames) {
     auto purgeTime = frameTimes[frameTimes.size() - _expirationFrames - 1];
-    purgeResourcesByLRU(false, [&](Resource* resource) {
-      return resource->lastUsedTime > purgeTime && totalBytes <= maxBytes;
-    });
-  } else {
-    purgeResourcesByLRU(false, [&](Resource*) { return totalBytes <= maxBytes; });
+    purgeResourcesByLRU(false,
+                        [&](Resource* resource) { return resource->lastUsedTime > purgeTime; });
   }
+  purgeResourcesByCost(maxBytes);
   if (frameTimes.size() > SCRATCH_EXPIRATION_FRAMES) {
     auto purgeTime = frameTimes[frameTimes.size() - SCRATCH_EXPIRATION_FRAMES - 1];
     purgeResourcesByLRU(true,
@@ -124,6 +139,51 @@ void ResourceCache::purgeResourcesByLRU(bool scratchResourceOnly,
   }
 }
 
+bool ResourceCache::isOverBudget(size_t bytesLimit) const {
+  if (totalBytes > bytesLimit) {
+    return true;
+  }
+  for (size_t i = 0; i < CategoryCount; i++) {
+    if (categoryBytes[i] > categoryLimits[i]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ResourceCache::purgeResourcesByCost(size_t bytesLimit) {
+  if (!isOverBudget(bytesLimit)) {
+    return;
+  }
+  // Purging by recency alone would throw away large resources that are expensive to regenerate,
+  // such as decoded images, as often as cheap scratch render targets. Purge the resources with the
+  // lowest regeneration cost per byte first, and the least recently used ones among equal costs.
+  std::vector<std::pair<double, Resource*>> candidates = {};
+  candidates.reserve(purgeableResources.size());
+  for (auto& resource : purgeableResources) {
+    auto bytes = std::max(resource->memoryUsage(), static_cast<size_t>(1));
+    auto costPerByte = static_cast<double>(resource->regenerationCost()) / bytes;
+    candidates.emplace_back(costPerByte, resource);
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const std::pair<double, Resource*>& a,
+                      const std::pair<double, Resource*>& b) { return a.first < b.first; });
+  for (auto& candidate : candidates) {
+    auto resource = candidate.second;
+    auto category = static_cast<size_t>(resource->category());
+    if (totalBytes <= bytesLimit && categoryBytes[category] <= categoryLimits[category]) {
+      if (!isOverBudget(bytesLimit)) {
+        break;
+      }
+      // Only other categories are still over their limits.
+      continue;
+    }
+    RemoveFromList(purgeableResources, resource);
+    purgeableBytes -= resource->memoryUsage();
+    removeResource(resource);
+  }
+}
+
 void ResourceCache::processUnreferencedResources() {
   while (auto resource = static_cast<Resource*>(returnQueue->dequeue())) {
     DEBUG_ASSERT(resource->isPurgeable());
@@ -153,6 +213,7 @@ void ResourceCache::releaseAll() {
   uniqueKeyMap.clear();
   purgeableBytes = 0;
   totalBytes = 0;
+  categoryBytes.fill(0);
 }
 
 std::shared_ptr<Resource> ResourceCache::findScratchResource(const ScratchKey& scratchKey) {
@@ -242,6 +303,7 @@ std::shared_ptr<Resource> ResourceCache::addResource(Resource* resource,
     scratchKeyMap[resource->scratchKey].push_back(resource);
   }
   totalBytes += resource->memoryUsage();
+  categoryBytes[static_cast<size_t>(resource->category())] += resource->memoryUsage();
   AddToList(nonpurgeableResources, resource);
   auto reference = std::static_pointer_cast<Resource>(returnQueue->makeShared(resource));
   reference->weakThis = reference;
@@ -277,6 +339,7 @@ void ResourceCache::removeResource(Resource* resource) {
     }
   }
   totalBytes -= resource->memoryUsage();
+  categoryBytes[static_cast<size_t>(resource->category())] -= resource->memoryUsage();
   delete resource;
 }
 }  // namespace tgfx
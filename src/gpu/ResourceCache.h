@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <array>
 #include <deque>
 #include <functional>
 #include <list>
@@ -25,6 +26,7 @@
 #include "core/utils/ReturnQueue.h"
 #include "gpu/resources/ResourceKey.h"
 #include "tgfx/gpu/Context.h"
+#include "tgfx/gpu/ResourceCategory.h"
 
 namespace tgfx {
 class Resource;
@@ -50,6 +52,13 @@ class ResourceCache {
     return totalBytes;
   }
 
+  /**
+   * Returns the number of bytes consumed by resources of the given category.
+   */
+  size_t getResourceBytes(ResourceCategory category) const {
+    return categoryBytes[static_cast<size_t>(category)];
+  }
+
   /**
    * Returns the number of bytes held by purgeable resources.
    */
@@ -70,6 +79,20 @@ class ResourceCache {
    */
   void setCacheLimit(size_t bytesLimit);
 
+  /**
+   * Returns the cache limit in bytes for the given category of resources. The default value is
+   * SIZE_MAX, which leaves the category bounded by the overall cache limit only.
+   */
+  size_t cacheLimit(ResourceCategory category) const {
+    return categoryLimits[static_cast<size_t>(category)];
+  }
+
+  /**
+   * Sets the cache limit in bytes for the given category of resources. If the category exceeds the
+   * new limit, the cache will try to free its resources to get under the limit.
+   */
+  void setCacheLimit(ResourceCategory category, size_t bytesLimit);
+
   /**
    * Returns the number of frames (valid flushes) after which unused GPU resources are considered
    * expired. A 'frame' is defined as a non-empty flush where actual rendering work is performed and
@@ -94,8 +117,9 @@ class ResourceCache {
 
   /**
    * Purges GPU resources from the cache until the specified bytesLimit is reached, or until all
-   * purgeable resources have been removed. Returns true if the total resource usage does not exceed
-   * bytesLimit after purging.
+   * purgeable resources have been removed. The resources with the lowest regeneration cost per byte
+   * are purged first. Returns true if the total resource usage does not exceed bytesLimit after
+   * purging.
    * @param bytesLimit The target maximum number of bytes after purging.
    */
   bool purgeUntilMemoryTo(size_t bytesLimit);
@@ -132,6 +156,9 @@ class ResourceCache {
   size_t maxBytes = 512 * (1 << 20);  // 512MB
   size_t totalBytes = 0;
   size_t purgeableBytes = 0;
+  static constexpr size_t CategoryCount = static_cast<size_t>(ResourceCategory::Other) + 1;
+  std::array<size_t, CategoryCount> categoryBytes = {};
+  std::array<size_t, CategoryCount> categoryLimits = MakeCategoryLimits();
   // 120 is chosen because a 4K screen can be divided into roughly 120 grids of 256x256 pixels.
   // If each grid is rendered per frame, the cache should cover this use case.
   size_t _expirationFrames = 120;
@@ -143,6 +170,7 @@ class ResourceCache {
   ResourceKeyMap<std::vector<Resource*>> scratchKeyMap = {};
   ResourceKeyMap<Resource*> uniqueKeyMap = {};
 
+  static std::array<size_t, CategoryCount> MakeCategoryLimits();
   static void AddToList(std::list<Resource*>& list, Resource* resource);
   static void RemoveFromList(std::list<Resource*>& list, Resource* resource);
 
@@ -153,6 +181,8 @@ class ResourceCache {
   void removeResource(Resource* resource);
   void purgeResourcesByLRU(bool scratchResourceOnly,
                            const std::function<bool(Resource*)>& satisfied);
+  bool isOverBudget(size_t bytesLimit) const;
+  void purgeResourcesByCost(size_t bytesLimit);
 
   void changeUniqueKey(Resource* resource, const UniqueKey& uniqueKey);
   void removeUniqueKey(Resource* resource);
@@ -0,0 +1,102 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "StreamingBufferAllocator.h"
+#include <algorithm>
+#include "core/utils/Log.h"
+#include "gpu/AlignTo.h"
+#include "tgfx/gpu/GPU.h"
+
+namespace tgfx {
+StreamingBufferAllocator::StreamingBufferAllocator(Context* context, uint32_t usage,
+                                                   size_t blockSize, size_t alignment)
+    : context(context), usage(usage), blockSize(blockSize),
+      alignment(alignment > 0 ? alignment : 1) {
+}
+
+std::shared_ptr<GPUBuffer> StreamingBufferAllocator::allocate(size_t size, size_t* offset) {
+  if (size == 0) {
+    return nullptr;
+  }
+  auto alignedSize = AlignTo(size, alignment);
+  auto& frame = frames[frameIndex];
+  // Skip to the next buffer of the frame until one has enough space left.
+  while (frame.bufferIndex < frame.buffers.size() &&
+         frame.cursor + alignedSize > frame.buffers[frame.bufferIndex]->size()) {
+    frame.bufferIndex++;
+    frame.cursor = 0;
+  }
+  if (frame.bufferIndex >= frame.buffers.size()) {
+    auto buffer = context->gpu()->createBuffer(std::max(alignedSize, blockSize), usage);
+    if (buffer == nullptr) {
+      LOGE("StreamingBufferAllocator::allocate() Failed to create buffer, request size: %zu", size);
+      return nullptr;
+    }
+    frame.buffers.push_back(std::move(buffer));
+    frame.bufferIndex = frame.buffers.size() - 1;
+    frame.cursor = 0;
+    trackBufferCount();
+  }
+  *offset = frame.cursor;
+  frame.cursor += alignedSize;
+  return frame.buffers[frame.bufferIndex];
+}
+
+void StreamingBufferAllocator::advanceFrame() {
+  auto queue = context->gpu()->queue();
+  auto& retiredFrame = frames[frameIndex];
+  auto usedBufferCount = std::min(retiredFrame.bufferIndex + 1, retiredFrame.buffers.size());
+  for (size_t i = 0; i < usedBufferCount; i++) {
+    queue->insertFence(retiredFrame.buffers[i]);
+  }
+  frameIndex = (frameIndex + 1) % FRAME_COUNT;
+  auto& frame = frames[frameIndex];
+  // The GPU is more than FRAME_COUNT flushes behind if a fence hasn't signaled yet. Drop those
+  // buffers instead of waiting for them, and let the group grow new ones while the GPU catches up.
+  auto& buffers = frame.buffers;
+  buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                               [](const std::shared_ptr<GPUBuffer>& buffer) {
+                                 return !buffer->isReady();
+                               }),
+                buffers.end());
+  auto maxBufferCount = maxBufferCountTracker.getMaxValue();
+  if (maxBufferCount > 0 && frame.buffers.size() > maxBufferCount) {
+    frame.buffers.resize(maxBufferCount);
+  }
+  frame.bufferIndex = 0;
+  frame.cursor = 0;
+}
+
+size_t StreamingBufferAllocator::memoryUsage() const {
+  size_t totalBytes = 0;
+  for (const auto& frame : frames) {
+    for (const auto& buffer : frame.buffers) {
+      totalBytes += buffer->size();
+    }
+  }
+  return totalBytes;
+}
+
+void StreamingBufferAllocator::trackBufferCount() {
+  size_t totalBufferCount = 0;
+  for (const auto& frame : frames) {
+    totalBufferCount += frame.buffers.size();
+  }
+  maxBufferCountTracker.addValue((totalBufferCount + FRAME_COUNT - 1) / FRAME_COUNT);
+}
+}  // namespace tgfx
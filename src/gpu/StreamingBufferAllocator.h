@@ -0,0 +1,87 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include "core/utils/SlidingWindowTracker.h"
+#include "tgfx/gpu/Context.h"
+#include "tgfx/gpu/GPUBuffer.h"
+
+namespace tgfx {
+/**
+ * StreamingBufferAllocator suballocates transient per-flush data, such as vertices and uniforms,
+ * from a few large GPU buffers instead of creating new buffers for every flush. The buffers are
+ * split into FRAME_COUNT groups that are used in turn, one group per flush, so the regions written
+ * for the current flush never overlap the ones the GPU may still be reading from the previous
+ * flushes. Since the buffers are mapped without synchronization, a fence is inserted when a group
+ * is retired, and the buffers whose fence hasn't signaled yet are replaced before the group is
+ * reused.
+ */
+class StreamingBufferAllocator {
+ public:
+  /**
+   * The number of flushes a region stays untouched after being written.
+   */
+  static constexpr size_t FRAME_COUNT = 3;
+
+  /**
+   * Creates a StreamingBufferAllocator with the specified buffer usage, the size of each GPU
+   * buffer, and the alignment of the returned offsets.
+   */
+  StreamingBufferAllocator(Context* context, uint32_t usage, size_t blockSize, size_t alignment);
+
+  /**
+   * Allocates a region of the specified size for the current flush. Returns the GPU buffer holding
+   * the region and writes the offset of the region within the buffer to the offset parameter. A
+   * dedicated buffer is created if the size exceeds the block size. Returns nullptr if the buffer
+   * creation fails.
+   */
+  std::shared_ptr<GPUBuffer> allocate(size_t size, size_t* offset);
+
+  /**
+   * Fences the buffers of the current flush and switches to the buffers of the next flush,
+   * trimming the ones that haven't been needed recently. Must be called once the commands of the
+   * current flush are submitted.
+   */
+  void advanceFrame();
+
+  /**
+   * Returns the total size of the GPU buffers held by the allocator.
+   */
+  size_t memoryUsage() const;
+
+ private:
+  struct Frame {
+    std::vector<std::shared_ptr<GPUBuffer>> buffers = {};
+    size_t bufferIndex = 0;
+    size_t cursor = 0;
+  };
+
+  Context* context = nullptr;
+  uint32_t usage = 0;
+  size_t blockSize = 0;
+  size_t alignment = 1;
+  std::array<Frame, FRAME_COUNT> frames = {};
+  size_t frameIndex = 0;
+  SlidingWindowTracker maxBufferCountTracker = {10};
+
+  void trackBufferCount();
+};
+}  // namespace tgfx
@@ -21,17 +21,22 @@
 #include "inspect/InspectorMark.h"
 
 namespace tgfx {
-UniformData::UniformData(std::vector<Uniform> uniforms) : _uniforms(std::move(uniforms)) {
-  for (const auto& uniform : _uniforms) {
-    size_t size = 0;
-    size_t align = 0;
-    const auto& [entrySize, entryAlign] = EntryOf(uniform.format());
-    size = entrySize;
-    align = entryAlign;
-
+UniformData::UniformData(std::vector<Uniform> uniforms, const std::vector<std::string>& keys,
+                         const std::vector<int>& processorIndices)
+    : _uniforms(std::move(uniforms)) {
+  DEBUG_ASSERT(keys.size() == _uniforms.size() && processorIndices.size() == _uniforms.size());
+  fields.reserve(_uniforms.size());
+  for (size_t i = 0; i < _uniforms.size(); i++) {
+    const auto& uniform = _uniforms[i];
+    const auto& [size, align] = EntryOf(uniform.format());
     const size_t offset = alignCursor(align);
-    fieldMap[uniform.name()] = {uniform.name(), uniform.format(), offset, size, align};
+    fields.push_back({uniform.name(), keys[i], uniform.format(), offset, size, align});
     cursor = offset + size;
+    auto slot = static_cast<size_t>(processorIndices[i] + 1);
+    if (slot >= processorFields.size()) {
+      processorFields.resize(slot + 1);
+    }
+    processorFields[slot].push_back(i);
   }
 
   bufferSize = alignCursor(16);
@@ -41,26 +46,31 @@ void UniformData::setBuffer(void* buffer) {
   _buffer = static_cast<uint8_t*>(buffer);
 }
 
-void UniformData::onSetData(const std::string& name, const void* data, size_t size) const {
+void UniformData::onSetData(std::string_view name, const void* data, size_t size) const {
   DEBUG_ASSERT(_buffer != nullptr);
 
-  const auto& key = name + nameSuffix;
-  auto field = findField(key);
+  auto field = findField(name);
 
   if (field == nullptr) {
-    LOGE("UniformData::onSetData() uniform '%s' not found!", name.c_str());
+    LOGE("UniformData::onSetData() uniform '%s' not found!", std::string(name).c_str());
     return;
   }
   DEBUG_ASSERT(field->size == size);
 
-  UNIFORM_VALUE(key, data, size);
+  UNIFORM_VALUE(field->name, data, size);
   memcpy(_buffer + field->offset, data, size);
 }
 
-const UniformData::Field* UniformData::findField(const std::string& key) const {
-  const auto& iter = fieldMap.find(key);
-  if (iter != fieldMap.end()) {
-    return &iter->second;
+const UniformData::Field* UniformData::findField(std::string_view key) const {
+  auto slot = static_cast<size_t>(processorIndex + 1);
+  if (slot >= processorFields.size()) {
+    return nullptr;
+  }
+  for (auto& index : processorFields[slot]) {
+    auto& field = fields[index];
+    if (field.key == key) {
+      return &field;
+    }
   }
   return nullptr;
 }
@@ -140,17 +150,10 @@ const char* UniformData::ToUniformFormatName(UniformFormat format) {
 
 void UniformData::dump() const {
   LOGI("\n-------------- UniformData Layout dump begin --------------");
-  std::vector<Field> sortedFields;
-  sortedFields.reserve(fieldMap.size());
-  for (const auto& [name, field] : fieldMap) {
-    sortedFields.push_back(field);
-  }
-  std::sort(sortedFields.begin(), sortedFields.end(),
-            [](const Field& a, const Field& b) { return a.offset < b.offset; });
-  for (size_t i = 0; i < sortedFields.size(); ++i) {
+  for (size_t i = 0; i < fields.size(); ++i) {
     LOGI("%4zu: %-10s offset=%4zu, size=%4zu, align=%2zu, name=%s", i,
-         ToUniformFormatName(sortedFields[i].format), sortedFields[i].offset, sortedFields[i].size,
-         sortedFields[i].align, sortedFields[i].name.c_str());
+         ToUniformFormatName(fields[i].format), fields[i].offset, fields[i].size, fields[i].align,
+         fields[i].name.c_str());
   }
   LOGI("Total buffer size = %zu bytes", size());
   LOGI("-------------- UniformData Layout dump end --------------\n");
@@ -20,7 +20,7 @@
 
 #include <memory>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 #include "gpu/Uniform.h"
 #include "tgfx/core/Color.h"
@@ -49,7 +49,7 @@ class UniformData {
                        !std::is_same_v<std::decay_t<T>, Matrix> &&
                        !std::is_same_v<std::decay_t<T>, ColorMatrix33>,
                    void>
-  setData(const std::string& name, const T& value) const {
+  setData(std::string_view name, const T& value) const {
     onSetData(name, &value, sizeof(value));
   }
 
@@ -57,7 +57,7 @@ class UniformData {
    * Convenience method for copying a Matrix to a 3x3 matrix in column-major order.
    */
   template <typename T>
-  std::enable_if_t<std::is_same_v<std::decay_t<T>, Matrix>, void> setData(const std::string& name,
+  std::enable_if_t<std::is_same_v<std::decay_t<T>, Matrix>, void> setData(std::string_view name,
                                                                           const T& matrix) const {
     float values[6] = {};
     matrix.get6(values);
@@ -74,7 +74,7 @@ class UniformData {
 
   template <typename T>
   std::enable_if_t<std::is_same_v<std::decay_t<T>, ColorMatrix33>, void> setData(
-      const std::string& name, const T& matrix) const {
+      std::string_view name, const T& matrix) const {
 
     // clang-format off
       const float data[] = {
@@ -110,6 +110,7 @@ class UniformData {
  private:
   struct Field {
     std::string name = "";
+    std::string key = "";
     UniformFormat format = UniformFormat::Float;
     size_t offset = 0;
     size_t size = 0;
@@ -124,15 +125,29 @@ class UniformData {
   uint8_t* _buffer = nullptr;
   size_t bufferSize = 0;
   std::vector<Uniform> _uniforms = {};
-  std::string nameSuffix = "";
-  std::unordered_map<std::string, Field> fieldMap = {};
+  std::vector<Field> fields = {};
+  // The indices of the fields declared by each processor, indexed by the processor index plus one,
+  // so that the uniforms declared outside any processor are at the front.
+  std::vector<std::vector<size_t>> processorFields = {};
+  int processorIndex = -1;
   size_t cursor = 0;
 
-  explicit UniformData(std::vector<Uniform> uniforms);
+  /**
+   * Creates a UniformData from the given uniforms. The keys are the unmangled names used by the
+   * processors to set the uniforms, and the processorIndices are the indices of the processors
+   * declaring them, or -1 if a uniform is declared outside any processor.
+   */
+  UniformData(std::vector<Uniform> uniforms, const std::vector<std::string>& keys,
+              const std::vector<int>& processorIndices);
 
-  void onSetData(const std::string& name, const void* data, size_t size) const;
+  void onSetData(std::string_view name, const void* data, size_t size) const;
 
-  const Field* findField(const std::string& key) const;
+  /**
+   * Returns the field declared by the current processor with the given unmangled name. This is
+   * resolved through a short list per processor, which avoids building the mangled name for every
+   * uniform write.
+   */
+  const Field* findField(std::string_view key) const;
 
   size_t alignCursor(size_t alignment) const;
 
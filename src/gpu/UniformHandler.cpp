@@ -26,12 +26,17 @@ static constexpr char OES_TEXTURE_EXTENSION[] = "GL_OES_EGL_image_external_essl3
 std::string UniformHandler::addUniform(const std::string& name, UniformFormat format,
                                        ShaderStage stage) {
   auto uniformName = programBuilder->nameVariable(name);
+  auto processorIndex = programBuilder->currentProcessorIndex();
   switch (stage) {
     case ShaderStage::Vertex:
       vertexUniforms.emplace_back(uniformName, format);
+      vertexUniformKeys.push_back(name);
+      vertexProcessorIndices.push_back(processorIndex);
       break;
     case ShaderStage::Fragment:
       fragmentUniforms.emplace_back(uniformName, format);
+      fragmentUniformKeys.push_back(name);
+      fragmentProcessorIndices.push_back(processorIndex);
       break;
   }
   return uniformName;
@@ -75,8 +80,12 @@ std::unique_ptr<UniformData> UniformHandler::makeUniformData(ShaderStage stage)
     return nullptr;
   }
 
+  if (stage == ShaderStage::Vertex) {
+    return std::unique_ptr<UniformData>(
+        new UniformData(vertexUniforms, vertexUniformKeys, vertexProcessorIndices));
+  }
   return std::unique_ptr<UniformData>(
-      new UniformData(stage == ShaderStage::Vertex ? vertexUniforms : fragmentUniforms));
+      new UniformData(fragmentUniforms, fragmentUniformKeys, fragmentProcessorIndices));
 }
 
 std::string UniformHandler::getUniformDeclarations(ShaderStage stage) const {
@@ -76,7 +76,11 @@ class UniformHandler {
   // This is not owned by the class
   ProgramBuilder* programBuilder = nullptr;
   std::vector<Uniform> vertexUniforms = {};
+  std::vector<std::string> vertexUniformKeys = {};
+  std::vector<int> vertexProcessorIndices = {};
   std::vector<Uniform> fragmentUniforms = {};
+  std::vector<std::string> fragmentUniformKeys = {};
+  std::vector<int> fragmentProcessorIndices = {};
   std::vector<Uniform> samplers = {};
   std::vector<Swizzle> samplerSwizzles = {};
 };
@@ -18,6 +18,8 @@
 
 #include "GLSLProgramBuilder.h"
 #include <string>
+#include "gpu/GlobalCache.h"
+#include "gpu/PipelineRecipe.h"
 #include "gpu/UniformData.h"
 #include "tgfx/gpu/GPU.h"
 
@@ -105,12 +107,13 @@ static std::string SLTypeString(SLType t) {
 }
 
 std::shared_ptr<Program> ProgramBuilder::CreateProgram(Context* context,
-                                                       const ProgramInfo* programInfo) {
+                                                       const ProgramInfo* programInfo,
+                                                       std::string* recipe) {
   GLSLProgramBuilder builder(context, programInfo);
   if (!builder.emitAndInstallProcessors()) {
     return nullptr;
   }
-  return builder.finalize();
+  return builder.finalize(recipe);
 }
 
 GLSLProgramBuilder::GLSLProgramBuilder(Context* context, const ProgramInfo* programInfo)
@@ -164,28 +167,14 @@ std::string GLSLProgramBuilder::getUniformBlockDeclaration(
   return result;
 }
 
-std::shared_ptr<Program> GLSLProgramBuilder::finalize() {
+std::shared_ptr<Program> GLSLProgramBuilder::finalize(std::string* recipeKey) {
   fragmentShaderBuilder()->declareCustomOutputColor();
   finalizeShaders();
-  auto gpu = context->gpu();
-  ShaderModuleDescriptor vertexModule = {};
-  vertexModule.code = vertexShaderBuilder()->shaderString();
-  vertexModule.stage = ShaderStage::Vertex;
-  auto vertexShader = gpu->createShaderModule(vertexModule);
-  if (vertexShader == nullptr) {
-    return nullptr;
-  }
-  ShaderModuleDescriptor fragmentModule = {};
-  fragmentModule.code = fragmentShaderBuilder()->shaderString();
-  fragmentModule.stage = ShaderStage::Fragment;
-  auto fragmentShader = gpu->createShaderModule(fragmentModule);
-  if (fragmentShader == nullptr) {
-    return nullptr;
-  }
-  RenderPipelineDescriptor descriptor = {};
+  PipelineRecipe recipe = {};
+  recipe.vertexCode = vertexShaderBuilder()->shaderString();
+  recipe.fragmentCode = fragmentShaderBuilder()->shaderString();
+  auto& descriptor = recipe.descriptor;
   descriptor.vertex = {programInfo->getVertexAttributes()};
-  descriptor.vertex.module = vertexShader;
-  descriptor.fragment.module = fragmentShader;
   descriptor.fragment.colorAttachments.push_back(programInfo->getPipelineColorAttachment());
   auto vertexUniformData = _uniformHandler.makeUniformData(ShaderStage::Vertex);
   auto fragmentUniformData = _uniformHandler.makeUniformData(ShaderStage::Fragment);
@@ -206,9 +195,14 @@ std::shared_ptr<Program> GLSLProgramBuilder::finalize() {
   // default Y-axis direction (upward). Therefore, it is necessary to define the clockwise
   // direction as the front face, which is the opposite of OpenGL's default.
   descriptor.primitive = {programInfo->getCullMode(), FrontFace::CW};
-  auto pipeline = gpu->createRenderPipeline(descriptor);
+  descriptor.depthStencil = programInfo->getDepthStencil();
+  *recipeKey = recipe.encode();
+  auto pipeline = context->globalCache()->takePrecompiledPipeline(*recipeKey);
   if (pipeline == nullptr) {
-    return nullptr;
+    pipeline = recipe.makePipeline(context);
+    if (pipeline == nullptr) {
+      return nullptr;
+    }
   }
   return std::make_shared<Program>(std::move(pipeline), std::move(vertexUniformData),
                                    std::move(fragmentUniformData));
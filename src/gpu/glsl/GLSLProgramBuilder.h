@@ -38,7 +38,7 @@ class GLSLProgramBuilder : public ProgramBuilder {
  private:
   GLSLProgramBuilder(Context* context, const ProgramInfo* programInfo);
 
-  std::shared_ptr<Program> finalize();
+  std::shared_ptr<Program> finalize(std::string* recipeKey);
 
   UniformHandler* uniformHandler() override {
     return &_uniformHandler;
@@ -17,19 +17,21 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GLSLAtlasTextGeometryProcessor.h"
+#include "core/DistanceFieldRasterizer.h"
 
 namespace tgfx {
 PlacementPtr<AtlasTextGeometryProcessor> AtlasTextGeometryProcessor::Make(
     BlockAllocator* allocator, std::shared_ptr<TextureProxy> textureProxy, AAType aa,
-    std::optional<PMColor> commonColor, const SamplingOptions& sampling) {
+    std::optional<PMColor> commonColor, const SamplingOptions& sampling, bool distanceField) {
   return allocator->make<GLSLAtlasTextGeometryProcessor>(std::move(textureProxy), aa, commonColor,
-                                                         sampling);
+                                                         sampling, distanceField);
 }
 
 GLSLAtlasTextGeometryProcessor::GLSLAtlasTextGeometryProcessor(
     std::shared_ptr<TextureProxy> textureProxy, AAType aa, std::optional<PMColor> commonColor,
-    const SamplingOptions& sampling)
-    : AtlasTextGeometryProcessor(std::move(textureProxy), aa, commonColor, sampling) {
+    const SamplingOptions& sampling, bool distanceField)
+    : AtlasTextGeometryProcessor(std::move(textureProxy), aa, commonColor, sampling,
+                                 distanceField) {
 }
 
 void GLSLAtlasTextGeometryProcessor::emitCode(EmitArgs& args) const {
@@ -48,6 +50,12 @@ void GLSLAtlasTextGeometryProcessor::emitCode(EmitArgs& args) const {
   auto uvName = maskCoord.name();
   vertBuilder->codeAppendf("%s = %s * %s;", samplerVarying.vsOut().c_str(), uvName.c_str(),
                            atlasName.c_str());
+  std::string fieldCoordName;
+  if (distanceField) {
+    auto fieldVarying = varyingHandler->addVarying("fieldCoords", SLType::Float2);
+    vertBuilder->codeAppendf("%s = %s;", fieldVarying.vsOut().c_str(), uvName.c_str());
+    fieldCoordName = fieldVarying.fsIn();
+  }
 
   if (aa == AAType::Coverage) {
     auto coverageVar = varyingHandler->addVarying("Coverage", SLType::Float);
@@ -74,7 +82,19 @@ void GLSLAtlasTextGeometryProcessor::emitCode(EmitArgs& args) const {
   fragBuilder->codeAppend("vec4 color = ");
   fragBuilder->appendTextureLookup(samplerHandle, samplerVarying.vsOut());
   fragBuilder->codeAppend(";");
-  if (textureView->isAlphaOnly()) {
+  if (distanceField) {
+    // Converts the distance from texels to pixels using the texel footprint of the current pixel,
+    // which stays correct for any scale, rotation, or skew of the glyphs.
+    fragBuilder->codeAppendf("float distance = (color.a - 0.5) * %d.0;",
+                             2 * DistanceFieldRasterizer::Spread);
+    fragBuilder->codeAppendf("vec2 fieldDx = dFdx(%s);", fieldCoordName.c_str());
+    fragBuilder->codeAppendf("vec2 fieldDy = dFdy(%s);", fieldCoordName.c_str());
+    fragBuilder->codeAppend(
+        "float texelsPerPixel = max(sqrt(0.5 * (dot(fieldDx, fieldDx) + dot(fieldDy, fieldDy))), "
+        "0.0001);");
+    fragBuilder->codeAppendf("%s = vec4(clamp(distance / texelsPerPixel + 0.5, 0.0, 1.0));",
+                             args.outputCoverage.c_str());
+  } else if (textureView->isAlphaOnly()) {
     fragBuilder->codeAppendf("%s = vec4(color.a);", args.outputCoverage.c_str());
   } else {
     fragBuilder->codeAppendf("%s = clamp(vec4(color.rgb/color.a, 1.0), 0.0, 1.0);",
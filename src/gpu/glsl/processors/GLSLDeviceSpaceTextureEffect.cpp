@@ -59,6 +59,8 @@ void GLSLDeviceSpaceTextureEffect::onSetData(UniformData* /*vertexUniformData*/,
     return;
   }
   auto deviceCoordMatrix = uvMatrix;
+  auto offset = textureProxy->backingStoreOffset();
+  deviceCoordMatrix.postTranslate(offset.x, offset.y);
   auto scale = textureView->getTextureCoord(1, 1);
   deviceCoordMatrix.postScale(scale.x, scale.y);
   fragmentUniformData->setData("DeviceCoordMatrix", deviceCoordMatrix);
@@ -21,15 +21,15 @@
 namespace tgfx {
 PlacementPtr<QuadPerEdgeAAGeometryProcessor> QuadPerEdgeAAGeometryProcessor::Make(
     BlockAllocator* allocator, int width, int height, AAType aa, std::optional<PMColor> commonColor,
-    std::optional<Matrix> uvMatrix, bool hasSubset) {
+    std::optional<Matrix> uvMatrix, bool hasSubset, bool halfUV) {
   return allocator->make<GLSLQuadPerEdgeAAGeometryProcessor>(width, height, aa, commonColor,
-                                                             uvMatrix, hasSubset);
+                                                             uvMatrix, hasSubset, halfUV);
 }
 
 GLSLQuadPerEdgeAAGeometryProcessor::GLSLQuadPerEdgeAAGeometryProcessor(
     int width, int height, AAType aa, std::optional<PMColor> commonColor,
-    std::optional<Matrix> uvMatrix, bool hasSubset)
-    : QuadPerEdgeAAGeometryProcessor(width, height, aa, commonColor, uvMatrix, hasSubset) {
+    std::optional<Matrix> uvMatrix, bool hasSubset, bool halfUV)
+    : QuadPerEdgeAAGeometryProcessor(width, height, aa, commonColor, uvMatrix, hasSubset, halfUV) {
 }
 
 void GLSLQuadPerEdgeAAGeometryProcessor::emitCode(EmitArgs& args) const {
@@ -26,7 +26,7 @@ class GLSLQuadPerEdgeAAGeometryProcessor : public QuadPerEdgeAAGeometryProcessor
  public:
   GLSLQuadPerEdgeAAGeometryProcessor(int width, int height, AAType aa,
                                      std::optional<PMColor> commonColor,
-                                     std::optional<Matrix> uvMatrix, bool hasSubset);
+                                     std::optional<Matrix> uvMatrix, bool hasSubset, bool halfUV);
 
   void emitCode(EmitArgs& args) const override;
 
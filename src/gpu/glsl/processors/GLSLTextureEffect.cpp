@@ -242,6 +242,8 @@ void GLSLTextureEffect::onSetData(UniformData* /*vertexUniformData*/,
         samplerState.magFilterMode == FilterMode::Nearest) {
       subsetRect.roundOut();
     }
+    auto offset = textureProxy->backingStoreOffset();
+    subsetRect.offset(offset.x, offset.y);
     auto type = textureView->getTexture()->type();
     // https://cs.android.com/android/platform/superproject/+/master:frameworks/native/libs/nativedisplay/surfacetexture/SurfaceTexture.cpp;l=275;drc=master;bpv=0;bpt=1
     // https://stackoverflow.com/questions/6023400/opengl-es-texture-coordinates-slightly-off
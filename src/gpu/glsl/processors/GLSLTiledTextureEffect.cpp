@@ -225,7 +225,7 @@ void GLSLTiledTextureEffect::emitCode(EmitArgs& args) const {
   if (args.coordFunc) {
     vertexColor = args.coordFunc(vertexColor);
   }
-  Sampling sampling(textureView, samplerState, subset);
+  Sampling sampling(textureView, samplerState, getBackingStoreSubset());
   if (sampling.shaderModeX == TiledTextureEffect::ShaderMode::None &&
       sampling.shaderModeY == TiledTextureEffect::ShaderMode::None) {
     fragBuilder->codeAppendf("%s = ", args.outputColor.c_str());
@@ -419,7 +419,7 @@ void GLSLTiledTextureEffect::onSetData(UniformData* /*vertexUniformData*/,
   if (textureView == nullptr) {
     return;
   }
-  Sampling sampling(textureView, samplerState, subset);
+  Sampling sampling(textureView, samplerState, getBackingStoreSubset());
   auto hasDimensionUniform = (ShaderModeRequiresUnormCoord(sampling.shaderModeX) ||
                               ShaderModeRequiresUnormCoord(sampling.shaderModeY)) &&
                              textureView->getTexture()->type() != TextureType::Rectangle;
@@ -39,18 +39,21 @@ unsigned GLBuffer::GetTarget(uint32_t usage) {
   if (usage & GPUBufferUsage::UNIFORM) {
     return GL_UNIFORM_BUFFER;
   }
+  if (usage & GPUBufferUsage::STAGING) {
+    return GL_PIXEL_UNPACK_BUFFER;
+  }
   return 0;
 }
 
 bool GLBuffer::isReady() const {
-  if (readbackFence == nullptr) {
+  if (fence == nullptr) {
     return true;
   }
   auto gl = _interface->functions();
 #if defined(__EMSCRIPTEN__)
-  auto result = gl->clientWaitSync(readbackFence, 0, 0, 0);
+  auto result = gl->clientWaitSync(fence, 0, 0, 0);
 #else
-  auto result = gl->clientWaitSync(readbackFence, 0, 0);
+  auto result = gl->clientWaitSync(fence, 0, 0);
 #endif
   return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
 }
@@ -73,15 +76,24 @@ void* GLBuffer::map(size_t offset, size_t size) {
     return nullptr;
   }
   // Avoid using GL_MAP_UNSYNCHRONIZED_BIT with READBACK buffers to ensure the GPU has finished
-  // writing before reading.
-  unsigned access = _usage & GPUBufferUsage::READBACK
-                        ? GL_MAP_READ_BIT
-                        : GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+  // writing before reading. STAGING buffers are only mapped once isReady() returns true, and their
+  // previous content is never read again.
+  unsigned access = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+  if (_usage & GPUBufferUsage::READBACK) {
+    access = GL_MAP_READ_BIT;
+  } else if (_usage & GPUBufferUsage::STAGING) {
+    access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT;
+  }
   auto target = GetTarget(_usage);
   DEBUG_ASSERT(target != 0);
   gl->bindBuffer(target, _bufferID);
-  return gl->mapBufferRange(target, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size),
-                            access);
+  auto data = gl->mapBufferRange(target, static_cast<GLintptr>(offset),
+                                 static_cast<GLsizeiptr>(size), access);
+  if (target == GL_PIXEL_UNPACK_BUFFER) {
+    // A bound pixel unpack buffer turns the pixels of the other texture uploads into offsets.
+    gl->bindBuffer(target, 0);
+  }
+  return data;
 }
 
 void GLBuffer::unmap() {
@@ -91,15 +103,18 @@ void GLBuffer::unmap() {
     DEBUG_ASSERT(target != 0);
     gl->bindBuffer(target, _bufferID);
     gl->unmapBuffer(target);
+    if (target == GL_PIXEL_UNPACK_BUFFER) {
+      gl->bindBuffer(target, 0);
+    }
   }
 }
 
-void GLBuffer::insertReadbackFence() {
+void GLBuffer::insertFence() {
   auto gl = _interface->functions();
-  if (readbackFence != nullptr) {
-    gl->deleteSync(readbackFence);
+  if (fence != nullptr) {
+    gl->deleteSync(fence);
   }
-  readbackFence = gl->fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  fence = gl->fenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
 }
 
 void GLBuffer::onRelease(GLGPU* gpu) {
@@ -109,9 +124,9 @@ void GLBuffer::onRelease(GLGPU* gpu) {
     gl->deleteBuffers(1, &_bufferID);
     _bufferID = 0;
   }
-  if (readbackFence != nullptr) {
-    gl->deleteSync(readbackFence);
-    readbackFence = nullptr;
+  if (fence != nullptr) {
+    gl->deleteSync(fence);
+    fence = nullptr;
   }
 }
 }  // namespace tgfx
@@ -52,12 +52,16 @@ class GLBuffer : public GPUBuffer, public GLResource {
 
   void unmap() override;
 
-  void insertReadbackFence();
+  /**
+   * Inserts a fence after the GPU commands accessing this buffer, such as a readback into it or an
+   * upload out of it. isReady() returns false until the fence is signaled.
+   */
+  void insertFence();
 
  protected:
   std::shared_ptr<GLInterface> _interface = nullptr;
   unsigned _bufferID = 0;
-  void* readbackFence = nullptr;
+  void* fence = nullptr;
 
   void onRelease(GLGPU* gpu) override;
 };
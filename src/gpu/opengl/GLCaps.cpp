@@ -17,9 +17,21 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GLCaps.h"
+#include <algorithm>
 #include "GLUtil.h"
 
 namespace tgfx {
+static bool HasCompressedFormat(const GLInfo& info, int format) {
+  int formatCount = 0;
+  info.getIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &formatCount);
+  if (formatCount <= 0) {
+    return false;
+  }
+  std::vector<int> formats(static_cast<size_t>(formatCount));
+  info.getIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+  return std::find(formats.begin(), formats.end(), format) != formats.end();
+}
+
 static GLStandard GetGLStandard(const char* versionString) {
   if (versionString == nullptr) {
     return GLStandard::None;
@@ -145,6 +157,12 @@ GLCaps::GLCaps(const GLInfo& info) {
     default:
       break;
   }
+  if (programBinarySupport) {
+    // Some drivers expose the program binary functions but support no binary formats at all.
+    int binaryFormatCount = 0;
+    info.getIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormatCount);
+    programBinarySupport = binaryFormatCount > 0;
+  }
   _features.semaphore = true;
   info.getIntegerv(GL_MAX_TEXTURE_SIZE, &_limits.maxTextureDimension2D);
   info.getIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &_limits.maxSamplersPerShaderStage);
@@ -195,34 +213,45 @@ int GLCaps::getSampleCount(int requestedCount, PixelFormat pixelFormat) const {
 
 void GLCaps::initGLSupport(const GLInfo& info) {
   pboSupport = true;
+  programBinarySupport = version >= GL_VER(4, 1) || info.hasExtension("GL_ARB_get_program_binary");
   multisampleDisableSupport = true;
   _features.textureBarrier =
       vendor != GLVendor::Intel &&
       (version >= GL_VER(4, 5) || info.hasExtension("GL_ARB_texture_barrier") ||
        info.hasExtension("GL_NV_texture_barrier"));
   _features.clampToBorder = true;
+  // Desktop drivers accept ETC2 for ES3 compatibility, but most of them decompress the blocks on
+  // the CPU while uploading. They leave ETC2 out of the compressed formats they report then.
+  _features.textureCompressionETC2 =
+      (version >= GL_VER(4, 3) || info.hasExtension("GL_ARB_ES3_compatibility")) &&
+      HasCompressedFormat(info, GL_COMPRESSED_RGBA8_ETC2);
   frameBufferFetchRequiresEnablePerSample = false;
 }
 
 void GLCaps::initGLESSupport(const GLInfo& info) {
   pboSupport = true;
+  programBinarySupport = true;
   multisampleDisableSupport = info.hasExtension("GL_EXT_multisample_compatibility");
   _features.textureBarrier = info.hasExtension("GL_NV_texture_barrier");
   _features.clampToBorder = version > GL_VER(3, 2) ||
                             info.hasExtension("GL_EXT_texture_border_clamp") ||
                             info.hasExtension("GL_NV_texture_border_clamp") ||
                             info.hasExtension("GL_OES_texture_border_clamp");
+  // ETC2 is a core format of OpenGL ES 3.0.
+  _features.textureCompressionETC2 = version >= GL_VER(3, 0);
   // The ARM extension requires enabling MSAA fetching on a per-sample basis.
   // This can hurt performance on some devices and disables multiple render targets.
   frameBufferFetchRequiresEnablePerSample = info.hasExtension("GL_ARM_shader_framebuffer_fetch");
 }
 
-void GLCaps::initWebGLSupport(const GLInfo&) {
+void GLCaps::initWebGLSupport(const GLInfo& info) {
   pboSupport = false;
+  programBinarySupport = false;
   multisampleDisableSupport = false;
   frameBufferFetchRequiresEnablePerSample = false;
   _features.textureBarrier = false;
   _features.clampToBorder = false;
+  _features.textureCompressionETC2 = info.hasExtension("WEBGL_compressed_texture_etc");
 }
 
 void GLCaps::initFormatMap(const GLInfo& info) {
@@ -250,6 +279,11 @@ void GLCaps::initFormatMap(const GLInfo& info) {
   RGFormat.format.sizedFormat = GL_RG8;
   RGFormat.format.externalFormat = GL_RG;
   RGFormat.format.externalType = GL_UNSIGNED_BYTE;
+  if (_features.textureCompressionETC2) {
+    // Compressed formats have no external format, the blocks are uploaded as they are.
+    auto& ETC2Format = pixelFormatMap[PixelFormat::ETC2_RGBA8];
+    ETC2Format.format.sizedFormat = GL_COMPRESSED_RGBA8_ETC2;
+  }
 
   bool useSizedRbFormats = standard == GLStandard::GLES || standard == GLStandard::WebGL;
   for (auto& item : pixelFormatMap) {
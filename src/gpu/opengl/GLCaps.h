@@ -78,6 +78,7 @@ class GLCaps {
   uint32_t version = 0;
   GLVendor vendor = GLVendor::Other;
   bool pboSupport = false;
+  bool programBinarySupport = false;
   bool multisampleDisableSupport = false;
   bool frameBufferFetchRequiresEnablePerSample = false;
   bool flushBeforeWritePixels = false;
@@ -140,7 +140,7 @@ void GLCommandEncoder::copyTextureToBuffer(std::shared_ptr<Texture> srcTexture,
       return;
     }
     copyTextureToTexture(srcTexture, srcRect, dstTexture, Point::Zero());
-    textureBuffer->insertReadbackFence();
+    textureBuffer->insertFence();
     return;
   }
   auto gl = _gpu->functions();
@@ -169,7 +169,7 @@ void GLCommandEncoder::copyTextureToBuffer(std::shared_ptr<Texture> srcTexture,
   if (dstRowBytes != minRowBytes) {
     gl->pixelStorei(GL_PACK_ROW_LENGTH, 0);
   }
-  glBuffer->insertReadbackFence();
+  glBuffer->insertFence();
 }
 
 void GLCommandEncoder::generateMipmapsForTexture(std::shared_ptr<Texture> texture) {
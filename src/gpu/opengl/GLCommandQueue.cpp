@@ -18,6 +18,7 @@
 
 #include "GLCommandQueue.h"
 #include "GLTexture.h"
+#include "core/utils/ETC2Encoder.h"
 #include "core/utils/PixelFormatUtil.h"
 #include "gpu/opengl/GLBuffer.h"
 #include "gpu/opengl/GLGPU.h"
@@ -58,6 +59,10 @@ void GLCommandQueue::writeTexture(std::shared_ptr<Texture> texture, const Rect&
   auto glTexture = static_cast<GLTexture*>(texture.get());
   auto state = gpu->state();
   state->bindTexture(glTexture);
+  if (PixelFormatIsCompressed(glTexture->format())) {
+    writeCompressedTexture(glTexture, rect, pixels, rowBytes);
+    return;
+  }
   const auto& textureFormat = caps->getTextureFormat(glTexture->format());
   auto bytesPerPixel = PixelFormatBytesPerPixel(glTexture->format());
   gl->pixelStorei(GL_UNPACK_ALIGNMENT, static_cast<int>(bytesPerPixel));
@@ -72,6 +77,67 @@ void GLCommandQueue::writeTexture(std::shared_ptr<Texture> texture, const Rect&
   gl->pixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 }
 
+void GLCommandQueue::copyBufferToTexture(std::shared_ptr<GPUBuffer> srcBuffer, size_t srcOffset,
+                                         size_t srcRowBytes, std::shared_ptr<Texture> dstTexture,
+                                         const Rect& dstRect) {
+  if (srcBuffer == nullptr || !(srcBuffer->usage() & GPUBufferUsage::STAGING) ||
+      dstTexture == nullptr || dstRect.isEmpty() ||
+      !(dstTexture->usage() & TextureUsage::TEXTURE_BINDING)) {
+    return;
+  }
+  auto glTexture = static_cast<GLTexture*>(dstTexture.get());
+  if (PixelFormatIsCompressed(glTexture->format())) {
+    LOGE("GLCommandQueue::copyBufferToTexture() compressed textures are not supported!");
+    return;
+  }
+  auto gl = gpu->functions();
+  auto caps = gpu->caps();
+  if (caps->flushBeforeWritePixels) {
+    gl->flush();
+  }
+  auto state = gpu->state();
+  state->bindTexture(glTexture);
+  const auto& textureFormat = caps->getTextureFormat(glTexture->format());
+  auto bytesPerPixel = PixelFormatBytesPerPixel(glTexture->format());
+  gl->pixelStorei(GL_UNPACK_ALIGNMENT, static_cast<int>(bytesPerPixel));
+  // the number of pixels, not bytes
+  gl->pixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<int>(srcRowBytes / bytesPerPixel));
+  auto glBuffer = std::static_pointer_cast<GLBuffer>(srcBuffer);
+  gl->bindBuffer(GL_PIXEL_UNPACK_BUFFER, glBuffer->bufferID());
+  // With a pixel unpack buffer bound, the pixels argument is an offset into the buffer, and the
+  // driver transfers the pixels to the texture without blocking the calling thread.
+  gl->texSubImage2D(glTexture->target(), 0, static_cast<int>(dstRect.x()),
+                    static_cast<int>(dstRect.y()), static_cast<int>(dstRect.width()),
+                    static_cast<int>(dstRect.height()), textureFormat.externalFormat,
+                    textureFormat.externalType, reinterpret_cast<void*>(srcOffset));
+  gl->bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  gl->pixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  glBuffer->insertFence();
+}
+
+void GLCommandQueue::writeCompressedTexture(GLTexture* texture, const Rect& rect,
+                                            const void* pixels, size_t rowBytes) {
+  int x = static_cast<int>(rect.x());
+  int y = static_cast<int>(rect.y());
+  int width = static_cast<int>(rect.width());
+  int height = static_cast<int>(rect.height());
+  // The rect must be aligned to the 4x4 blocks, except at the right and bottom edges.
+  if (x % 4 != 0 || y % 4 != 0 || (width % 4 != 0 && x + width != texture->width()) ||
+      (height % 4 != 0 && y + height != texture->height())) {
+    LOGE("GLCommandQueue::writeTexture() the rect is not aligned to the compressed blocks!");
+    return;
+  }
+  if (rowBytes != ETC2CompressedRowBytes(width)) {
+    LOGE("GLCommandQueue::writeTexture() the compressed blocks must be tightly packed!");
+    return;
+  }
+  auto gl = gpu->functions();
+  const auto& textureFormat = gpu->caps()->getTextureFormat(texture->format());
+  auto imageSize = static_cast<int>(ETC2CompressedSize(width, height));
+  gl->compressedTexSubImage2D(texture->target(), 0, x, y, width, height,
+                              textureFormat.internalFormatTexImage, imageSize, pixels);
+}
+
 void GLCommandQueue::submit(std::shared_ptr<CommandBuffer>) {
   gpu->processUnreferencedResources();
   auto gl = gpu->functions();
@@ -89,6 +155,13 @@ std::shared_ptr<Semaphore> GLCommandQueue::insertSemaphore() {
   return gpu->makeResource<GLSemaphore>(glSync);
 }
 
+void GLCommandQueue::insertFence(std::shared_ptr<GPUBuffer> buffer) {
+  if (buffer == nullptr) {
+    return;
+  }
+  std::static_pointer_cast<GLBuffer>(buffer)->insertFence();
+}
+
 void GLCommandQueue::waitSemaphore(std::shared_ptr<Semaphore> semaphore) {
   if (semaphore == nullptr) {
     return;
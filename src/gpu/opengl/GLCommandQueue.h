@@ -22,6 +22,7 @@
 
 namespace tgfx {
 class GLGPU;
+class GLTexture;
 
 class GLCommandQueue : public CommandQueue {
  public:
@@ -34,15 +35,24 @@ class GLCommandQueue : public CommandQueue {
   void writeTexture(std::shared_ptr<Texture> texture, const Rect& rect, const void* pixels,
                     size_t rowBytes) override;
 
+  void copyBufferToTexture(std::shared_ptr<GPUBuffer> srcBuffer, size_t srcOffset,
+                           size_t srcRowBytes, std::shared_ptr<Texture> dstTexture,
+                           const Rect& dstRect) override;
+
   void submit(std::shared_ptr<CommandBuffer>) override;
 
   std::shared_ptr<Semaphore> insertSemaphore() override;
 
+  void insertFence(std::shared_ptr<GPUBuffer> buffer) override;
+
   void waitSemaphore(std::shared_ptr<Semaphore> semaphore) override;
 
   void waitUntilCompleted() override;
 
  private:
   GLGPU* gpu = nullptr;
+
+  void writeCompressedTexture(GLTexture* texture, const Rect& rect, const void* pixels,
+                              size_t rowBytes);
 };
 }  // namespace tgfx
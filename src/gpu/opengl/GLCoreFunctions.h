@@ -41,6 +41,8 @@
   M(glClientWaitSync)                 \
   M(glColorMask)                      \
   M(glCompileShader)                  \
+  M(glCompressedTexImage2D)           \
+  M(glCompressedTexSubImage2D)        \
   M(glCopyTexSubImage2D)              \
   M(glCreateProgram)                  \
   M(glCreateShader)                   \
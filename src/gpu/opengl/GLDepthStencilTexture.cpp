@@ -47,8 +47,14 @@ std::shared_ptr<GLDepthStencilTexture> GLDepthStencilTexture::MakeFrom(
     return nullptr;
   }
   gl->bindRenderbuffer(GL_RENDERBUFFER, renderBufferID);
-  gl->renderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, descriptor.width,
-                          descriptor.height);
+  if (descriptor.sampleCount > 1) {
+    // The depth-stencil attachment must have the same sample count as the color attachment.
+    gl->renderbufferStorageMultisample(GL_RENDERBUFFER, descriptor.sampleCount,
+                                       GL_DEPTH24_STENCIL8, descriptor.width, descriptor.height);
+  } else {
+    gl->renderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, descriptor.width,
+                            descriptor.height);
+  }
   if (!CheckGLError(gl)) {
     gl->deleteRenderbuffers(1, &renderBufferID);
     return nullptr;
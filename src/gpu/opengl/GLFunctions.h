@@ -60,6 +60,14 @@ using GLClearStencil = void GL_FUNCTION_TYPE(int s);
 using GLColorMask = void GL_FUNCTION_TYPE(unsigned char red, unsigned char green,
                                           unsigned char blue, unsigned char alpha);
 using GLCompileShader = void GL_FUNCTION_TYPE(unsigned shader);
+using GLCompressedTexImage2D = void GL_FUNCTION_TYPE(unsigned target, int level,
+                                                     unsigned internalformat, int width,
+                                                     int height, int border, int imageSize,
+                                                     const void* data);
+using GLCompressedTexSubImage2D = void GL_FUNCTION_TYPE(unsigned target, int level, int xoffset,
+                                                        int yoffset, int width, int height,
+                                                        unsigned format, int imageSize,
+                                                        const void* data);
 using GLCopyTexSubImage2D = void GL_FUNCTION_TYPE(unsigned target, int level, int xoffset,
                                                   int yoffset, int x, int y, int width, int height);
 using GLCreateProgram = unsigned GL_FUNCTION_TYPE();
@@ -104,6 +112,8 @@ using GLGetInternalformativ = void GL_FUNCTION_TYPE(unsigned target, unsigned in
 using GLGetProgramInfoLog = void GL_FUNCTION_TYPE(unsigned program, int bufsize, int* length,
                                                   char* infolog);
 using GLGetProgramiv = void GL_FUNCTION_TYPE(unsigned program, unsigned pname, int* params);
+using GLGetProgramBinary = void GL_FUNCTION_TYPE(unsigned program, int bufSize, int* length,
+                                                 unsigned* binaryFormat, void* binary);
 using GLGetShaderInfoLog = void GL_FUNCTION_TYPE(unsigned shader, int bufsize, int* length,
                                                  char* infolog);
 using GLGetShaderiv = void GL_FUNCTION_TYPE(unsigned shader, unsigned pname, int* params);
@@ -125,6 +135,9 @@ using GLMapBufferRange = void* GL_FUNCTION_TYPE(unsigned target, GLintptr offset
 using GLUnmapBuffer = unsigned char GL_FUNCTION_TYPE(unsigned target);
 using GLLinkProgram = void GL_FUNCTION_TYPE(unsigned program);
 using GLPixelStorei = void GL_FUNCTION_TYPE(unsigned pname, int param);
+using GLProgramBinary = void GL_FUNCTION_TYPE(unsigned program, unsigned binaryFormat,
+                                              const void* binary, int length);
+using GLProgramParameteri = void GL_FUNCTION_TYPE(unsigned program, unsigned pname, int value);
 using GLReadPixels = void GL_FUNCTION_TYPE(int x, int y, int width, int height, unsigned format,
                                            unsigned type, void* pixels);
 using GLRenderbufferStorage = void GL_FUNCTION_TYPE(unsigned target, unsigned internalformat,
@@ -198,6 +211,8 @@ class GLFunctions {
   GLClearStencil* clearStencil = nullptr;
   GLColorMask* colorMask = nullptr;
   GLCompileShader* compileShader = nullptr;
+  GLCompressedTexImage2D* compressedTexImage2D = nullptr;
+  GLCompressedTexSubImage2D* compressedTexSubImage2D = nullptr;
   GLCopyTexSubImage2D* copyTexSubImage2D = nullptr;
   GLCreateProgram* createProgram = nullptr;
   GLCreateShader* createShader = nullptr;
@@ -234,6 +249,7 @@ class GLFunctions {
   GLGetInternalformativ* getInternalformativ = nullptr;
   GLGetProgramInfoLog* getProgramInfoLog = nullptr;
   GLGetProgramiv* getProgramiv = nullptr;
+  GLGetProgramBinary* getProgramBinary = nullptr;
   GLGetShaderInfoLog* getShaderInfoLog = nullptr;
   GLGetShaderiv* getShaderiv = nullptr;
   GLGetShaderPrecisionFormat* getShaderPrecisionFormat = nullptr;
@@ -248,6 +264,8 @@ class GLFunctions {
   GLUnmapBuffer* unmapBuffer = nullptr;
   GLLinkProgram* linkProgram = nullptr;
   GLPixelStorei* pixelStorei = nullptr;
+  GLProgramBinary* programBinary = nullptr;
+  GLProgramParameteri* programParameteri = nullptr;
   GLReadPixels* readPixels = nullptr;
   GLRenderbufferStorage* renderbufferStorage = nullptr;
   GLRenderbufferStorageMultisample* renderbufferStorageMultisample = nullptr;
@@ -17,6 +17,8 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GLGPU.h"
+#include "core/utils/ETC2Encoder.h"
+#include "core/utils/PixelFormatUtil.h"
 #include "gpu/opengl/GLBuffer.h"
 #include "gpu/opengl/GLTextureBuffer.h"
 #if defined(__EMSCRIPTEN__)
@@ -66,14 +68,31 @@ std::shared_ptr<GPUBuffer> GLGPU::createBuffer(size_t size, uint32_t usage) {
   }
 
   auto gl = interface->functions();
+#if defined(__EMSCRIPTEN__)
+  auto stagingSupport = false;
+#else
+  auto stagingSupport = caps->pboSupport && gl->mapBufferRange != nullptr;
+#endif
+  if (usage & GPUBufferUsage::STAGING && !stagingSupport) {
+    // Staging buffers are optional, callers fall back to writing textures from client memory.
+    return nullptr;
+  }
   unsigned bufferID = 0;
   gl->genBuffers(1, &bufferID);
   if (bufferID == 0) {
     return nullptr;
   }
   gl->bindBuffer(target, bufferID);
-  unsigned glUsage = usage & GPUBufferUsage::READBACK ? GL_STREAM_READ : GL_STATIC_DRAW;
+  unsigned glUsage = GL_STATIC_DRAW;
+  if (usage & GPUBufferUsage::READBACK) {
+    glUsage = GL_STREAM_READ;
+  } else if (usage & GPUBufferUsage::STAGING) {
+    glUsage = GL_STREAM_DRAW;
+  }
   gl->bufferData(target, static_cast<GLsizeiptr>(size), nullptr, glUsage);
+  if (target == GL_PIXEL_UNPACK_BUFFER) {
+    gl->bindBuffer(target, 0);
+  }
 #if defined(__EMSCRIPTEN__)
   return makeResource<WebGLBuffer>(interface, bufferID, size, usage);
 #else
@@ -88,17 +107,22 @@ std::shared_ptr<Texture> GLGPU::createTexture(const TextureDescriptor& descripto
     LOGE("GLGPU::createTexture() invalid texture descriptor!");
     return nullptr;
   }
-  if (descriptor.sampleCount > 1) {
-    return GLMultisampleTexture::MakeFrom(this, descriptor);
-  }
   if (descriptor.format == PixelFormat::DEPTH24_STENCIL8) {
     return GLDepthStencilTexture::MakeFrom(this, descriptor);
   }
+  if (descriptor.sampleCount > 1) {
+    return GLMultisampleTexture::MakeFrom(this, descriptor);
+  }
   if (descriptor.usage & TextureUsage::RENDER_ATTACHMENT &&
       !isFormatRenderable(descriptor.format)) {
     LOGE("GLGPU::createTexture() format is not renderable, but usage includes RENDER_ATTACHMENT!");
     return nullptr;
   }
+  if (PixelFormatIsCompressed(descriptor.format) &&
+      (descriptor.mipLevelCount > 1 || !features()->textureCompressionETC2)) {
+    LOGE("GLGPU::createTexture() compressed format is unsupported or has mipmaps!");
+    return nullptr;
+  }
   auto gl = functions();
   // Clear the previously generated GLError, causing the subsequent CheckGLError to return an
   // incorrect result.
@@ -113,15 +137,23 @@ std::shared_ptr<Texture> GLGPU::createTexture(const TextureDescriptor& descripto
   _state->bindTexture(texture.get());
   auto& textureFormat = interface->caps()->getTextureFormat(descriptor.format);
   bool success = true;
-  // Texture memory must be allocated first on the web platform then can write pixels.
-  for (int level = 0; level < descriptor.mipLevelCount && success; level++) {
-    auto twoToTheMipLevel = 1 << level;
-    auto currentWidth = std::max(1, descriptor.width / twoToTheMipLevel);
-    auto currentHeight = std::max(1, descriptor.height / twoToTheMipLevel);
-    gl->texImage2D(target, level, static_cast<int>(textureFormat.internalFormatTexImage),
-                   currentWidth, currentHeight, 0, textureFormat.externalFormat,
-                   textureFormat.externalType, nullptr);
+  if (PixelFormatIsCompressed(descriptor.format)) {
+    // The compressed blocks are written by writeTexture() later.
+    auto imageSize = ETC2CompressedSize(descriptor.width, descriptor.height);
+    gl->compressedTexImage2D(target, 0, textureFormat.internalFormatTexImage, descriptor.width,
+                             descriptor.height, 0, static_cast<int>(imageSize), nullptr);
     success = CheckGLError(gl);
+  } else {
+    // Texture memory must be allocated first on the web platform then can write pixels.
+    for (int level = 0; level < descriptor.mipLevelCount && success; level++) {
+      auto twoToTheMipLevel = 1 << level;
+      auto currentWidth = std::max(1, descriptor.width / twoToTheMipLevel);
+      auto currentHeight = std::max(1, descriptor.height / twoToTheMipLevel);
+      gl->texImage2D(target, level, static_cast<int>(textureFormat.internalFormatTexImage),
+                     currentWidth, currentHeight, 0, textureFormat.externalFormat,
+                     textureFormat.externalType, nullptr);
+      success = CheckGLError(gl);
+    }
   }
   if (!success) {
     return nullptr;
@@ -264,8 +296,9 @@ std::shared_ptr<RenderPipeline> GLGPU::createRenderPipeline(
     const RenderPipelineDescriptor& descriptor) {
   auto vertexModule = static_cast<GLShaderModule*>(descriptor.vertex.module.get());
   auto fragmentModule = static_cast<GLShaderModule*>(descriptor.fragment.module.get());
-  if (vertexModule == nullptr || vertexModule->shader() == 0 || vertexModule == nullptr ||
-      fragmentModule->shader() == 0) {
+  if (descriptor.binary == nullptr &&
+      (vertexModule == nullptr || vertexModule->shader() == 0 || fragmentModule == nullptr ||
+       fragmentModule->shader() == 0)) {
     LOGE("GLGPU::createRenderPipeline() invalid shader module!");
     return nullptr;
   }
@@ -287,10 +320,62 @@ std::shared_ptr<RenderPipeline> GLGPU::createRenderPipeline(
         "OpenGL!");
     return nullptr;
   }
+  unsigned programID = 0;
+  if (descriptor.binary != nullptr) {
+    programID = createProgramFromBinary(descriptor.binary.get());
+    if (programID == 0) {
+      return nullptr;
+    }
+  } else {
+    programID = linkProgram(vertexModule->shader(), fragmentModule->shader());
+  }
+  auto pipeline = makeResource<GLRenderPipeline>(programID);
+  if (!pipeline->setPipelineDescriptor(this, descriptor)) {
+    return nullptr;
+  }
+  return pipeline;
+}
+
+std::shared_ptr<Data> GLGPU::getPipelineBinary(const RenderPipeline* pipeline) const {
+  auto gl = interface->functions();
+  if (pipeline == nullptr || !caps()->programBinarySupport || gl->getProgramBinary == nullptr) {
+    return nullptr;
+  }
+  auto programID = static_cast<const GLRenderPipeline*>(pipeline)->programID;
+  if (programID == 0) {
+    return nullptr;
+  }
+  int binaryLength = 0;
+  gl->getProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+  if (binaryLength <= 0) {
+    return nullptr;
+  }
+  // The binary format chosen by the driver is stored in front of the binary itself.
+  auto length = sizeof(unsigned) + static_cast<size_t>(binaryLength);
+  auto buffer = new (std::nothrow) uint8_t[length];
+  if (buffer == nullptr) {
+    return nullptr;
+  }
+  unsigned binaryFormat = 0;
+  int writtenLength = 0;
+  gl->getProgramBinary(programID, binaryLength, &writtenLength, &binaryFormat,
+                       buffer + sizeof(unsigned));
+  if (writtenLength != binaryLength) {
+    delete[] buffer;
+    return nullptr;
+  }
+  memcpy(buffer, &binaryFormat, sizeof(unsigned));
+  return Data::MakeAdopted(buffer, length);
+}
+
+unsigned GLGPU::linkProgram(unsigned vertexShader, unsigned fragmentShader) {
   auto gl = interface->functions();
   auto programID = gl->createProgram();
-  gl->attachShader(programID, vertexModule->shader());
-  gl->attachShader(programID, fragmentModule->shader());
+  gl->attachShader(programID, vertexShader);
+  gl->attachShader(programID, fragmentShader);
+  if (caps()->programBinarySupport && gl->programParameteri != nullptr) {
+    gl->programParameteri(programID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  }
   gl->linkProgram(programID);
   int success;
   gl->getProgramiv(programID, GL_LINK_STATUS, &success);
@@ -301,11 +386,29 @@ std::shared_ptr<RenderPipeline> GLGPU::createRenderPipeline(
     programID = 0;
     LOGE("GLGPU::createRenderPipeline() Could not link program: %s", infoLog);
   }
-  auto pipeline = makeResource<GLRenderPipeline>(programID);
-  if (!pipeline->setPipelineDescriptor(this, descriptor)) {
-    return nullptr;
+  return programID;
+}
+
+unsigned GLGPU::createProgramFromBinary(const Data* binary) {
+  auto gl = interface->functions();
+  if (!caps()->programBinarySupport || gl->programBinary == nullptr ||
+      binary->size() <= sizeof(unsigned)) {
+    return 0;
   }
-  return pipeline;
+  unsigned binaryFormat = 0;
+  memcpy(&binaryFormat, binary->data(), sizeof(unsigned));
+  auto programID = gl->createProgram();
+  gl->programBinary(programID, binaryFormat, binary->bytes() + sizeof(unsigned),
+                    static_cast<int>(binary->size() - sizeof(unsigned)));
+  // The driver rejects binaries produced by a different driver version or GPU, which is not an
+  // error, the caller is expected to compile the shaders instead.
+  int success;
+  gl->getProgramiv(programID, GL_LINK_STATUS, &success);
+  if (!success) {
+    gl->deleteProgram(programID);
+    return 0;
+  }
+  return programID;
 }
 
 std::shared_ptr<CommandEncoder> GLGPU::createCommandEncoder() {
@@ -91,6 +91,8 @@ class GLGPU : public GPU {
   std::shared_ptr<RenderPipeline> createRenderPipeline(
       const RenderPipelineDescriptor& descriptor) override;
 
+  std::shared_ptr<Data> getPipelineBinary(const RenderPipeline* pipeline) const override;
+
   std::shared_ptr<CommandEncoder> createCommandEncoder() override;
 
   void processUnreferencedResources();
@@ -115,5 +117,9 @@ class GLGPU : public GPU {
   std::shared_ptr<ReturnQueue> returnQueue = ReturnQueue::Make();
 
   std::shared_ptr<GLResource> addResource(GLResource* resource);
+
+  unsigned linkProgram(unsigned vertexShader, unsigned fragmentShader);
+
+  unsigned createProgramFromBinary(const Data* binary);
 };
 }  // namespace tgfx
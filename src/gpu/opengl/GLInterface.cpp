@@ -103,6 +103,10 @@ std::shared_ptr<GLInterface> GLInterface::MakeNativeInterface(const GLProcGetter
   functions->colorMask = reinterpret_cast<GLColorMask*>(getter->getProcAddress("glColorMask"));
   functions->compileShader =
       reinterpret_cast<GLCompileShader*>(getter->getProcAddress("glCompileShader"));
+  functions->compressedTexImage2D = reinterpret_cast<GLCompressedTexImage2D*>(
+      getter->getProcAddress("glCompressedTexImage2D"));
+  functions->compressedTexSubImage2D = reinterpret_cast<GLCompressedTexSubImage2D*>(
+      getter->getProcAddress("glCompressedTexSubImage2D"));
   functions->copyTexSubImage2D =
       reinterpret_cast<GLCopyTexSubImage2D*>(getter->getProcAddress("glCopyTexSubImage2D"));
   functions->createProgram =
@@ -182,6 +186,12 @@ std::shared_ptr<GLInterface> GLInterface::MakeNativeInterface(const GLProcGetter
       reinterpret_cast<GLMapBufferRange*>(getter->getProcAddress("glMapBufferRange"));
   functions->unmapBuffer =
       reinterpret_cast<GLUnmapBuffer*>(getter->getProcAddress("glUnmapBuffer"));
+  functions->getProgramBinary =
+      reinterpret_cast<GLGetProgramBinary*>(getter->getProcAddress("glGetProgramBinary"));
+  functions->programBinary =
+      reinterpret_cast<GLProgramBinary*>(getter->getProcAddress("glProgramBinary"));
+  functions->programParameteri =
+      reinterpret_cast<GLProgramParameteri*>(getter->getProcAddress("glProgramParameteri"));
   functions->linkProgram =
       reinterpret_cast<GLLinkProgram*>(getter->getProcAddress("glLinkProgram"));
   functions->pixelStorei =
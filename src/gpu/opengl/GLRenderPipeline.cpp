@@ -203,11 +203,17 @@ static GLStencil MakeGLStencil(const StencilDescriptor& descriptor) {
   return stencil;
 }
 
+static bool IsStencilDisabled(const StencilDescriptor& descriptor) {
+  return descriptor.compare == CompareFunction::Always &&
+         descriptor.failOp == StencilOperation::Keep &&
+         descriptor.depthFailOp == StencilOperation::Keep &&
+         descriptor.passOp == StencilOperation::Keep;
+}
+
 static std::unique_ptr<GLStencilState> MakeStencilState(const DepthStencilDescriptor& descriptor) {
-  auto& stencilFront = descriptor.stencilFront;
-  auto& stencilBack = descriptor.stencilBack;
-  if (stencilFront.compare == CompareFunction::Always &&
-      stencilBack.compare == CompareFunction::Always) {
+  // A stencil test that always passes can still write to the stencil buffer, so the test is only
+  // skipped if it neither reads nor writes.
+  if (IsStencilDisabled(descriptor.stencilFront) && IsStencilDisabled(descriptor.stencilBack)) {
     return nullptr;
   }
   auto stencilState = std::make_unique<GLStencilState>();
@@ -33,7 +33,8 @@ class AtlasTextOp final : public DrawOp {
                                         PlacementPtr<RectsVertexProvider> provider,
                                         uint32_t renderFlags,
                                         std::shared_ptr<TextureProxy> textureProxy,
-                                        const SamplingOptions& sampling);
+                                        const SamplingOptions& sampling,
+                                        bool distanceField = false);
 
   bool hasCoverage() const override;
 
@@ -53,9 +54,11 @@ class AtlasTextOp final : public DrawOp {
   std::shared_ptr<VertexBufferView> vertexBufferProxyView = {};
   std::shared_ptr<TextureProxy> textureProxy = nullptr;
   SamplingOptions sampling{FilterMode::Nearest, MipmapMode::None};
+  bool distanceField = false;
 
   AtlasTextOp(BlockAllocator* allocator, RectsVertexProvider* provider,
-              std::shared_ptr<TextureProxy> textureProxy, const SamplingOptions& sampling);
+              std::shared_ptr<TextureProxy> textureProxy, const SamplingOptions& sampling,
+              bool distanceField);
 
   friend class BlockAllocator;
 };
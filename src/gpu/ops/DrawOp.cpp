@@ -23,7 +23,8 @@
 #include "inspect/InspectorMark.h"
 
 namespace tgfx {
-void DrawOp::execute(RenderPass* renderPass, RenderTarget* renderTarget) {
+void DrawOp::execute(RenderPass* renderPass, RenderTarget* renderTarget,
+                     const Rect& renderBounds) {
   OPERATE_MARK(type());
   DRAW_OP(this);
   auto geometryProcessor = onMakeGeometryProcessor(renderTarget);
@@ -44,6 +45,8 @@ void DrawOp::execute(RenderPass* renderPass, RenderTarget* renderTarget) {
   ProgramInfo programInfo(renderTarget, geometryProcessor.get(), std::move(fragmentProcessors),
                           colors.size(), xferProcessor.get(), blendMode);
   programInfo.setCullMode(cullMode);
+  programInfo.setDepthStencil(depthStencil);
+  programInfo.setColorWriteMask(colorWriteMask);
   auto program = programInfo.getProgram();
   if (program == nullptr) {
     LOGE("DrawOp::execute() Failed to get the program!");
@@ -53,15 +56,64 @@ void DrawOp::execute(RenderPass* renderPass, RenderTarget* renderTarget) {
 
   programInfo.setUniformsAndSamplers(renderPass, program.get());
 
-  if (scissorRect.isEmpty()) {
-    renderPass->setScissorRect(0, 0, renderTarget->width(), renderTarget->height());
-  } else {
-    renderPass->setScissorRect(static_cast<int>(scissorRect.x()), static_cast<int>(scissorRect.y()),
-                               static_cast<int>(scissorRect.width()),
-                               static_cast<int>(scissorRect.height()));
+  auto scissor = renderBounds;
+  if (!scissorRect.isEmpty()) {
+    scissor = scissorRect.makeOffset(renderBounds.left, renderBounds.top);
   }
+  renderPass->setScissorRect(static_cast<int>(scissor.x()), static_cast<int>(scissor.y()),
+                             static_cast<int>(scissor.width()), static_cast<int>(scissor.height()));
   onDraw(renderPass);
   CAPUTRE_FRARGMENT_PROCESSORS(renderTarget->getContext(), colors, coverages);
   CAPUTRE_RENDER_TARGET(renderTarget);
 }
+
+void DrawOp::visitProxies(const std::function<void(const TextureProxy*)>& func) const {
+  for (auto& color : colors) {
+    color->visitProxies(func);
+  }
+  for (auto& coverage : coverages) {
+    coverage->visitProxies(func);
+  }
+  if (xferProcessor != nullptr) {
+    if (auto dstTextureProxy = xferProcessor->dstTextureProxy()) {
+      func(dstTextureProxy);
+    }
+  }
+}
+
+static bool UsesStencil(const StencilDescriptor& stencil) {
+  return stencil.compare != CompareFunction::Always || stencil.failOp != StencilOperation::Keep ||
+         stencil.depthFailOp != StencilOperation::Keep || stencil.passOp != StencilOperation::Keep;
+}
+
+bool DrawOp::usesStencil() const {
+  return UsesStencil(depthStencil.stencilFront) || UsesStencil(depthStencil.stencilBack);
+}
+
+static bool UsesDeviceCoordinates(const FragmentProcessor* processor) {
+  FragmentProcessor::Iter iter(processor);
+  while (auto fp = iter.next()) {
+    if (fp->usesDeviceCoordinates()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool DrawOp::usesDeviceCoordinates() const {
+  if (xferProcessor != nullptr && xferProcessor->dstTextureProxy() != nullptr) {
+    return true;
+  }
+  for (auto& color : colors) {
+    if (UsesDeviceCoordinates(color.get())) {
+      return true;
+    }
+  }
+  for (auto& coverage : coverages) {
+    if (UsesDeviceCoordinates(coverage.get())) {
+      return true;
+    }
+  }
+  return false;
+}
 }  // namespace tgfx
@@ -25,10 +25,21 @@
 namespace tgfx {
 class DrawOp {
  public:
-  enum class Type { RectDrawOp, RRectDrawOp, ShapeDrawOp, AtlasTextOp, Rect3DDrawOp };
+  enum class Type {
+    RectDrawOp,
+    RRectDrawOp,
+    ShapeDrawOp,
+    AtlasTextOp,
+    Rect3DDrawOp,
+    StencilPathOp
+  };
 
   virtual ~DrawOp() = default;
 
+  const Rect& getScissorRect() const {
+    return scissorRect;
+  }
+
   void setScissorRect(const Rect& rect) {
     scissorRect = rect;
   }
@@ -41,6 +52,16 @@ class DrawOp {
     cullMode = mode;
   }
 
+  void setDepthStencil(const DepthStencilDescriptor& descriptor) {
+    depthStencil = descriptor;
+  }
+
+  /**
+   * Returns true if the op reads or writes the stencil buffer, which requires the render pass to
+   * have a stencil attachment.
+   */
+  bool usesStencil() const;
+
   void setXferProcessor(PlacementPtr<XferProcessor> processor) {
     xferProcessor = std::move(processor);
   }
@@ -57,7 +78,23 @@ class DrawOp {
     return !coverages.empty();
   }
 
-  void execute(RenderPass* renderPass, RenderTarget* renderTarget);
+  /**
+   * Executes the op in the given render pass. The renderBounds is the region of the backing store
+   * occupied by the render target, which also clips the op if it has no scissor rect.
+   */
+  void execute(RenderPass* renderPass, RenderTarget* renderTarget, const Rect& renderBounds);
+
+  /**
+   * Calls the given function for each TextureProxy sampled by the fragment processors and the xfer
+   * processor of this op.
+   */
+  void visitProxies(const std::function<void(const TextureProxy*)>& func) const;
+
+  /**
+   * Returns true if any processor of this op depends on the location of the render target within
+   * the backing store, such as the ones reading the fragment position or the destination texture.
+   */
+  bool usesDeviceCoordinates() const;
 
  protected:
   BlockAllocator* allocator = nullptr;
@@ -68,6 +105,8 @@ class DrawOp {
   PlacementPtr<XferProcessor> xferProcessor = nullptr;
   BlendMode blendMode = BlendMode::SrcOver;
   CullMode cullMode = CullMode::None;
+  DepthStencilDescriptor depthStencil = {};
+  uint32_t colorWriteMask = ColorWriteMask::All;
 
   DrawOp(BlockAllocator* allocator, AAType aaType) : allocator(allocator), aaType(aaType) {
   }
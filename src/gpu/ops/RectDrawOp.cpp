@@ -34,6 +34,7 @@ PlacementPtr<RectDrawOp> RectDrawOp::Make(Context* context,
     return nullptr;
   }
   auto allocator = context->drawingAllocator();
+  provider->enableHalfUV();
   auto drawOp = allocator->make<RectDrawOp>(allocator, provider.get());
   CAPUTRE_RECT_MESH(drawOp.get(), provider.get());
   if (provider->aaType() == AAType::Coverage || provider->rectCount() > 1 || provider->lineJoin()) {
@@ -61,6 +62,7 @@ RectDrawOp::RectDrawOp(BlockAllocator* allocator, RectsVertexProvider* provider)
     commonColor = ToPMColor(provider->firstColor(), provider->dstColorSpace());
   }
   hasSubset = provider->hasSubset();
+  halfUV = provider->hasHalfUV();
 }
 
 PlacementPtr<GeometryProcessor> RectDrawOp::onMakeGeometryProcessor(RenderTarget* renderTarget) {
@@ -68,13 +70,14 @@ PlacementPtr<GeometryProcessor> RectDrawOp::onMakeGeometryProcessor(RenderTarget
   ATTRIBUTE_NAME("commonColor", commonColor);
   ATTRIBUTE_NAME("uvMatrix", uvMatrix);
   ATTRIBUTE_NAME("hasSubset", hasSubset);
+  ATTRIBUTE_NAME("halfUV", halfUV);
   ATTRIBUTE_NAME("hasStroke", lineJoin.has_value());
   if (lineJoin == LineJoin::Round) {
     return RoundStrokeRectGeometryProcessor::Make(allocator, aaType, commonColor, uvMatrix);
   }
   return QuadPerEdgeAAGeometryProcessor::Make(allocator, renderTarget->width(),
                                               renderTarget->height(), aaType, commonColor, uvMatrix,
-                                              hasSubset);
+                                              hasSubset, halfUV);
 }
 
 static uint16_t GetNumIndicesPerQuad(AAType aaType, const std::optional<LineJoin>& lineJoin) {
@@ -0,0 +1,78 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "StencilPathOp.h"
+#include "core/PathTriangulator.h"
+#include "gpu/ProxyProvider.h"
+#include "gpu/processors/DefaultGeometryProcessor.h"
+#include "inspect/InspectorMark.h"
+
+namespace tgfx {
+DepthStencilDescriptor StencilPathOp::CoverStencil() {
+  // Draws where the winding number is not zero, and resets the stencil value for the next path.
+  StencilDescriptor stencil = {};
+  stencil.compare = CompareFunction::NotEqual;
+  stencil.passOp = StencilOperation::Zero;
+  DepthStencilDescriptor descriptor = {};
+  descriptor.stencilFront = stencil;
+  descriptor.stencilBack = stencil;
+  return descriptor;
+}
+
+PlacementPtr<StencilPathOp> StencilPathOp::Make(Context* context, std::shared_ptr<Shape> shape,
+                                                PathFillType fillType, uint32_t renderFlags) {
+  auto bufferProxy =
+      context->proxyProvider()->createStencilBufferProxy(std::move(shape), renderFlags);
+  if (bufferProxy == nullptr) {
+    return nullptr;
+  }
+  auto allocator = context->drawingAllocator();
+  return allocator->make<StencilPathOp>(allocator, fillType, std::move(bufferProxy));
+}
+
+StencilPathOp::StencilPathOp(BlockAllocator* allocator, PathFillType fillType,
+                             std::shared_ptr<GPUBufferProxy> bufferProxy)
+    : DrawOp(allocator, AAType::None), bufferProxy(std::move(bufferProxy)) {
+  colorWriteMask = 0;
+  // Triangles facing one way add one to the winding number and the others subtract one. For the
+  // even-odd rule, only the parity matters, so every triangle flips the stencil bits.
+  auto evenOdd = fillType == PathFillType::EvenOdd;
+  depthStencil.stencilFront.passOp =
+      evenOdd ? StencilOperation::Invert : StencilOperation::IncrementWrap;
+  depthStencil.stencilBack.passOp =
+      evenOdd ? StencilOperation::Invert : StencilOperation::DecrementWrap;
+}
+
+PlacementPtr<GeometryProcessor> StencilPathOp::onMakeGeometryProcessor(
+    RenderTarget* renderTarget) {
+  return DefaultGeometryProcessor::Make(allocator, PMColor::Transparent(), renderTarget->width(),
+                                        renderTarget->height(), AAType::None, Matrix::I(),
+                                        Matrix::I());
+}
+
+void StencilPathOp::onDraw(RenderPass* renderPass) {
+  auto vertexBuffer = bufferProxy->getBuffer();
+  if (vertexBuffer == nullptr) {
+    return;
+  }
+  auto vertexCount = PathTriangulator::GetTriangleCount(vertexBuffer->size());
+  ATTRIBUTE_NAME("vertexCount", static_cast<int>(vertexCount));
+  renderPass->setVertexBuffer(vertexBuffer->gpuBuffer());
+  renderPass->draw(PrimitiveType::Triangles, 0, vertexCount);
+}
+}  // namespace tgfx
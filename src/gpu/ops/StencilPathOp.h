@@ -0,0 +1,63 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "gpu/ops/DrawOp.h"
+#include "gpu/proxies/GPUBufferProxy.h"
+#include "tgfx/core/Path.h"
+#include "tgfx/core/Shape.h"
+
+namespace tgfx {
+/**
+ * StencilPathOp writes the winding numbers of a path to the stencil buffer without touching the
+ * color buffer. It must be followed by a cover op that draws the path bounds where the stencil
+ * value is not zero and resets the stencil value to zero.
+ */
+class StencilPathOp : public DrawOp {
+ public:
+  /**
+   * Returns the stencil state for the cover op that fills the pixels written by a StencilPathOp.
+   */
+  static DepthStencilDescriptor CoverStencil();
+
+  /**
+   * Creates a new StencilPathOp for the given shape in device space. The triangles of the shape
+   * are cached by its UniqueKey, so drawing the same shape again skips the tessellation and upload.
+   */
+  static PlacementPtr<StencilPathOp> Make(Context* context, std::shared_ptr<Shape> shape,
+                                          PathFillType fillType, uint32_t renderFlags);
+
+ protected:
+  PlacementPtr<GeometryProcessor> onMakeGeometryProcessor(RenderTarget* renderTarget) override;
+
+  void onDraw(RenderPass* renderPass) override;
+
+  Type type() override {
+    return Type::StencilPathOp;
+  }
+
+ private:
+  std::shared_ptr<GPUBufferProxy> bufferProxy = nullptr;
+
+  StencilPathOp(BlockAllocator* allocator, PathFillType fillType,
+                std::shared_ptr<GPUBufferProxy> bufferProxy);
+
+  friend class BlockAllocator;
+};
+}  // namespace tgfx
@@ -29,6 +29,10 @@ class AARectEffect : public FragmentProcessor {
     return "AARectEffect";
   }
 
+  bool usesDeviceCoordinates() const override {
+    return true;
+  }
+
  protected:
   DEFINE_PROCESSOR_CLASS_ID
 
@@ -29,7 +29,8 @@ class AtlasTextGeometryProcessor : public GeometryProcessor {
                                                        std::shared_ptr<TextureProxy> textureProxy,
                                                        AAType aa,
                                                        std::optional<PMColor> commonColor,
-                                                       const SamplingOptions& sampling);
+                                                       const SamplingOptions& sampling,
+                                                       bool distanceField = false);
   std::string name() const override {
     return "AtlasTextGeometryProcessor";
   }
@@ -42,7 +43,8 @@ class AtlasTextGeometryProcessor : public GeometryProcessor {
   DEFINE_PROCESSOR_CLASS_ID
 
   AtlasTextGeometryProcessor(std::shared_ptr<TextureProxy> textureProxy, AAType aa,
-                             std::optional<PMColor> commonColor, const SamplingOptions& sampling);
+                             std::optional<PMColor> commonColor, const SamplingOptions& sampling,
+                             bool distanceField);
 
   void onComputeProcessorKey(BytesKey* bytesKey) const override;
 
@@ -59,6 +61,9 @@ class AtlasTextGeometryProcessor : public GeometryProcessor {
   std::shared_ptr<TextureProxy> textureProxy = nullptr;
   AAType aa = AAType::None;
   std::optional<PMColor> commonColor = std::nullopt;
+  // If true, the atlas stores signed distance fields, which are converted to coverage analytically
+  // according to the scale of the glyphs on screen.
+  bool distanceField = false;
   std::vector<std::shared_ptr<Texture>> textures;
   SamplerState samplerState = {};
 };
@@ -31,6 +31,10 @@ class DeviceSpaceTextureEffect : public FragmentProcessor {
     return "DeviceSpaceTextureEffect";
   }
 
+  bool usesDeviceCoordinates() const override {
+    return true;
+  }
+
  protected:
   DEFINE_PROCESSOR_CLASS_ID
 
@@ -42,6 +46,10 @@ class DeviceSpaceTextureEffect : public FragmentProcessor {
 
   std::shared_ptr<Texture> onTextureAt(size_t) const override;
 
+  void onVisitProxies(const std::function<void(const TextureProxy*)>& func) const override {
+    func(textureProxy.get());
+  }
+
   std::shared_ptr<TextureProxy> textureProxy = nullptr;
   Matrix uvMatrix = {};
 };
@@ -94,6 +94,14 @@ void FragmentProcessor::computeProcessorKey(Context* context, BytesKey* bytesKey
   }
 }
 
+void FragmentProcessor::visitProxies(
+    const std::function<void(const TextureProxy*)>& func) const {
+  onVisitProxies(func);
+  for (const auto& childProcessor : childProcessors) {
+    childProcessor->visitProxies(func);
+  }
+}
+
 size_t FragmentProcessor::registerChildProcessor(PlacementPtr<FragmentProcessor> child) {
   auto index = childProcessors.size();
   childProcessors.push_back(std::move(child));
@@ -126,6 +126,19 @@ class FragmentProcessor : public Processor {
 
   void computeProcessorKey(Context* context, BytesKey* bytesKey) const override;
 
+  /**
+   * Calls the given function for each TextureProxy sampled by this processor and its children.
+   */
+  void visitProxies(const std::function<void(const TextureProxy*)>& func) const;
+
+  /**
+   * Returns true if the processor reads the fragment position in device space, which ties its
+   * output to the location of the render target within the backing store.
+   */
+  virtual bool usesDeviceCoordinates() const {
+    return false;
+  }
+
   size_t numChildProcessors() const {
     return childProcessors.size();
   }
@@ -331,6 +344,9 @@ class FragmentProcessor : public Processor {
     return {};
   }
 
+  virtual void onVisitProxies(const std::function<void(const TextureProxy*)>&) const {
+  }
+
   void internalEmitChild(size_t, const std::string&, const std::string&, EmitArgs&,
                          std::function<std::string(std::string_view)> = {}) const;
 
@@ -34,6 +34,10 @@ class PorterDuffXferProcessor : public XferProcessor {
 
   const TextureView* dstTextureView() const override;
 
+  const TextureProxy* dstTextureProxy() const override {
+    return dstTextureInfo.textureProxy.get();
+  }
+
   void computeProcessorKey(Context* context, BytesKey* bytesKey) const override;
 
  protected:
@@ -22,21 +22,21 @@ namespace tgfx {
 QuadPerEdgeAAGeometryProcessor::QuadPerEdgeAAGeometryProcessor(int width, int height, AAType aa,
                                                                std::optional<PMColor> commonColor,
                                                                std::optional<Matrix> uvMatrix,
-                                                               bool hasSubset)
+                                                               bool hasSubset, bool halfUV)
     : GeometryProcessor(ClassID()), width(width), height(height), aa(aa), commonColor(commonColor),
-      uvMatrix(uvMatrix), hasSubset(hasSubset) {
+      uvMatrix(uvMatrix), hasSubset(hasSubset), halfUV(halfUV) {
   position = {"aPosition", VertexFormat::Float2};
   if (aa == AAType::Coverage) {
     coverage = {"inCoverage", VertexFormat::Float};
   }
   if (!uvMatrix.has_value()) {
-    uvCoord = {"uvCoord", VertexFormat::Float2};
+    uvCoord = {"uvCoord", halfUV ? VertexFormat::Half2 : VertexFormat::Float2};
   }
   if (!commonColor.has_value()) {
     color = {"inColor", VertexFormat::UByte4Normalized};
   }
   if (hasSubset) {
-    subset = {"texSubset", VertexFormat::Float4};
+    subset = {"texSubset", halfUV ? VertexFormat::Half4 : VertexFormat::Float4};
   }
   setVertexAttributes(&position, 5);
 }
@@ -48,6 +48,7 @@ void QuadPerEdgeAAGeometryProcessor::onComputeProcessorKey(BytesKey* bytesKey) c
   flags |= hasSubset ? 8 : 0;
   bool hasSubsetMatrix = hasSubset && uvMatrix.has_value();
   flags |= hasSubsetMatrix ? 16 : 0;
+  flags |= halfUV ? 32 : 0;
   bytesKey->write(flags);
 }
 }  // namespace tgfx
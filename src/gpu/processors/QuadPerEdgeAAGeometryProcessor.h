@@ -30,7 +30,7 @@ class QuadPerEdgeAAGeometryProcessor : public GeometryProcessor {
                                                            int height, AAType aa,
                                                            std::optional<PMColor> commonColor,
                                                            std::optional<Matrix> uvMatrix,
-                                                           bool hasSubset);
+                                                           bool hasSubset, bool halfUV);
   std::string name() const override {
     return "QuadPerEdgeAAGeometryProcessor";
   }
@@ -39,7 +39,7 @@ class QuadPerEdgeAAGeometryProcessor : public GeometryProcessor {
   DEFINE_PROCESSOR_CLASS_ID
   QuadPerEdgeAAGeometryProcessor(int width, int height, AAType aa,
                                  std::optional<PMColor> commonColor, std::optional<Matrix> uvMatrix,
-                                 bool hasSubset);
+                                 bool hasSubset, bool halfUV);
 
   void onComputeProcessorKey(BytesKey* bytesKey) const override;
 
@@ -55,5 +55,6 @@ class QuadPerEdgeAAGeometryProcessor : public GeometryProcessor {
   std::optional<PMColor> commonColor = std::nullopt;
   std::optional<Matrix> uvMatrix = std::nullopt;
   bool hasSubset = false;
+  bool halfUV = false;
 };
 }  // namespace tgfx
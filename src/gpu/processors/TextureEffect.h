@@ -56,6 +56,10 @@ class TextureEffect : public FragmentProcessor {
 
   std::shared_ptr<Texture> onTextureAt(size_t index) const override;
 
+  void onVisitProxies(const std::function<void(const TextureProxy*)>& func) const override {
+    func(textureProxy.get());
+  }
+
   SamplerState onSamplerStateAt(size_t) const override {
     return samplerState;
   }
@@ -47,6 +47,10 @@ class TextureGradientColorizer : public FragmentProcessor {
     return textureView ? textureView->getTexture() : nullptr;
   }
 
+  void onVisitProxies(const std::function<void(const TextureProxy*)>& func) const override {
+    func(gradient.get());
+  }
+
   std::shared_ptr<TextureProxy> gradient;
 };
 }  // namespace tgfx
@@ -149,7 +149,7 @@ void TiledTextureEffect::onComputeProcessorKey(BytesKey* bytesKey) const {
   // Sometimes textureProxy->isAlphaOnly() != texture->isAlphaOnly(), we use
   // textureProxy->isAlphaOnly() to determine the alpha-only flag.
   bytesKey->write(textureProxy->isAlphaOnly());
-  Sampling sampling(textureView, samplerState, subset);
+  Sampling sampling(textureView, samplerState, getBackingStoreSubset());
   auto flags = static_cast<uint32_t>(sampling.shaderModeX);
   flags |= static_cast<uint32_t>(sampling.shaderModeY) << 4;
   flags |= constraint == SrcRectConstraint::Strict ? static_cast<uint32_t>(1) << 8 : 0;
@@ -174,7 +174,7 @@ SamplerState TiledTextureEffect::onSamplerStateAt(size_t) const {
   if (textureView == nullptr) {
     return {};
   }
-  Sampling sampling(textureView, samplerState, subset);
+  Sampling sampling(textureView, samplerState, getBackingStoreSubset());
   return sampling.hwSampler;
 }
 
@@ -185,4 +185,9 @@ const TextureView* TiledTextureEffect::getTextureView() const {
   }
   return nullptr;
 }
+
+Rect TiledTextureEffect::getBackingStoreSubset() const {
+  auto offset = textureProxy->backingStoreOffset();
+  return subset.makeOffset(offset.x, offset.y);
+}
 }  // namespace tgfx
@@ -70,10 +70,20 @@ class TiledTextureEffect : public FragmentProcessor {
 
   std::shared_ptr<Texture> onTextureAt(size_t) const override;
 
+  void onVisitProxies(const std::function<void(const TextureProxy*)>& func) const override {
+    func(textureProxy.get());
+  }
+
   SamplerState onSamplerStateAt(size_t) const override;
 
   const TextureView* getTextureView() const;
 
+  /**
+   * Returns the subset in the coordinate space of the backing store, which is offset from the
+   * subset if the texture shares its backing store with others.
+   */
+  Rect getBackingStoreSubset() const;
+
   static ShaderMode GetShaderMode(TileMode tileMode, FilterMode filter, MipmapMode mipmapMode);
 
   std::shared_ptr<TextureProxy> textureProxy;
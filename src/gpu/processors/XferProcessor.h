@@ -53,6 +53,14 @@ class XferProcessor : public Processor {
     return nullptr;
   }
 
+  /**
+   * Returns the TextureProxy of the destination texture, or nullptr if the processor doesn't read
+   * from a destination texture.
+   */
+  virtual const TextureProxy* dstTextureProxy() const {
+    return nullptr;
+  }
+
   virtual void emitCode(const EmitArgs& args) const = 0;
 
   virtual void setData(UniformData* vertexUniformData, UniformData* fragmentUniformData) const = 0;
@@ -0,0 +1,37 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "AtlasRenderTargetProxy.h"
+
+namespace tgfx {
+void AtlasRenderTargetProxy::setAtlasPage(std::shared_ptr<RenderTargetProxy> page, int x, int y) {
+  DEBUG_ASSERT(isPending() && page != nullptr);
+  _backingStoreX = x;
+  _backingStoreY = y;
+  _backingStoreWidth = page->width();
+  _backingStoreHeight = page->height();
+  atlasPage = std::move(page);
+}
+
+std::shared_ptr<TextureView> AtlasRenderTargetProxy::onMakeTexture(Context* context) const {
+  if (atlasPage == nullptr) {
+    return TextureRenderTargetProxy::onMakeTexture(context);
+  }
+  return atlasPage->getTextureView();
+}
+}  // namespace tgfx
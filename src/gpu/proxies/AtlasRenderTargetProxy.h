@@ -0,0 +1,72 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "gpu/proxies/TextureRenderTargetProxy.h"
+
+namespace tgfx {
+/**
+ * AtlasRenderTargetProxy is a small transient render target that may be packed into a shared page
+ * of the render target atlas when the current flush is optimized. Once packed, its content lives
+ * at backingStoreOffset() within the page, and it shares the texture view of the page. Otherwise,
+ * it is instantiated with its own texture view like any other TextureRenderTargetProxy.
+ */
+class AtlasRenderTargetProxy : public TextureRenderTargetProxy {
+ public:
+  /**
+   * The maximum width and height of a render target that can be packed into an atlas page.
+   */
+  static constexpr int MaxEntrySize = 256;
+
+  AtlasRenderTargetProxy* asAtlasRenderTargetProxy() override {
+    return this;
+  }
+
+  /**
+   * Returns true if the proxy is neither instantiated nor packed into an atlas page yet.
+   */
+  bool isPending() const {
+    return resource == nullptr && atlasPage == nullptr;
+  }
+
+  /**
+   * Returns true if the proxy has been packed into an atlas page.
+   */
+  bool isPacked() const {
+    return atlasPage != nullptr;
+  }
+
+  /**
+   * Packs the proxy into the given atlas page at the specified location. The proxy must be pending.
+   */
+  void setAtlasPage(std::shared_ptr<RenderTargetProxy> page, int x, int y);
+
+ protected:
+  std::shared_ptr<TextureView> onMakeTexture(Context* context) const override;
+
+ private:
+  std::shared_ptr<RenderTargetProxy> atlasPage = nullptr;
+
+  AtlasRenderTargetProxy(int width, int height, PixelFormat format)
+      : TextureRenderTargetProxy(width, height, format, 1) {
+  }
+
+  friend class ProxyProvider;
+};
+}  // namespace tgfx
@@ -24,6 +24,8 @@
 #include "tgfx/core/Matrix.h"
 
 namespace tgfx {
+class AtlasRenderTargetProxy;
+
 /**
  * This class defers the acquisition of render targets until they are actually required.
  */
@@ -102,6 +104,14 @@ class RenderTargetProxy {
     return nullptr;
   }
 
+  /**
+   * Returns this proxy as an AtlasRenderTargetProxy if it may be packed into a page of the render
+   * target atlas, otherwise returns nullptr.
+   */
+  virtual AtlasRenderTargetProxy* asAtlasRenderTargetProxy() {
+    return nullptr;
+  }
+
   /**
    * Returns the TextureView associated with the RenderTargetProxy. Returns nullptr if the proxy is
    * not instantiated yet, or it is not backed by a texture view.
@@ -37,6 +37,20 @@ class ResourceProxy {
     return context;
   }
 
+  /**
+   * Returns the UniqueKey assigned to this proxy. The key is empty if no UniqueKey is assigned.
+   */
+  const UniqueKey& getUniqueKey() const {
+    return uniqueKey;
+  }
+
+  /**
+   * Returns true if the backing resource of this proxy has been created.
+   */
+  bool isInstantiated() const {
+    return resource != nullptr;
+  }
+
   void assignUniqueKey(const UniqueKey& key) {
     uniqueKey = key;
     if (resource != nullptr) {
@@ -19,6 +19,7 @@
 #pragma once
 
 #include "ResourceProxy.h"
+#include "gpu/BackingFit.h"
 #include "gpu/resources/TextureView.h"
 
 namespace tgfx {
@@ -59,6 +60,32 @@ class TextureProxy : public ResourceProxy {
     return _backingStoreHeight;
   }
 
+  /**
+   * Returns BackingFit::Approx if the backing store can be larger than the texture size.
+   */
+  BackingFit backingFit() const {
+    return _backingFit;
+  }
+
+  /**
+   * Resizes the backing store of an uninstantiated proxy with approximate size, which allows it to
+   * take over a backing texture of the given size released by another proxy earlier in the flush.
+   */
+  void setBackingStoreSize(int width, int height) {
+    DEBUG_ASSERT(_backingFit == BackingFit::Approx && !isInstantiated());
+    DEBUG_ASSERT(width >= _width && height >= _height);
+    _backingStoreWidth = width;
+    _backingStoreHeight = height;
+  }
+
+  /**
+   * Returns the location of the texture content within the backing store, which is non-zero if the
+   * backing store is shared with other proxies, such as a page of the render target atlas.
+   */
+  Point backingStoreOffset() const {
+    return Point::Make(_backingStoreX, _backingStoreY);
+  }
+
   /**
    * Returns the origin of the texture view, either ImageOrigin::TopLeft or ImageOrigin::BottomLeft.
    */
@@ -109,7 +136,10 @@ class TextureProxy : public ResourceProxy {
   int _height = 0;
   int _backingStoreWidth = 0;
   int _backingStoreHeight = 0;
+  int _backingStoreX = 0;
+  int _backingStoreY = 0;
   PixelFormat _format = PixelFormat::RGBA_8888;
+  BackingFit _backingFit = BackingFit::Exact;
   bool _mipmapped = false;
   ImageOrigin _origin = ImageOrigin::TopLeft;
 
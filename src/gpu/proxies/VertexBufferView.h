@@ -39,10 +39,11 @@ class VertexBufferView {
   }
 
   /**
-   * Returns the offset of the vertex data in the vertex buffer.
+   * Returns the offset of the vertex data in the GPU buffer of the BufferResource.
    */
   size_t offset() const {
-    return _offset;
+    auto buffer = getBuffer();
+    return buffer ? buffer->offset() + _offset : _offset;
   }
 
   /**
@@ -33,18 +33,41 @@ class BufferResource : public Resource {
    */
   static std::shared_ptr<BufferResource> Wrap(Context* context, std::shared_ptr<GPUBuffer> buffer,
                                               const ScratchKey& scratchKey = {}) {
-    return Resource::AddToCache(context, new BufferResource(std::move(buffer)), scratchKey);
+    auto size = buffer->size();
+    return Resource::AddToCache(context, new BufferResource(std::move(buffer), 0, size),
+                                scratchKey);
+  }
+
+  /**
+   * Wraps a region of an existing GPUBuffer that is shared with other resources, such as the
+   * streaming vertex buffers. Only the size of the region counts toward the memory usage.
+   */
+  static std::shared_ptr<BufferResource> WrapRegion(Context* context,
+                                                    std::shared_ptr<GPUBuffer> buffer,
+                                                    size_t offset, size_t size) {
+    return Resource::AddToCache(context, new BufferResource(std::move(buffer), offset, size));
   }
 
   size_t memoryUsage() const override {
-    return buffer->size();
+    return _size;
+  }
+
+  ResourceCategory category() const override {
+    return ResourceCategory::Buffer;
   }
 
   /**
    * Returns the size of the BufferResource in bytes.
    */
   size_t size() const {
-    return buffer->size();
+    return _size;
+  }
+
+  /**
+   * Returns the offset of the BufferResource within the GPUBuffer in bytes.
+   */
+  size_t offset() const {
+    return _offset;
   }
 
   /**
@@ -56,8 +79,11 @@ class BufferResource : public Resource {
 
  private:
   std::shared_ptr<GPUBuffer> buffer = nullptr;
+  size_t _offset = 0;
+  size_t _size = 0;
 
-  explicit BufferResource(std::shared_ptr<GPUBuffer> buffer) : buffer(std::move(buffer)) {
+  BufferResource(std::shared_ptr<GPUBuffer> buffer, size_t offset, size_t size)
+      : buffer(std::move(buffer)), _offset(offset), _size(size) {
   }
 };
 }  // namespace tgfx
@@ -48,6 +48,10 @@ class ExternalRenderTarget : public Resource, public RenderTarget {
     return 0;
   }
 
+  ResourceCategory category() const override {
+    return ResourceCategory::RenderTarget;
+  }
+
  private:
   std::shared_ptr<Texture> renderTexture = nullptr;
   ImageOrigin _origin = ImageOrigin::TopLeft;
@@ -29,6 +29,13 @@ void Resource::assignUniqueKey(const UniqueKey& newKey) {
   }
 }
 
+size_t Resource::regenerationCost() const {
+  if (uniqueKey.empty()) {
+    return 0;
+  }
+  return hasRegenerationCost ? _regenerationCost : memoryUsage();
+}
+
 void Resource::removeUniqueKey() {
   if (!uniqueKey.empty()) {
     context->resourceCache()->removeUniqueKey(this);
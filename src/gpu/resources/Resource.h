@@ -66,6 +66,30 @@ class Resource : public ReturnNode {
    */
   virtual size_t memoryUsage() const = 0;
 
+  /**
+   * Returns the category of this resource, which decides the cache limit it counts toward.
+   */
+  virtual ResourceCategory category() const {
+    return ResourceCategory::Other;
+  }
+
+  /**
+   * Returns the estimated cost to regenerate the content of this resource after it is purged,
+   * measured in the same unit as memoryUsage(). A resource without a UniqueKey has no content worth
+   * keeping, so its cost is always zero. Otherwise, the cost defaults to memoryUsage(), which
+   * roughly matches drawing the content again.
+   */
+  size_t regenerationCost() const;
+
+  /**
+   * Sets a hint for the cost to regenerate the content of this resource. When the cache is over
+   * its limits, the resources with the lowest regeneration cost per byte are purged first.
+   */
+  void setRegenerationCost(size_t cost) {
+    _regenerationCost = cost;
+    hasRegenerationCost = true;
+  }
+
   /**
    * Assigns a UniqueKey to the resource. The resource will be findable via this UniqueKey using
    * ResourceCache.findUniqueResource(). This method is not thread safe, call it only when the
@@ -89,6 +113,8 @@ class Resource : public ReturnNode {
   std::list<Resource*>* cachedList = nullptr;
   std::list<Resource*>::iterator cachedPosition;
   std::chrono::steady_clock::time_point lastUsedTime = {};
+  size_t _regenerationCost = 0;
+  bool hasRegenerationCost = false;
 
   bool isPurgeable() const {
     return weakThis.expired();
@@ -69,6 +69,12 @@ bool ResourceKey::operator==(const ResourceKey& that) const {
   return memcmp(data, that.data, count * sizeof(uint32_t)) == 0;
 }
 
+void ResourceKey::writeTo(BytesKey* bytesKey) const {
+  for (size_t i = 0; i < count; i++) {
+    bytesKey->write(data[i]);
+  }
+}
+
 ScratchKey::ScratchKey(uint32_t* data, size_t count) : ResourceKey(data, count) {
 }
 
@@ -58,6 +58,12 @@ class ResourceKey {
     return !(*this == that);
   }
 
+  /**
+   * Writes all the data of the key to the given BytesKey, so that the key can be combined with other
+   * values into a single BytesKey.
+   */
+  void writeTo(BytesKey* bytesKey) const;
+
  protected:
   ResourceKey(uint32_t* data, size_t count);
 
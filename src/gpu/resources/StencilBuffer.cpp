@@ -0,0 +1,54 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "StencilBuffer.h"
+#include "core/utils/Log.h"
+#include "core/utils/UniqueID.h"
+#include "tgfx/gpu/GPU.h"
+
+namespace tgfx {
+std::shared_ptr<StencilBuffer> StencilBuffer::Make(Context* context, int width, int height,
+                                                   int sampleCount) {
+  if (context == nullptr || width <= 0 || height <= 0) {
+    return nullptr;
+  }
+  static const uint32_t StencilBufferType = UniqueID::Next();
+  BytesKey bytesKey(4);
+  bytesKey.write(StencilBufferType);
+  bytesKey.write(width);
+  bytesKey.write(height);
+  bytesKey.write(sampleCount);
+  ScratchKey scratchKey = bytesKey;
+  if (auto stencilBuffer = Resource::Find<StencilBuffer>(context, scratchKey)) {
+    return stencilBuffer;
+  }
+  TextureDescriptor descriptor(width, height, PixelFormat::DEPTH24_STENCIL8, false, sampleCount,
+                               TextureUsage::RENDER_ATTACHMENT);
+  auto texture = context->gpu()->createTexture(descriptor);
+  if (texture == nullptr) {
+    LOGE("StencilBuffer::Make() Failed to create the depth-stencil texture!");
+    return nullptr;
+  }
+  return Resource::AddToCache(context, new StencilBuffer(std::move(texture)), scratchKey);
+}
+
+size_t StencilBuffer::memoryUsage() const {
+  return static_cast<size_t>(texture->width()) * static_cast<size_t>(texture->height()) *
+         static_cast<size_t>(texture->sampleCount()) * 4;
+}
+}  // namespace tgfx
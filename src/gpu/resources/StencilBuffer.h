@@ -0,0 +1,57 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "gpu/resources/Resource.h"
+#include "tgfx/gpu/Texture.h"
+
+namespace tgfx {
+/**
+ * StencilBuffer is a resource that encapsulates a depth-stencil texture, which can be attached to
+ * the render passes of any render target with the same size and sample count.
+ */
+class StencilBuffer : public Resource {
+ public:
+  /**
+   * Returns a StencilBuffer with the given size and sample count, reusing an unused one in the
+   * cache if possible. Returns nullptr if the texture cannot be created.
+   */
+  static std::shared_ptr<StencilBuffer> Make(Context* context, int width, int height,
+                                             int sampleCount = 1);
+
+  size_t memoryUsage() const override;
+
+  ResourceCategory category() const override {
+    return ResourceCategory::RenderTarget;
+  }
+
+  /**
+   * Returns the depth-stencil texture of the StencilBuffer.
+   */
+  std::shared_ptr<Texture> getTexture() const {
+    return texture;
+  }
+
+ private:
+  std::shared_ptr<Texture> texture = nullptr;
+
+  explicit StencilBuffer(std::shared_ptr<Texture> texture) : texture(std::move(texture)) {
+  }
+};
+}  // namespace tgfx
@@ -28,6 +28,10 @@ class TextureRenderTarget : public DefaultTextureView, public RenderTarget {
     return context;
   }
 
+  ResourceCategory category() const override {
+    return ResourceCategory::RenderTarget;
+  }
+
   ImageOrigin origin() const override {
     return _origin;
   }
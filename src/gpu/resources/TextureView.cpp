@@ -31,8 +31,12 @@ bool TextureView::CheckSizeAndFormat(Context* context, int width, int height, Pi
   if (context == nullptr || width < 1 || height < 1) {
     return false;
   }
-  if (format != PixelFormat::ALPHA_8 && format != PixelFormat::RGBA_8888 &&
-      format != PixelFormat::BGRA_8888) {
+  if (format == PixelFormat::ETC2_RGBA8) {
+    if (!context->gpu()->features()->textureCompressionETC2) {
+      return false;
+    }
+  } else if (format != PixelFormat::ALPHA_8 && format != PixelFormat::RGBA_8888 &&
+             format != PixelFormat::BGRA_8888) {
     return false;
   }
   auto maxTextureSize = context->gpu()->limits()->maxTextureDimension2D;
@@ -172,6 +172,10 @@ class TextureView : public Resource {
     return getTexture()->height();
   }
 
+  ResourceCategory category() const override {
+    return ResourceCategory::Texture;
+  }
+
   /**
    * Returns the origin of the texture view, either ImageOrigin::TopLeft or ImageOrigin::BottomLeft.
    */
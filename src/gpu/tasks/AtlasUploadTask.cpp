@@ -17,8 +17,9 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "AtlasUploadTask.h"
+#include <algorithm>
 #include "core/AtlasTypes.h"
-#include "core/utils/BlockAllocator.h"
+#include "core/GlyphRasterizer.h"
 #include "core/utils/ClearPixels.h"
 #include "core/utils/HardwareBufferUtil.h"
 #include "tgfx/core/Task.h"
@@ -27,22 +28,8 @@
 namespace tgfx {
 class CellDecodeTask : public Task {
  public:
-  CellDecodeTask(std::shared_ptr<ImageCodec> imageCodec, void* dstPixels, const ImageInfo& dstInfo,
-                 int offsetX, int offsetY)
-      : imageCodec(std::move(imageCodec)), dstPixels(dstPixels), dstInfo(dstInfo), offsetX(offsetX),
-        offsetY(offsetY) {
-  }
-
-  const ImageInfo& info() const {
-    return dstInfo;
-  }
-
-  void* pixels() const {
-    return dstPixels;
-  }
-
-  Rect atlasRect() const {
-    return Rect::MakeXYWH(offsetX, offsetY, dstInfo.width(), dstInfo.height());
+  CellDecodeTask(std::shared_ptr<ImageCodec> imageCodec, void* dstPixels, const ImageInfo& dstInfo)
+      : imageCodec(std::move(imageCodec)), dstPixels(dstPixels), dstInfo(dstInfo) {
   }
 
  protected:
@@ -63,8 +50,61 @@ class CellDecodeTask : public Task {
   std::shared_ptr<ImageCodec> imageCodec = nullptr;
   void* dstPixels = nullptr;
   ImageInfo dstInfo = {};
-  int offsetX = 0;
-  int offsetY = 0;
+};
+
+/**
+ * The max number of glyphs rasterized by a single GlyphBatchTask.
+ */
+static constexpr size_t MAX_GLYPH_BATCH_SIZE = 32;
+
+class GlyphBatchTask : public Task {
+ public:
+  explicit GlyphBatchTask(std::shared_ptr<ScalerContext> scalerContext)
+      : scalerContext(std::move(scalerContext)) {
+  }
+
+  const ScalerContext* getScalerContext() const {
+    return scalerContext.get();
+  }
+
+  size_t glyphCount() const {
+    return cells.size();
+  }
+
+  void addGlyph(std::shared_ptr<GlyphRasterizer> rasterizer, const ImageInfo& dstInfo,
+                void* dstPixels) {
+    cells.push_back({std::move(rasterizer), dstInfo, dstPixels});
+  }
+
+ protected:
+  void onExecute() override {
+    std::vector<GlyphPixelsRequest> requests = {};
+    requests.reserve(cells.size());
+    for (auto& cell : cells) {
+      ClearPixels(cell.dstInfo, cell.dstPixels);
+      auto& rasterizer = cell.rasterizer;
+      auto targetInfo = cell.dstInfo.makeIntersect(0, 0, rasterizer->width(), rasterizer->height());
+      auto targetPixels =
+          cell.dstInfo.computeOffset(cell.dstPixels, Plot::CellPadding, Plot::CellPadding);
+      requests.push_back(rasterizer->makePixelsRequest(targetInfo, targetPixels));
+    }
+    scalerContext->readPixelsInBatch(requests);
+    cells.clear();
+  }
+
+  void onCancel() override {
+    cells.clear();
+  }
+
+ private:
+  struct GlyphCell {
+    std::shared_ptr<GlyphRasterizer> rasterizer = nullptr;
+    ImageInfo dstInfo = {};
+    void* dstPixels = nullptr;
+  };
+
+  std::shared_ptr<ScalerContext> scalerContext = nullptr;
+  std::vector<GlyphCell> cells = {};
 };
 
 AtlasUploadTask::AtlasUploadTask(std::shared_ptr<TextureProxy> proxy)
@@ -105,48 +145,116 @@ static ImageInfo MakeAtlasCellInfo(int width, int height, bool isAlphaOnly) {
                          ColorSpace::SRGB());
 }
 
-void AtlasUploadTask::addCell(BlockAllocator* allocator, std::shared_ptr<ImageCodec> codec,
-                              const Point& atlasOffset) {
-  DEBUG_ASSERT(codec != nullptr);
+AtlasUploadTask::PlotUpload* AtlasUploadTask::getPlotUpload(Plot* plot) {
+  for (auto& plotUpload : plotUploads) {
+    if (plotUpload.plot == plot) {
+      return &plotUpload;
+    }
+  }
+  auto info = MakeAtlasCellInfo(plot->width(), plot->height(), textureProxy->isAlphaOnly());
+  auto pixels = plot->getShadowPixels(info.byteSize());
+  if (pixels == nullptr) {
+    return nullptr;
+  }
+  plotUploads.push_back({plot, info, std::move(pixels), Rect::MakeEmpty()});
+  return &plotUploads.back();
+}
+
+bool AtlasUploadTask::getCellPixels(Plot* plot, const Point& atlasOffset, int width, int height,
+                                    ImageInfo* dstInfo, void** dstPixels) {
+  DEBUG_ASSERT(plot != nullptr);
   auto padding = Plot::CellPadding;
-  void* dstPixels = nullptr;
-  auto dstWidth = codec->width() + 2 * padding;
-  auto dstHeight = codec->height() + 2 * padding;
+  auto dstWidth = width + 2 * padding;
+  auto dstHeight = height + 2 * padding;
   auto offsetX = static_cast<int>(atlasOffset.x) - padding;
   auto offsetY = static_cast<int>(atlasOffset.y) - padding;
-  ImageInfo dstInfo = {};
   if (hardwarePixels != nullptr) {
-    dstInfo = hardwareInfo.makeIntersect(offsetX, offsetY, dstWidth, dstHeight);
-    dstPixels = hardwareInfo.computeOffset(hardwarePixels, offsetX, offsetY);
-  } else {
-    dstInfo = MakeAtlasCellInfo(dstWidth, dstHeight, codec->isAlphaOnly());
-    auto length = dstInfo.byteSize();
-    dstPixels = allocator->allocate(length);
-    if (dstPixels == nullptr) {
-      LOGE("AtlasUploadTask::addCell failed to allocate %zu bytes for atlas cell", length);
-      return;
-    }
+    *dstInfo = hardwareInfo.makeIntersect(offsetX, offsetY, dstWidth, dstHeight);
+    *dstPixels = hardwareInfo.computeOffset(hardwarePixels, offsetX, offsetY);
+    return true;
+  }
+  auto plotUpload = getPlotUpload(plot);
+  if (plotUpload == nullptr) {
+    return false;
+  }
+  // The padded cells never cross the bounds of their plots.
+  auto plotX = offsetX - static_cast<int>(plot->pixelOffset().x);
+  auto plotY = offsetY - static_cast<int>(plot->pixelOffset().y);
+  *dstInfo = plotUpload->info.makeIntersect(plotX, plotY, dstWidth, dstHeight);
+  *dstPixels = plotUpload->info.computeOffset(plotUpload->pixels.get(), plotX, plotY);
+  plotUpload->dirtyRect.join(Rect::MakeXYWH(plotX, plotY, dstWidth, dstHeight));
+  return true;
+}
+
+void AtlasUploadTask::addCell(std::shared_ptr<ImageCodec> codec, Plot* plot,
+                              const Point& atlasOffset) {
+  DEBUG_ASSERT(codec != nullptr);
+  ImageInfo dstInfo = {};
+  void* dstPixels = nullptr;
+  if (!getCellPixels(plot, atlasOffset, codec->width(), codec->height(), &dstInfo, &dstPixels)) {
+    return;
   }
-  auto task =
-      std::make_shared<CellDecodeTask>(std::move(codec), dstPixels, dstInfo, offsetX, offsetY);
+  auto task = std::make_shared<CellDecodeTask>(std::move(codec), dstPixels, dstInfo);
   Task::Run(task);
   tasks.emplace_back(std::move(task));
 }
 
+void AtlasUploadTask::addGlyphCell(std::shared_ptr<GlyphRasterizer> rasterizer, Plot* plot,
+                                   const Point& atlasOffset) {
+  DEBUG_ASSERT(rasterizer != nullptr);
+  ImageInfo dstInfo = {};
+  void* dstPixels = nullptr;
+  if (!getCellPixels(plot, atlasOffset, rasterizer->width(), rasterizer->height(), &dstInfo,
+                     &dstPixels)) {
+    return;
+  }
+  auto scalerContext = rasterizer->getScalerContext();
+  auto result = std::find_if(pendingGlyphBatches.begin(), pendingGlyphBatches.end(),
+                             [&](const std::shared_ptr<GlyphBatchTask>& batch) {
+                               return batch->getScalerContext() == scalerContext.get();
+                             });
+  if (result == pendingGlyphBatches.end()) {
+    pendingGlyphBatches.push_back(std::make_shared<GlyphBatchTask>(std::move(scalerContext)));
+    result = pendingGlyphBatches.end() - 1;
+  }
+  auto batch = *result;
+  batch->addGlyph(std::move(rasterizer), dstInfo, dstPixels);
+  if (batch->glyphCount() >= MAX_GLYPH_BATCH_SIZE) {
+    pendingGlyphBatches.erase(result);
+    Task::Run(batch);
+    tasks.emplace_back(std::move(batch));
+  }
+}
+
+void AtlasUploadTask::submitPendingGlyphs() {
+  for (auto& batch : pendingGlyphBatches) {
+    Task::Run(batch);
+    tasks.emplace_back(std::move(batch));
+  }
+  pendingGlyphBatches.clear();
+}
+
 void AtlasUploadTask::upload(Context* context) {
   auto textureView = textureProxy->getTextureView();
   if (textureView == nullptr) {
     return;
   }
-  auto queue = context->gpu()->queue();
+  submitPendingGlyphs();
   for (auto& task : tasks) {
     task->wait();
-    if (!hardwarePixels) {
-      queue->writeTexture(textureView->getTexture(), task->atlasRect(), task->pixels(),
-                          task->info().rowBytes());
-    }
   }
   tasks.clear();
+  auto queue = context->gpu()->queue();
+  for (auto& plotUpload : plotUploads) {
+    auto& dirtyRect = plotUpload.dirtyRect;
+    auto pixels =
+        plotUpload.info.computeOffset(plotUpload.pixels.get(), static_cast<int>(dirtyRect.left),
+                                      static_cast<int>(dirtyRect.top));
+    auto& pixelOffset = plotUpload.plot->pixelOffset();
+    auto atlasRect = dirtyRect.makeOffset(pixelOffset.x, pixelOffset.y);
+    queue->writeTexture(textureView->getTexture(), atlasRect, pixels, plotUpload.info.rowBytes());
+  }
+  plotUploads.clear();
 }
 
 }  // namespace tgfx
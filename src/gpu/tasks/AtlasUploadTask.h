@@ -23,23 +23,56 @@
 #include "tgfx/gpu/Context.h"
 
 namespace tgfx {
-class CellDecodeTask;
+class Task;
+class GlyphBatchTask;
+class GlyphRasterizer;
+class Plot;
 
+/**
+ * AtlasUploadTask rasterizes the cells added to an atlas page during a flush and uploads them to
+ * the page's texture. Unless the page is backed by a hardware buffer, the cells are rasterized into
+ * the shadow pixels of their plots, and each plot uploads the bounds of its new cells only once.
+ */
 class AtlasUploadTask {
  public:
   explicit AtlasUploadTask(std::shared_ptr<TextureProxy> proxy);
 
   ~AtlasUploadTask();
 
-  void addCell(BlockAllocator* allocator, std::shared_ptr<ImageCodec> codec,
-               const Point& atlasOffset);
+  void addCell(std::shared_ptr<ImageCodec> codec, Plot* plot, const Point& atlasOffset);
+
+  /**
+   * Adds a glyph cell. Glyphs sharing the same ScalerContext are rasterized together by one task,
+   * which starts once the batch is full or when submitPendingGlyphs() is called.
+   */
+  void addGlyphCell(std::shared_ptr<GlyphRasterizer> rasterizer, Plot* plot,
+                    const Point& atlasOffset);
+
+  /**
+   * Starts the tasks of all the glyph batches that are not full yet.
+   */
+  void submitPendingGlyphs();
 
   void upload(Context* context);
 
  private:
+  struct PlotUpload {
+    Plot* plot = nullptr;
+    ImageInfo info = {};
+    std::shared_ptr<uint8_t[]> pixels = nullptr;
+    Rect dirtyRect = {};
+  };
+
   std::shared_ptr<TextureProxy> textureProxy = nullptr;
   ImageInfo hardwareInfo = {};
   void* hardwarePixels = nullptr;
-  std::vector<std::shared_ptr<CellDecodeTask>> tasks = {};
+  std::vector<PlotUpload> plotUploads = {};
+  std::vector<std::shared_ptr<GlyphBatchTask>> pendingGlyphBatches = {};
+  std::vector<std::shared_ptr<Task>> tasks = {};
+
+  PlotUpload* getPlotUpload(Plot* plot);
+
+  bool getCellPixels(Plot* plot, const Point& atlasOffset, int width, int height,
+                     ImageInfo* dstInfo, void** dstPixels);
 };
 }  // namespace tgfx
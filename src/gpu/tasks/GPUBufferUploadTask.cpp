@@ -17,6 +17,8 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "GPUBufferUploadTask.h"
+#include <cstring>
+#include "gpu/GlobalCache.h"
 #include "gpu/resources/BufferResource.h"
 #include "inspect/InspectorMark.h"
 #include "tgfx/gpu/GPU.h"
@@ -40,6 +42,9 @@ std::shared_ptr<Resource> GPUBufferUploadTask::onMakeResource(Context* context)
     return nullptr;
   }
   auto gpu = context->gpu();
+  if (bufferType == BufferType::Vertex) {
+    return uploadToStreamingBuffer(context, std::move(data));
+  }
   auto usage = bufferType == BufferType::Index ? GPUBufferUsage::INDEX : GPUBufferUsage::VERTEX;
   auto gpuBuffer = gpu->createBuffer(data->size(), usage);
   if (!gpuBuffer) {
@@ -51,4 +56,26 @@ std::shared_ptr<Resource> GPUBufferUploadTask::onMakeResource(Context* context)
   source = nullptr;
   return BufferResource::Wrap(context, std::move(gpuBuffer));
 }
+
+std::shared_ptr<Resource> GPUBufferUploadTask::uploadToStreamingBuffer(
+    Context* context, std::shared_ptr<Data> data) {
+  // The shared vertices only live for the current flush, so they go to a region of the streaming
+  // vertex buffers instead of a newly created buffer.
+  size_t offset = 0;
+  auto gpuBuffer = context->globalCache()->allocateVertexBuffer(data->size(), &offset);
+  if (!gpuBuffer) {
+    LOGE("GPUBufferUploadTask::uploadToStreamingBuffer() Failed to allocate buffer!");
+    return nullptr;
+  }
+  auto size = data->size();
+  if (auto pointer = gpuBuffer->map(offset, size)) {
+    memcpy(pointer, data->data(), size);
+    gpuBuffer->unmap();
+  } else {
+    context->gpu()->queue()->writeBuffer(gpuBuffer, offset, data->data(), size);
+  }
+  // Free the data source immediately to reduce memory pressure.
+  source = nullptr;
+  return BufferResource::WrapRegion(context, std::move(gpuBuffer), offset, size);
+}
 }  // namespace tgfx
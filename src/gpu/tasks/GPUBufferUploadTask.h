@@ -26,6 +26,8 @@ namespace tgfx {
 enum class BufferType {
   Index,
   Vertex,
+  // Vertices that are kept across flushes, which get a buffer of their own.
+  CachedVertex,
 };
 
 class GPUBufferUploadTask : public ResourceTask {
@@ -39,5 +41,7 @@ class GPUBufferUploadTask : public ResourceTask {
  private:
   BufferType bufferType = BufferType::Vertex;
   std::unique_ptr<DataSource<Data>> source = nullptr;
+
+  std::shared_ptr<Resource> uploadToStreamingBuffer(Context* context, std::shared_ptr<Data> data);
 };
 }  // namespace tgfx
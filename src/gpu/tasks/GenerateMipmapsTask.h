@@ -28,6 +28,14 @@ class GenerateMipmapsTask : public RenderTask {
 
   void execute(CommandEncoder* encoder) override;
 
+  const void* outputProxyID() const override {
+    return GetProxyID(textureProxy.get());
+  }
+
+  bool isOutputTransient(long taskRefCount) const override {
+    return IsTransientProxy(textureProxy, taskRefCount);
+  }
+
  private:
   std::shared_ptr<TextureProxy> textureProxy = nullptr;
 };
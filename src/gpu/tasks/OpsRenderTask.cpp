@@ -17,7 +17,8 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "OpsRenderTask.h"
-#include "gpu/proxies/RenderTargetProxy.h"
+#include "gpu/proxies/AtlasRenderTargetProxy.h"
+#include "gpu/resources/StencilBuffer.h"
 #include "inspect/InspectorMark.h"
 #include "tgfx/gpu/RenderPass.h"
 
@@ -32,18 +33,109 @@ void OpsRenderTask::execute(CommandEncoder* encoder) {
   auto loadOp = clearColor.has_value() ? LoadAction::Clear : LoadAction::Load;
   auto resolveTexture =
       renderTarget->sampleCount() > 1 ? renderTarget->getSampleTexture() : nullptr;
-  RenderPassDescriptor descriptor(renderTarget->getRenderTexture(), loadOp, StoreAction::Store,
+  auto renderTexture = renderTarget->getRenderTexture();
+  RenderPassDescriptor descriptor(renderTexture, loadOp, StoreAction::Store,
                                   clearColor.value_or(PMColor::Transparent()), resolveTexture);
+  std::shared_ptr<StencilBuffer> stencilBuffer = nullptr;
+  if (usesStencil()) {
+    stencilBuffer = StencilBuffer::Make(renderTarget->getContext(), renderTexture->width(),
+                                        renderTexture->height(), renderTarget->sampleCount());
+    if (stencilBuffer == nullptr) {
+      LOGE("OpsRenderTask::execute() Failed to create the stencil buffer!");
+      return;
+    }
+    // The stencil ops reset the stencil values they touch, so the content is never stored.
+    descriptor.depthStencilAttachment =
+        DepthStencilAttachment(stencilBuffer->getTexture(), LoadAction::Clear);
+  }
   auto renderPass = encoder->beginRenderPass(descriptor);
   if (renderPass == nullptr) {
     LOGE("OpsRenderTask::execute() Failed to initialize the render pass!");
     return;
   }
+  executeOps(renderPass.get(), renderTarget.get());
+  for (auto& task : atlasTasks) {
+    task->asOpsRenderTask()->executeOps(renderPass.get(), renderTarget.get());
+    task = nullptr;
+  }
+  renderPass->end();
+}
+
+void OpsRenderTask::executeOps(RenderPass* renderPass, RenderTarget* renderTarget) {
+  auto renderBounds = renderTarget->bounds();
+  auto atlasProxy = renderTargetProxy->asAtlasRenderTargetProxy();
+  if (atlasProxy != nullptr && atlasProxy->isPacked()) {
+    // Shift the viewport to the region of the atlas page, so the draw ops can be recorded without
+    // knowing where the render target is located in the page.
+    auto offset = atlasProxy->backingStoreOffset();
+    auto x = static_cast<int>(offset.x);
+    auto y = static_cast<int>(offset.y);
+    renderPass->setViewport(x, y, renderTarget->width(), renderTarget->height());
+    renderBounds = Rect::MakeXYWH(x, y, atlasProxy->width(), atlasProxy->height());
+  }
   for (auto& op : drawOps) {
-    op->execute(renderPass.get(), renderTarget.get());
+    op->execute(renderPass, renderTarget, renderBounds);
     // Release the Op immediately after execution to maximize GPU resource reuse.
     op = nullptr;
   }
-  renderPass->end();
+}
+
+bool OpsRenderTask::isAtlasCompatible() const {
+  if (clearColor.has_value() && *clearColor != PMColor::Transparent()) {
+    return false;
+  }
+  for (auto& op : drawOps) {
+    if (op->usesDeviceCoordinates() || op->usesStencil()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool OpsRenderTask::usesStencil() const {
+  for (auto& op : drawOps) {
+    if (op->usesStencil()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void OpsRenderTask::addAtlasTask(PlacementPtr<RenderTask> task) {
+  DEBUG_ASSERT(task != nullptr && task->asOpsRenderTask() != nullptr);
+  clearColor = PMColor::Transparent();
+  atlasTasks.push_back(std::move(task));
+}
+
+void OpsRenderTask::collectInputProxyIDs(std::vector<const void*>* proxyIDs) const {
+  for (auto& op : drawOps) {
+    op->visitProxies(
+        [proxyIDs](const TextureProxy* proxy) { proxyIDs->push_back(GetProxyID(proxy)); });
+  }
+  for (auto& task : atlasTasks) {
+    task->collectInputProxyIDs(proxyIDs);
+  }
+}
+
+void OpsRenderTask::merge(OpsRenderTask* task) {
+  DEBUG_ASSERT(task != nullptr && task->renderTargetProxy == renderTargetProxy);
+  DEBUG_ASSERT(!task->clearColor.has_value());
+  if (task->drawOps.empty()) {
+    return;
+  }
+  if (drawOps.empty()) {
+    drawOps = std::move(task->drawOps);
+    return;
+  }
+  auto mergedOps = allocator->makeArray<DrawOp>(drawOps.size() + task->drawOps.size());
+  size_t index = 0;
+  for (auto& op : drawOps) {
+    mergedOps[index++] = std::move(op);
+  }
+  for (auto& op : task->drawOps) {
+    mergedOps[index++] = std::move(op);
+  }
+  drawOps = std::move(mergedOps);
+  task->drawOps.clear();
 }
 }  // namespace tgfx
@@ -33,9 +33,61 @@ class OpsRenderTask : public RenderTask {
 
   void execute(CommandEncoder* encoder) override;
 
+  const void* outputProxyID() const override {
+    return GetProxyID(renderTargetProxy.get());
+  }
+
+  void collectInputProxyIDs(std::vector<const void*>* proxyIDs) const override;
+
+  bool isOutputTransient(long taskRefCount) const override {
+    return IsTransientProxy(renderTargetProxy, taskRefCount);
+  }
+
+  OpsRenderTask* asOpsRenderTask() override {
+    return this;
+  }
+
+  /**
+   * Returns the render target proxy this task draws into.
+   */
+  RenderTargetProxy* renderTarget() const {
+    return renderTargetProxy.get();
+  }
+
+  /**
+   * Returns true if the render target is cleared before the draw ops are executed.
+   */
+  bool hasClearColor() const {
+    return clearColor.has_value();
+  }
+
+  /**
+   * Moves all draw ops of the given task to the end of this task. Both tasks must draw into the
+   * same render target, and the given task must not clear it.
+   */
+  void merge(OpsRenderTask* task);
+
+  /**
+   * Returns true if the draw ops of this task can be drawn into a region of a shared atlas page,
+   * which requires the task to clear with transparent black only and the draw ops to be
+   * independent of the location of the render target within the backing store.
+   */
+  bool isAtlasCompatible() const;
+
+  /**
+   * Appends a task drawing into another region of the same atlas page, so that both tasks are
+   * executed within a single render pass. The whole page is cleared at the beginning of the pass.
+   */
+  void addAtlasTask(PlacementPtr<RenderTask> task);
+
  private:
   std::shared_ptr<RenderTargetProxy> renderTargetProxy = nullptr;
   PlacementArray<DrawOp> drawOps = {};
   std::optional<PMColor> clearColor = std::nullopt;
+  std::vector<PlacementPtr<RenderTask>> atlasTasks = {};
+
+  void executeOps(RenderPass* renderPass, RenderTarget* renderTarget);
+
+  bool usesStencil() const;
 };
 }  // namespace tgfx
@@ -29,6 +29,18 @@ class RenderTargetCopyTask : public RenderTask {
 
   void execute(CommandEncoder* encoder) override;
 
+  const void* outputProxyID() const override {
+    return GetProxyID(dest.get());
+  }
+
+  void collectInputProxyIDs(std::vector<const void*>* proxyIDs) const override {
+    proxyIDs->push_back(GetProxyID(source.get()));
+  }
+
+  bool isOutputTransient(long taskRefCount) const override {
+    return IsTransientProxy(dest, taskRefCount);
+  }
+
  private:
   std::shared_ptr<RenderTargetProxy> source = nullptr;
   std::shared_ptr<TextureProxy> dest = nullptr;
@@ -0,0 +1,50 @@
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Tencent is pleased to support the open source community by making tgfx available.
+//
+//  Copyright (C) 2025 Tencent. All rights reserved.
+//
+//  Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+//  in compliance with the License. You may obtain a copy of the License at
+//
+//      https://opensource.org/licenses/BSD-3-Clause
+//
+//  unless required by applicable law or agreed to in writing, software distributed under the
+//  license is distributed on an "as is" basis, without warranties or conditions of any kind,
+//  either express or implied. see the license for the specific language governing permissions
+//  and limitations under the license.
+//
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "RenderTask.h"
+#include "gpu/proxies/RenderTargetProxy.h"
+
+namespace tgfx {
+const void* RenderTask::GetProxyID(const RenderTargetProxy* proxy) {
+  if (proxy == nullptr) {
+    return nullptr;
+  }
+  auto textureProxy = proxy->asTextureProxy();
+  return textureProxy ? GetProxyID(textureProxy.get()) : proxy;
+}
+
+bool RenderTask::IsTransientProxy(const std::shared_ptr<RenderTargetProxy>& proxy,
+                                  long taskRefCount) {
+  if (proxy == nullptr || proxy->externallyOwned()) {
+    return false;
+  }
+  auto textureProxy = proxy->asTextureProxy();
+  if (textureProxy == nullptr) {
+    return false;
+  }
+  // The textureProxy above holds one extra reference to the same proxy.
+  return IsTransientProxy(textureProxy, taskRefCount + 1);
+}
+
+bool RenderTask::IsTransientProxy(const std::shared_ptr<TextureProxy>& proxy, long taskRefCount) {
+  if (proxy == nullptr || !proxy->getUniqueKey().empty()) {
+    return false;
+  }
+  return proxy.use_count() <= taskRefCount;
+}
+}  // namespace tgfx
@@ -18,12 +18,31 @@
 
 #pragma once
 
+#include <vector>
 #include "core/utils/BlockAllocator.h"
 #include "tgfx/gpu/CommandEncoder.h"
 
 namespace tgfx {
+class TextureProxy;
+class RenderTargetProxy;
+class OpsRenderTask;
+
 class RenderTask {
  public:
+  /**
+   * Returns the ID used to identify the surface of the given proxy in the render task graph. A
+   * RenderTargetProxy backed by a texture shares the same ID with its TextureProxy.
+   */
+  static const void* GetProxyID(const TextureProxy* proxy) {
+    return proxy;
+  }
+
+  /**
+   * Returns the ID used to identify the surface of the given proxy in the render task graph. A
+   * RenderTargetProxy backed by a texture shares the same ID with its TextureProxy.
+   */
+  static const void* GetProxyID(const RenderTargetProxy* proxy);
+
   explicit RenderTask(BlockAllocator* allocator) : allocator(allocator) {
   }
 
@@ -31,7 +50,49 @@ class RenderTask {
 
   virtual void execute(CommandEncoder* encoder) = 0;
 
+  /**
+   * Returns the ID of the proxy written by this task, or nullptr if the task writes no proxy.
+   */
+  virtual const void* outputProxyID() const {
+    return nullptr;
+  }
+
+  /**
+   * Collects the IDs of all proxies read by this task.
+   */
+  virtual void collectInputProxyIDs(std::vector<const void*>*) const {
+  }
+
+  /**
+   * Returns true if the proxy written by this task can't be observed once the current flush is
+   * done, which means it is referenced only by the render tasks writing to it. The taskRefCount is
+   * the number of render tasks in the flush that write to the same proxy.
+   */
+  virtual bool isOutputTransient(long /*taskRefCount*/) const {
+    return false;
+  }
+
+  /**
+   * Returns this task as an OpsRenderTask if it is one, otherwise returns nullptr.
+   */
+  virtual OpsRenderTask* asOpsRenderTask() {
+    return nullptr;
+  }
+
  protected:
   BlockAllocator* allocator = nullptr;
+
+  /**
+   * Returns true if the given proxy is referenced only by the render tasks writing to it, and has
+   * neither a UniqueKey nor an external owner that could read its content later.
+   */
+  static bool IsTransientProxy(const std::shared_ptr<RenderTargetProxy>& proxy,
+                               long taskRefCount);
+
+  /**
+   * Returns true if the given proxy is referenced only by the render tasks writing to it and has no
+   * UniqueKey that could be used to find its content later.
+   */
+  static bool IsTransientProxy(const std::shared_ptr<TextureProxy>& proxy, long taskRefCount);
 };
 }  // namespace tgfx
@@ -37,6 +37,20 @@ class RuntimeDrawTask : public RenderTask {
 
   void execute(CommandEncoder* encoder) override;
 
+  const void* outputProxyID() const override {
+    return GetProxyID(renderTargetProxy.get());
+  }
+
+  void collectInputProxyIDs(std::vector<const void*>* proxyIDs) const override {
+    for (auto& input : inputTextures) {
+      proxyIDs->push_back(GetProxyID(input.textureProxy.get()));
+    }
+  }
+
+  bool isOutputTransient(long taskRefCount) const override {
+    return IsTransientProxy(renderTargetProxy, taskRefCount);
+  }
+
  private:
   std::shared_ptr<RenderTargetProxy> renderTargetProxy = nullptr;
   std::vector<RuntimeInputTexture> inputTextures = {};
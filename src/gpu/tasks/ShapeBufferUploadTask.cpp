@@ -22,6 +22,9 @@
 #include "tgfx/gpu/GPU.h"
 
 namespace tgfx {
+// Triangulating or rasterizing a path takes several times longer than drawing the result.
+static constexpr size_t SHAPE_RASTERIZING_COST_FACTOR = 4;
+
 ShapeBufferUploadTask::ShapeBufferUploadTask(std::shared_ptr<ResourceProxy> trianglesProxy,
                                              std::shared_ptr<ResourceProxy> textureProxy,
                                              std::unique_ptr<DataSource<ShapeBuffer>> source)
@@ -48,6 +51,7 @@ std::shared_ptr<Resource> ShapeBufferUploadTask::onMakeResource(Context* context
     }
     gpu->queue()->writeBuffer(gpuBuffer, 0, triangles->data(), triangles->size());
     vertexBuffer = BufferResource::Wrap(context, std::move(gpuBuffer));
+    vertexBuffer->setRegenerationCost(vertexBuffer->memoryUsage() * SHAPE_RASTERIZING_COST_FACTOR);
   } else {
     auto textureView = TextureView::MakeFrom(context, std::move(shapeBuffer->imageBuffer));
     if (!textureView) {
@@ -55,6 +59,7 @@ std::shared_ptr<Resource> ShapeBufferUploadTask::onMakeResource(Context* context
       return nullptr;
     }
     textureView->assignUniqueKey(textureProxy->uniqueKey);
+    textureView->setRegenerationCost(textureView->memoryUsage() * SHAPE_RASTERIZING_COST_FACTOR);
     textureProxy->resource = std::move(textureView);
   }
   // Free the data source immediately to reduce memory pressure.
@@ -21,6 +21,9 @@
 #include "inspect/InspectorMark.h"
 
 namespace tgfx {
+// Decoding an image takes several times longer than drawing the same number of pixels.
+static constexpr size_t IMAGE_DECODING_COST_FACTOR = 4;
+
 TextureUploadTask::TextureUploadTask(std::shared_ptr<ResourceProxy> proxy,
                                      std::shared_ptr<DataSource<ImageBuffer>> source,
                                      bool mipmapped)
@@ -42,6 +45,7 @@ std::shared_ptr<Resource> TextureUploadTask::onMakeResource(Context* context) {
   if (textureView == nullptr) {
     LOGE("TextureUploadTask::onMakeResource() Failed to upload the texture view!");
   } else {
+    textureView->setRegenerationCost(textureView->memoryUsage() * IMAGE_DECODING_COST_FACTOR);
     // Free the image source immediately to reduce memory pressure.
     source = nullptr;
   }
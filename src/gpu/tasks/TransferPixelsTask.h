@@ -30,6 +30,10 @@ class TransferPixelsTask : public RenderTask {
 
   void execute(CommandEncoder* encoder) override;
 
+  void collectInputProxyIDs(std::vector<const void*>* proxyIDs) const override {
+    proxyIDs->push_back(GetProxyID(source.get()));
+  }
+
  private:
   std::shared_ptr<RenderTargetProxy> source = nullptr;
   Rect srcRect = {};
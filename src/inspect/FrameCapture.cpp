@@ -284,6 +284,7 @@ void FrameCapture::sendRectMeshData(DrawOp* drawOp, RectsVertexProvider* provide
   rectMeshData.hasUVCoord = provider->hasUVCoord();
   rectMeshData.hasColor = provider->hasColor();
   rectMeshData.hasSubset = provider->hasSubset();
+  rectMeshData.hasHalfUV = provider->hasHalfUV();
   auto extraDataSize = sizeof(RectMeshInfo) + sizeof(uint8_t);
   auto data = new (std::nothrow) uint8_t[extraDataSize];
   if (data == nullptr) {
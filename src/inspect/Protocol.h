@@ -98,12 +98,13 @@ enum class OpTaskType : uint8_t {
   Rect3DDrawOp,
   DstTextureCopyOp,
   ResolveOp,
+  StencilPathOp,
   OpTaskTypeSize,
 };
 
 static std::unordered_map<uint8_t, OpTaskType> DrawOpTypeToOpTaskType = {
     {0, OpTaskType::RectDrawOp},  {1, OpTaskType::RRectDrawOp},  {2, OpTaskType::ShapeDrawOp},
-    {3, OpTaskType::AtlasTextOp}, {4, OpTaskType::Rect3DDrawOp},
+    {3, OpTaskType::AtlasTextOp}, {4, OpTaskType::Rect3DDrawOp}, {5, OpTaskType::StencilPathOp},
 };
 
 enum class CustomEnumType : uint8_t {
@@ -143,6 +144,7 @@ struct RectMeshInfo : MeshInfo {
   bool hasUVCoord = false;
   bool hasColor = false;
   bool hasSubset = false;
+  bool hasHalfUV = false;
 };
 
 struct RRectMeshInfo : MeshInfo {
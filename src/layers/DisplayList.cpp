@@ -25,6 +25,7 @@
 #include "layers/DrawArgs.h"
 #include "layers/RootLayer.h"
 #include "layers/TileCache.h"
+#include "tgfx/core/RenderFlags.h"
 #include "tgfx/gpu/GPU.h"
 
 namespace tgfx {
@@ -195,6 +196,7 @@ void DisplayList::setZoomScalePrecision(int precision) {
   _zoomScalePrecision = precision;
   _zoomScaleInt = ChangeZoomScalePrecision(_zoomScaleInt, oldPrecision, precision);
   lastZoomScaleInt = ChangeZoomScalePrecision(lastZoomScaleInt, oldPrecision, precision);
+  renderedZoomScaleInt = ChangeZoomScalePrecision(renderedZoomScaleInt, oldPrecision, precision);
   if (!tileCaches.empty()) {
     std::unordered_map<int64_t, TileCache*> newCaches = {};
     for (auto& item : tileCaches) {
@@ -283,7 +285,8 @@ void DisplayList::showDirtyRegions(bool show) {
 }
 
 bool DisplayList::hasContentChanged() const {
-  if (_hasContentChanged || hasZoomBlurTiles || _root->bitFields.dirtyDescendents) {
+  if (_hasContentChanged || hasZoomBlurTiles || distanceFieldText ||
+      _root->bitFields.dirtyDescendents) {
     return true;
   }
   if (!_showDirtyRegions) {
@@ -303,6 +306,14 @@ void DisplayList::render(Surface* surface, bool autoClear) {
   }
   RENDER_VISABLE_OBJECT(surface->getContext());
   _hasContentChanged = false;
+  checkMemoryPressure(surface);
+  // Text is drawn as distance fields only while the zoomScale keeps changing between frames, so the
+  // glyphs are not rasterized again for every new zoomScale. The frame rendered after zooming stops
+  // redraws everything with sharp masks.
+  auto lastDistanceFieldText = distanceFieldText;
+  distanceFieldText = _allowDistanceFieldText && _renderMode != RenderMode::Tiled &&
+                      _zoomScaleInt != renderedZoomScaleInt;
+  renderedZoomScaleInt = _zoomScaleInt;
   auto dirtyRegions = _root->updateDirtyRegions();
   if (_zoomScaleInt == 0) {
     if (autoClear) {
@@ -316,7 +327,8 @@ void DisplayList::render(Surface* surface, bool autoClear) {
       dirtyRegions = renderDirect(surface, autoClear);
       break;
     case RenderMode::Partial:
-      dirtyRegions = renderPartial(surface, autoClear, dirtyRegions);
+      dirtyRegions = renderPartial(surface, autoClear, dirtyRegions,
+                                   lastDistanceFieldText && !distanceFieldText);
       break;
     case RenderMode::Tiled:
       dirtyRegions = renderTiled(surface, autoClear, dirtyRegions);
@@ -330,7 +342,13 @@ void DisplayList::render(Surface* surface, bool autoClear) {
 
 std::vector<Rect> DisplayList::renderDirect(Surface* surface, bool autoClear) const {
   auto surfaceRect = Rect::MakeWH(surface->width(), surface->height());
+  // Every change of the render flags flushes the surface, so they are set once per frame.
+  auto renderFlags = surface->renderFlags();
+  if (distanceFieldText) {
+    surface->setRenderFlags(renderFlags | RenderFlags::DistanceFieldText);
+  }
   drawRootLayer(surface, surfaceRect, getViewMatrix(), autoClear);
+  surface->setRenderFlags(renderFlags);
   return {Rect::MakeEmpty()};
 }
 
@@ -358,7 +376,8 @@ static std::vector<Rect> MapDirtyRegions(const std::vector<Rect>& dirtyRegions,
   return dirtyRects;
 }
 std::vector<Rect> DisplayList::renderPartial(Surface* surface, bool autoClear,
-                                             const std::vector<Rect>& dirtyRegions) {
+                                             const std::vector<Rect>& dirtyRegions,
+                                             bool redrawAll) {
   auto context = surface->getContext();
   bool cacheChanged = false;
   auto partialCache = surfaceCaches.empty() ? nullptr : surfaceCaches.front();
@@ -378,13 +397,21 @@ std::vector<Rect> DisplayList::renderPartial(Surface* surface, bool autoClear,
   auto viewMatrix = getViewMatrix();
   auto surfaceRect = Rect::MakeWH(surface->width(), surface->height());
   std::vector<Rect> drawRects = {};
-  if (cacheChanged || lastZoomScaleInt != _zoomScaleInt || lastContentOffset != _contentOffset) {
+  if (cacheChanged || redrawAll || lastZoomScaleInt != _zoomScaleInt ||
+      lastContentOffset != _contentOffset) {
     drawRects = {surfaceRect};
     lastZoomScaleInt = _zoomScaleInt;
     lastContentOffset = _contentOffset;
   } else {
     drawRects = MapDirtyRegions(dirtyRegions, viewMatrix, true, &surfaceRect);
   }
+  // The partial cache belongs to the display list, so its render flags are only changed when the
+  // text switches between distance fields and masks.
+  auto renderFlags = surface->renderFlags();
+  if (distanceFieldText) {
+    renderFlags |= RenderFlags::DistanceFieldText;
+  }
+  partialCache->setRenderFlags(renderFlags);
   auto canvas = surface->getCanvas();
   for (auto& drawRect : drawRects) {
     drawRootLayer(partialCache.get(), drawRect, viewMatrix, true);
@@ -958,6 +985,60 @@ void DisplayList::resetCaches() {
   emptyTiles.clear();
 }
 
+void DisplayList::checkMemoryPressure(const Surface* surface) {
+  auto context = surface->getContext();
+  auto moderateCount = context->memoryPressureCount(MemoryPressure::Moderate);
+  auto criticalCount = context->memoryPressureCount(MemoryPressure::Critical);
+  if (memoryPressureContextID == context->uniqueID()) {
+    if (criticalCount != criticalPressureCount) {
+      resetCaches();
+    } else if (moderateCount != moderatePressureCount) {
+      releaseTilesOutOfView(surface);
+    }
+  }
+  memoryPressureContextID = context->uniqueID();
+  moderatePressureCount = moderateCount;
+  criticalPressureCount = criticalCount;
+}
+
+void DisplayList::releaseTilesOutOfView(const Surface* surface) {
+  if (_renderMode != RenderMode::Tiled) {
+    return;
+  }
+  auto renderRect = Rect::MakeWH(surface->width(), surface->height());
+  renderRect.offset(-_contentOffset.x, -_contentOffset.y);
+  for (auto item = tileCaches.begin(); item != tileCaches.end();) {
+    auto tileCache = item->second;
+    // The tile caches of other zoom scales only serve as fallbacks while zooming, drop them all.
+    auto viewRect = item->first == _zoomScaleInt ? renderRect : Rect::MakeEmpty();
+    auto tiles = tileCache->removeTilesOutsideRect(viewRect);
+    emptyTiles.insert(emptyTiles.end(), tiles.begin(), tiles.end());
+    if (tileCache->empty()) {
+      delete tileCache;
+      item = tileCaches.erase(item);
+    } else {
+      ++item;
+    }
+  }
+  // Releases the trailing surfaces whose tiles are all empty. The surfaces are created again once
+  // more tiles are needed.
+  while (!surfaceCaches.empty()) {
+    auto sourceIndex = surfaceCaches.size() - 1;
+    auto& surfaceCache = surfaceCaches.back();
+    auto tileCount = (surfaceCache->width() / _tileSize) * (surfaceCache->height() / _tileSize);
+    auto onSurface = [sourceIndex](const std::shared_ptr<Tile>& tile) {
+      return tile->sourceIndex == sourceIndex;
+    };
+    auto emptyCount = std::count_if(emptyTiles.begin(), emptyTiles.end(), onSurface);
+    if (emptyCount != static_cast<std::ptrdiff_t>(tileCount)) {
+      break;
+    }
+    emptyTiles.erase(std::remove_if(emptyTiles.begin(), emptyTiles.end(), onSurface),
+                     emptyTiles.end());
+    surfaceCaches.pop_back();
+  }
+}
+
 void DisplayList::drawRootLayer(Surface* surface, const Rect& drawRect, const Matrix& viewMatrix,
                                 bool autoClear) const {
   DEBUG_ASSERT(surface != nullptr);
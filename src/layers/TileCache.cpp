@@ -117,4 +117,17 @@ std::vector<std::shared_ptr<Tile>> TileCache::getReusableTiles(float centerX, fl
             });
   return tiles;
 }
+
+std::vector<std::shared_ptr<Tile>> TileCache::removeTilesOutsideRect(const Rect& rect) {
+  std::vector<std::shared_ptr<Tile>> tiles = {};
+  for (auto item = tileMap.begin(); item != tileMap.end();) {
+    if (!Rect::Intersects(rect, item->second->getTileRect(tileSize))) {
+      tiles.push_back(std::move(item->second));
+      item = tileMap.erase(item);
+    } else {
+      ++item;
+    }
+  }
+  return tiles;
+}
 }  // namespace tgfx
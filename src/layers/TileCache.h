@@ -117,6 +117,13 @@ class TileCache {
    */
   std::vector<std::shared_ptr<Tile>> getReusableTiles(float centerX, float centerY);
 
+  /**
+   * Removes all tiles that don't intersect the specified rectangle from the cache and returns them.
+   * The rectangle is in the tile cache's coordinate space, without any content offset. Passing an
+   * empty rectangle removes all tiles.
+   */
+  std::vector<std::shared_ptr<Tile>> removeTilesOutsideRect(const Rect& rect);
+
  private:
   int tileSize = 256;
   std::unordered_map<int64_t, std::shared_ptr<Tile>> tileMap = {};
@@ -16,6 +16,8 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "core/Atlas.h"
+#include "core/AtlasManager.h"
 #include "core/PathRef.h"
 #include "core/PictureRecords.h"
 #include "core/images/CodecImage.h"
@@ -29,6 +31,7 @@
 #include "gpu/RenderContext.h"
 #include "gpu/opengl/GLFunctions.h"
 #include "gpu/opengl/GLGPU.h"
+#include "gpu/ops/AtlasTextOp.h"
 #include "gpu/ops/RRectDrawOp.h"
 #include "gpu/ops/RectDrawOp.h"
 #include "gpu/resources/TextureView.h"
@@ -45,6 +48,7 @@
 #include "tgfx/core/PictureRecorder.h"
 #include "tgfx/core/RRect.h"
 #include "tgfx/core/Rect.h"
+#include "tgfx/core/RenderFlags.h"
 #include "tgfx/core/Shader.h"
 #include "tgfx/core/Shape.h"
 #include "tgfx/core/Stroke.h"
@@ -236,6 +240,74 @@ TGFX_TEST(CanvasTest, merge_draw_call_rrect) {
   EXPECT_TRUE(Baseline::Compare(surface, "CanvasTest/merge_draw_call_rrect"));
 }
 
+TGFX_TEST(CanvasTest, merge_draw_call_path) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  int width = 72;
+  int height = 72;
+  auto surface = Surface::Make(context, width, height);
+  auto canvas = surface->getCanvas();
+  canvas->clear(Color::White());
+  Paint paint;
+  paint.setColor(Color::Red());
+  Path path;
+  path.moveTo(0, 0);
+  path.lineTo(8, 0);
+  path.lineTo(8, 8);
+  path.lineTo(4, 4);
+  path.lineTo(0, 8);
+  path.close();
+  int tileSize = 12;
+  size_t drawCallCount = 0;
+  for (int y = 0; y < height; y += tileSize) {
+    for (int x = 0; x < width; x += tileSize) {
+      canvas->save();
+      canvas->translate(static_cast<float>(x), static_cast<float>(y));
+      canvas->drawPath(path, paint);
+      canvas->restore();
+      drawCallCount++;
+    }
+  }
+  surface->renderContext->flush();
+  auto drawingBuffer = context->drawingManager()->getDrawingBuffer();
+  EXPECT_EQ(drawingBuffer->atlasTasks.size(), 1u);
+  EXPECT_TRUE(drawingBuffer->renderTasks.size() == 1);
+  auto task = static_cast<OpsRenderTask*>(drawingBuffer->renderTasks.front().get());
+  ASSERT_TRUE(task->drawOps.size() == 1);
+  ASSERT_TRUE(task->drawOps.back()->type() == DrawOp::Type::AtlasTextOp);
+  EXPECT_EQ(static_cast<AtlasTextOp*>(task->drawOps.back().get())->rectCount, drawCallCount);
+  context->flushAndSubmit();
+  auto info = ImageInfo::Make(1, 1, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  uint32_t pixel = 0;
+  ASSERT_TRUE(surface->readPixels(info, &pixel, tileSize + 6, tileSize + 2));
+  EXPECT_EQ(pixel, 0xFF0000FF);
+  ASSERT_TRUE(surface->readPixels(info, &pixel, tileSize + 4, tileSize + 7));
+  EXPECT_EQ(pixel, 0xFFFFFFFF);
+
+  // The paths drawn again with the same scale hit the cells already in the atlas.
+  canvas->drawPath(path, paint);
+  surface->renderContext->flush();
+  drawingBuffer = context->drawingManager()->getDrawingBuffer();
+  EXPECT_TRUE(drawingBuffer->atlasTasks.empty());
+  context->flushAndSubmit();
+
+  // Convex paths are drawn as a triangle fan instead of being rasterized into the atlas.
+  Path triangle;
+  triangle.moveTo(0, 0);
+  triangle.lineTo(9, 1);
+  triangle.lineTo(3, 8);
+  triangle.close();
+  canvas->drawPath(triangle, paint);
+  surface->renderContext->flush();
+  drawingBuffer = context->drawingManager()->getDrawingBuffer();
+  EXPECT_TRUE(drawingBuffer->atlasTasks.empty());
+  ASSERT_TRUE(drawingBuffer->renderTasks.size() == 1);
+  task = static_cast<OpsRenderTask*>(drawingBuffer->renderTasks.front().get());
+  ASSERT_TRUE(task->drawOps.size() == 1);
+  EXPECT_TRUE(task->drawOps.back()->type() == DrawOp::Type::ShapeDrawOp);
+}
+
 TGFX_TEST(CanvasTest, textShape) {
   auto serifTypeface =
       Typeface::MakeFromPath(ProjectPath::Absolute("resources/font/NotoSerifSC-Regular.otf"));
@@ -3439,4 +3511,53 @@ TGFX_TEST(CanvasTest, TextBlobHitTestPoint) {
   EXPECT_FALSE(textBlob->hitTestPoint(farOutsideX_emoji, outsideY_emoji, &stroke));
 }
 
+TGFX_TEST(CanvasTest, DistanceFieldText) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto typeface =
+      Typeface::MakeFromPath(ProjectPath::Absolute("resources/font/NotoSansSC-Regular.otf"));
+  ASSERT_TRUE(typeface != nullptr);
+  auto surface = Surface::Make(context, 400, 400, false, 1, false, RenderFlags::DistanceFieldText);
+  ASSERT_TRUE(surface != nullptr);
+  EXPECT_EQ(surface->renderFlags(), RenderFlags::DistanceFieldText);
+  auto canvas = surface->getCanvas();
+  canvas->clear(Color::White());
+  Font font(typeface, 20.f);
+  Paint paint = {};
+  paint.setColor(Color::Black());
+  canvas->drawSimpleText("TGFX", 10, 30, font, paint);
+  context->flushAndSubmit();
+  auto atlasManager = context->atlasManager();
+  auto& fieldAtlas = atlasManager->atlases[static_cast<int>(MaskFormat::SDF)];
+  ASSERT_TRUE(fieldAtlas != nullptr);
+  EXPECT_TRUE(atlasManager->atlases[static_cast<int>(MaskFormat::A8)] == nullptr);
+  auto cellCount = fieldAtlas->cellLocators.size();
+  EXPECT_EQ(cellCount, 4u);
+
+  // Drawing the same glyphs at other scales and rotations reuses the fields in the atlas.
+  canvas->scale(5.f, 5.f);
+  canvas->rotate(15.f);
+  canvas->drawSimpleText("TGFX", 10, 30, font, paint);
+  context->flushAndSubmit();
+  EXPECT_EQ(fieldAtlas->cellLocators.size(), cellCount);
+  EXPECT_TRUE(atlasManager->atlases[static_cast<int>(MaskFormat::A8)] == nullptr);
+
+  Bitmap bitmap(surface->width(), surface->height(), false, false);
+  ASSERT_FALSE(bitmap.isEmpty());
+  Pixmap pixmap(bitmap);
+  ASSERT_TRUE(surface->readPixels(pixmap.info(), pixmap.writablePixels()));
+  auto pixels = static_cast<const uint8_t*>(pixmap.pixels());
+  int darkCount = 0;
+  for (int y = 0; y < pixmap.height(); y++) {
+    auto row = pixels + static_cast<size_t>(y) * pixmap.rowBytes();
+    for (int x = 0; x < pixmap.width(); x++) {
+      if (row[x * 4] < 128) {
+        darkCount++;
+      }
+    }
+  }
+  EXPECT_GT(darkCount, 0);
+}
+
 }  // namespace tgfx
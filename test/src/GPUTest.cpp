@@ -16,9 +16,35 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <array>
+#include <filesystem>
 #include <memory>
 #include <vector>
+#include "core/AtlasManager.h"
+#include "core/ImageSource.h"
+#include "core/PathTriangulator.h"
+#include "core/utils/ETC2Encoder.h"
+#include "core/utils/MathExtra.h"
+#include "core/utils/TaskGroup.h"
+#include "gpu/DrawingManager.h"
+#include "gpu/GlobalCache.h"
+#include "gpu/PipelineRecipe.h"
+#include "gpu/Quad.h"
+#include "gpu/RectsVertexProvider.h"
+#include "gpu/RectsVertexSIMD.h"
+#include "gpu/RenderContext.h"
+#include "gpu/RenderTaskGraph.h"
+#include "gpu/StreamingBufferAllocator.h"
+#include "gpu/UniformData.h"
+#include "gpu/VertexShaderBuilder.h"
+#include "gpu/processors/ConstColorProcessor.h"
+#include "gpu/processors/TextureEffect.h"
+#include "gpu/opengl/GLBuffer.h"
+#include "gpu/ops/StencilPathOp.h"
+#include "gpu/proxies/AtlasRenderTargetProxy.h"
+#include "tgfx/core/Surface.h"
 #include "tgfx/gpu/GPU.h"
+#include "tgfx/gpu/ProgramBinaryStore.h"
 #include "tgfx/gpu/RenderPass.h"
 #include "utils/TestUtils.h"
 
@@ -46,4 +72,701 @@ TGFX_TEST(GPUTest, DepthRenderPassTest) {
   auto renderPass = commandEncoder->beginRenderPass(renderPassDescriptor);
   ASSERT_TRUE(renderPass != nullptr);
 }
+
+TGFX_TEST(GPUTest, RenderTaskGraph) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 8, 8);
+  ASSERT_TRUE(surface != nullptr);
+  auto mainTarget = surface->renderContext->renderTarget;
+  auto offscreenTarget = RenderTargetProxy::Make(context, 8, 8, false);
+  ASSERT_TRUE(offscreenTarget != nullptr);
+  auto unusedTarget = RenderTargetProxy::Make(context, 8, 8, false);
+  ASSERT_TRUE(unusedTarget != nullptr);
+  auto drawingManager = context->drawingManager();
+  auto allocator = drawingManager->drawingAllocator();
+  drawingManager->addOpsRenderTask(mainTarget, {}, PMColor{1.0f, 0.0f, 0.0f, 1.0f});
+  drawingManager->addOpsRenderTask(offscreenTarget, {}, PMColor{0.0f, 1.0f, 0.0f, 1.0f});
+  drawingManager->addOpsRenderTask(std::move(unusedTarget), {}, PMColor{0.0f, 0.0f, 1.0f, 1.0f});
+  auto provider = RectsVertexProvider::MakeFrom(allocator, Rect::MakeWH(8, 8), AAType::None);
+  auto drawOp = RectDrawOp::Make(context, std::move(provider), 0);
+  drawOp->addColorFP(TextureEffect::Make(allocator, offscreenTarget->asTextureProxy()));
+  auto drawOps = allocator->makeArray<DrawOp>(&drawOp, 1);
+  drawingManager->addOpsRenderTask(mainTarget, std::move(drawOps), std::nullopt);
+  offscreenTarget = nullptr;
+
+  auto& renderTasks = drawingManager->getDrawingBuffer()->renderTasks;
+  ASSERT_EQ(renderTasks.size(), 4u);
+  RenderTaskGraph::Optimize(&renderTasks);
+  ASSERT_EQ(renderTasks.size(), 2u);
+  auto offscreenTask = renderTasks[0]->asOpsRenderTask();
+  ASSERT_TRUE(offscreenTask != nullptr);
+  EXPECT_NE(offscreenTask->renderTarget(), mainTarget.get());
+  auto mainTask = renderTasks[1]->asOpsRenderTask();
+  ASSERT_TRUE(mainTask != nullptr);
+  EXPECT_EQ(mainTask->renderTarget(), mainTarget.get());
+  EXPECT_TRUE(mainTask->hasClearColor());
+  EXPECT_EQ(mainTask->drawOps.size(), 1u);
+
+  context->flushAndSubmit();
+  uint32_t pixel = 0;
+  auto info = ImageInfo::Make(1, 1, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  ASSERT_TRUE(surface->readPixels(info, &pixel, 4, 4));
+  EXPECT_EQ(pixel, 0xFF00FF00);
+}
+
+TGFX_TEST(GPUTest, RenderTargetAtlas) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 12, 8);
+  ASSERT_TRUE(surface != nullptr);
+  auto mainTarget = surface->renderContext->renderTarget;
+  auto drawingManager = context->drawingManager();
+  auto allocator = drawingManager->drawingAllocator();
+  std::vector<std::shared_ptr<RenderTargetProxy>> offscreenTargets = {};
+  std::vector<PMColor> colors = {PMColor{1.0f, 0.0f, 0.0f, 1.0f}, PMColor{0.0f, 0.0f, 1.0f, 1.0f},
+                                 PMColor{0.0f, 1.0f, 0.0f, 1.0f}};
+  for (auto& color : colors) {
+    auto renderTarget = RenderTargetProxy::Make(context, 8, 8, false, 1, false,
+                                                ImageOrigin::TopLeft, BackingFit::Approx);
+    ASSERT_TRUE(renderTarget != nullptr);
+    ASSERT_TRUE(renderTarget->asAtlasRenderTargetProxy() != nullptr);
+    auto provider = RectsVertexProvider::MakeFrom(allocator, Rect::MakeWH(8, 8), AAType::None);
+    auto drawOp = RectDrawOp::Make(context, std::move(provider), 0);
+    drawOp->addColorFP(ConstColorProcessor::Make(allocator, color, InputMode::Ignore));
+    auto drawOps = allocator->makeArray<DrawOp>(&drawOp, 1);
+    drawingManager->addOpsRenderTask(renderTarget, std::move(drawOps), PMColor::Transparent());
+    offscreenTargets.push_back(std::move(renderTarget));
+  }
+  drawingManager->addOpsRenderTask(mainTarget, {}, PMColor::Transparent());
+  std::vector<PlacementPtr<DrawOp>> mainOps = {};
+  for (size_t i = 0; i < offscreenTargets.size(); i++) {
+    auto rect = Rect::MakeXYWH(static_cast<float>(i) * 4.0f, 0.0f, 4.0f, 8.0f);
+    auto provider = RectsVertexProvider::MakeFrom(allocator, rect, AAType::None);
+    auto drawOp = RectDrawOp::Make(context, std::move(provider), 0);
+    drawOp->addColorFP(TextureEffect::Make(allocator, offscreenTargets[i]->asTextureProxy()));
+    mainOps.push_back(std::move(drawOp));
+  }
+  auto drawOps = allocator->makeArray<DrawOp>(std::move(mainOps));
+  drawingManager->addOpsRenderTask(mainTarget, std::move(drawOps), std::nullopt);
+  auto firstProxy = offscreenTargets[0]->asAtlasRenderTargetProxy();
+  auto secondProxy = offscreenTargets[1]->asAtlasRenderTargetProxy();
+  // The last target is still referenced outside the tasks, so it must keep its own texture.
+  auto escapedTarget = offscreenTargets[2];
+  offscreenTargets.clear();
+
+  auto& renderTasks = drawingManager->getDrawingBuffer()->renderTasks;
+  ASSERT_EQ(renderTasks.size(), 5u);
+  RenderTaskGraph::Optimize(&renderTasks);
+  ASSERT_EQ(renderTasks.size(), 3u);
+  auto atlasTask = renderTasks[0]->asOpsRenderTask();
+  ASSERT_TRUE(atlasTask != nullptr);
+  EXPECT_EQ(atlasTask->atlasTasks.size(), 1u);
+  EXPECT_TRUE(firstProxy->isPacked());
+  EXPECT_TRUE(secondProxy->isPacked());
+  EXPECT_FALSE(escapedTarget->asAtlasRenderTargetProxy()->isPacked());
+  EXPECT_NE(firstProxy->backingStoreOffset(), secondProxy->backingStoreOffset());
+  EXPECT_EQ(firstProxy->getTextureView(), secondProxy->getTextureView());
+  auto mainTask = renderTasks[2]->asOpsRenderTask();
+  ASSERT_TRUE(mainTask != nullptr);
+  EXPECT_EQ(mainTask->renderTarget(), mainTarget.get());
+
+  context->flushAndSubmit();
+  uint32_t pixels[12] = {};
+  auto info = ImageInfo::Make(12, 1, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  ASSERT_TRUE(surface->readPixels(info, pixels, 0, 4));
+  EXPECT_EQ(pixels[0], 0xFF0000FF);
+  EXPECT_EQ(pixels[3], 0xFF0000FF);
+  EXPECT_EQ(pixels[4], 0xFFFF0000);
+  EXPECT_EQ(pixels[7], 0xFFFF0000);
+  EXPECT_EQ(pixels[8], 0xFF00FF00);
+  EXPECT_EQ(pixels[11], 0xFF00FF00);
+}
+
+TGFX_TEST(GPUTest, UniformDataLookup) {
+  std::vector<Uniform> uniforms = {{RTAdjustName, UniformFormat::Float4},
+                                   {"Color_P0", UniformFormat::Float4},
+                                   {"Color_P1", UniformFormat::Float4}};
+  UniformData uniformData(uniforms, {RTAdjustName, "Color", "Color"}, {-1, 0, 1});
+  ASSERT_EQ(uniformData.size(), 48u);
+  float buffer[12] = {};
+  uniformData.setBuffer(buffer);
+  uniformData.setData(RTAdjustName, std::array<float, 4>{1.0f, 2.0f, 3.0f, 4.0f});
+  EXPECT_EQ(buffer[0], 1.0f);
+  uniformData.processorIndex = 1;
+  uniformData.setData("Color", std::array<float, 4>{5.0f, 6.0f, 7.0f, 8.0f});
+  EXPECT_EQ(buffer[4], 0.0f);
+  EXPECT_EQ(buffer[8], 5.0f);
+  uniformData.processorIndex = 0;
+  uniformData.setData("Color", std::array<float, 4>{9.0f, 10.0f, 11.0f, 12.0f});
+  EXPECT_EQ(buffer[4], 9.0f);
+  EXPECT_EQ(buffer[8], 5.0f);
+}
+
+TGFX_TEST(GPUTest, LastProgramCache) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto globalCache = context->globalCache();
+  BytesKey firstKey = {};
+  firstKey.write(1u);
+  BytesKey secondKey = {};
+  secondKey.write(2u);
+  auto firstProgram = std::make_shared<Program>(nullptr, nullptr, nullptr);
+  auto secondProgram = std::make_shared<Program>(nullptr, nullptr, nullptr);
+  globalCache->addProgram(firstKey, firstProgram);
+  globalCache->addProgram(secondKey, secondProgram);
+  EXPECT_EQ(globalCache->lastProgram, secondProgram);
+  EXPECT_EQ(globalCache->findProgram(firstKey), firstProgram);
+  EXPECT_EQ(globalCache->lastProgram, firstProgram);
+  EXPECT_EQ(globalCache->programLRU.front(), firstProgram.get());
+  EXPECT_EQ(globalCache->findProgram(firstKey), firstProgram);
+  EXPECT_EQ(globalCache->findProgram(secondKey), secondProgram);
+  BytesKey missingKey = {};
+  missingKey.write(3u);
+  EXPECT_EQ(globalCache->findProgram(missingKey), nullptr);
+
+  auto keyBuffer = globalCache->getProgramKeyBuffer();
+  keyBuffer->write(1u);
+  EXPECT_EQ(keyBuffer->hash(), firstKey.hash());
+  EXPECT_EQ(globalCache->findProgram(*keyBuffer), firstProgram);
+  auto capacity = keyBuffer->values.capacity();
+  keyBuffer = globalCache->getProgramKeyBuffer();
+  EXPECT_EQ(keyBuffer->size(), 0u);
+  EXPECT_EQ(keyBuffer->values.capacity(), capacity);
+  keyBuffer->write(2u);
+  EXPECT_NE(keyBuffer->hash(), firstKey.hash());
+  EXPECT_EQ(globalCache->findProgram(*keyBuffer), secondProgram);
+}
+
+TGFX_TEST(GPUTest, ProgramBinaryStore) {
+  auto directory = ProjectPath::Absolute("test/out/ProgramBinaryStore");
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  auto firstKey = Data::MakeWithCopy("first", 5);
+  auto secondKey = Data::MakeWithCopy("second", 6);
+  auto binary = Data::MakeWithCopy("binary", 6);
+  auto store = ProgramBinaryStore::MakeFrom(directory, 24);
+  ASSERT_TRUE(store != nullptr);
+  EXPECT_EQ(store->load(*firstKey), nullptr);
+  store->save(*firstKey, binary);
+  auto result = store->load(*firstKey);
+  ASSERT_TRUE(result != nullptr);
+  EXPECT_TRUE(result->size() == binary->size() &&
+              memcmp(result->data(), binary->data(), binary->size()) == 0);
+  EXPECT_EQ(store->load(*secondKey), nullptr);
+  // The binaries are still there after the store is recreated. The index is written in the
+  // background, so the store must be released before another one opens the same directory.
+  store = nullptr;
+  store = ProgramBinaryStore::MakeFrom(directory, 24);
+  EXPECT_TRUE(store->load(*firstKey) != nullptr);
+  // Both files exceed 24 bytes together, so the least recently used one is removed.
+  store->save(*secondKey, binary);
+  EXPECT_TRUE(store->load(*secondKey) != nullptr);
+  EXPECT_EQ(store->load(*firstKey), nullptr);
+  store = nullptr;
+  std::filesystem::remove_all(directory);
+}
+
+TGFX_TEST(GPUTest, ProgramBinaryStoreWithoutThreads) {
+  auto directory = ProjectPath::Absolute("test/out/ProgramBinaryStoreWithoutThreads");
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+  // Without worker threads, Task::Run() writes the index on the calling thread.
+  Task::ReleaseThreads();
+  auto taskGroup = TaskGroup::GetInstance();
+  taskGroup->exited = true;
+  auto key = Data::MakeWithCopy("key", 3);
+  auto binary = Data::MakeWithCopy("binary", 6);
+  auto store = ProgramBinaryStore::MakeFrom(directory, 1024);
+  ASSERT_TRUE(store != nullptr);
+  store->save(*key, binary);
+  store->save(*key, binary);
+  EXPECT_TRUE(std::filesystem::exists(directory + "/index"));
+  EXPECT_TRUE(store->load(*key) != nullptr);
+  store = nullptr;
+  taskGroup->exited = false;
+  store = ProgramBinaryStore::MakeFrom(directory, 1024);
+  EXPECT_TRUE(store->load(*key) != nullptr);
+  store = nullptr;
+  std::filesystem::remove_all(directory);
+}
+
+TGFX_TEST(GPUTest, PrecompilePrograms) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 8, 8);
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  canvas->drawRect(Rect::MakeWH(4, 4), paint);
+  context->flushAndSubmit();
+  auto globalCache = context->globalCache();
+  ASSERT_FALSE(globalCache->programLRU.empty());
+  auto recipe = globalCache->programLRU.front()->getRecipe();
+  PipelineRecipe decodedRecipe = {};
+  ASSERT_TRUE(PipelineRecipe::Decode(reinterpret_cast<const uint8_t*>(recipe.data()),
+                                     recipe.size(), &decodedRecipe));
+  EXPECT_EQ(decodedRecipe.encode(), recipe);
+  EXPECT_FALSE(PipelineRecipe::Decode(reinterpret_cast<const uint8_t*>(recipe.data()),
+                                      recipe.size() - 1, &decodedRecipe));
+  auto programKeys = context->exportProgramKeys();
+  ASSERT_TRUE(programKeys != nullptr);
+  auto programCount = globalCache->programLRU.size();
+  // Programs that are already cached are skipped.
+  EXPECT_TRUE(context->precompilePrograms(programKeys));
+  EXPECT_TRUE(globalCache->precompiledPipelines.empty());
+  globalCache->programMap.clear();
+  globalCache->programLRU.clear();
+  globalCache->programRecipes.clear();
+  globalCache->lastProgram = nullptr;
+  // A zero budget still makes progress on every call.
+  size_t callCount = 1;
+  while (!context->precompilePrograms(programKeys, std::chrono::steady_clock::duration::zero())) {
+    callCount++;
+  }
+  EXPECT_EQ(callCount, programCount);
+  EXPECT_EQ(globalCache->precompiledPipelines.size(), programCount);
+  canvas->drawRect(Rect::MakeWH(4, 4), paint);
+  context->flushAndSubmit();
+  EXPECT_LT(globalCache->precompiledPipelines.size(), programCount);
+  EXPECT_EQ(globalCache->programRecipes.count(recipe), 1u);
+  // The precompiled pipelines that no program takes are released once they expire.
+  for (auto& item : globalCache->precompiledPipelines) {
+    item.second.expirationTime = std::chrono::steady_clock::now();
+  }
+  globalCache->purgeExpiredPipelines();
+  EXPECT_TRUE(globalCache->precompiledPipelines.empty());
+}
+
+TGFX_TEST(GPUTest, StreamingBufferAllocator) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  StreamingBufferAllocator allocator(context, GPUBufferUsage::VERTEX, 256, 16);
+  size_t offset = 0;
+  auto firstBuffer = allocator.allocate(100, &offset);
+  ASSERT_TRUE(firstBuffer != nullptr);
+  EXPECT_EQ(offset, 0u);
+  EXPECT_EQ(allocator.allocate(100, &offset), firstBuffer);
+  EXPECT_EQ(offset, 112u);
+  auto secondBuffer = allocator.allocate(100, &offset);
+  EXPECT_NE(secondBuffer, firstBuffer);
+  EXPECT_EQ(offset, 0u);
+  auto largeBuffer = allocator.allocate(1000, &offset);
+  ASSERT_TRUE(largeBuffer != nullptr);
+  EXPECT_GE(largeBuffer->size(), 1000u);
+  EXPECT_EQ(allocator.memoryUsage(), 512u + largeBuffer->size());
+  // The buffers of a flush are only reused after the other frames have been used in turn.
+  for (size_t i = 0; i < StreamingBufferAllocator::FRAME_COUNT - 1; i++) {
+    allocator.advanceFrame();
+    EXPECT_NE(allocator.allocate(100, &offset), firstBuffer);
+  }
+  // The retired buffers are fenced, and reused once the GPU has finished reading them.
+  EXPECT_TRUE(std::static_pointer_cast<GLBuffer>(firstBuffer)->fence != nullptr);
+  context->gpu()->queue()->waitUntilCompleted();
+  EXPECT_TRUE(firstBuffer->isReady());
+  allocator.advanceFrame();
+  EXPECT_EQ(allocator.allocate(100, &offset), firstBuffer);
+  EXPECT_EQ(offset, 0u);
+}
+
+static Point UnpackHalf2(float value) {
+  uint16_t halves[2] = {};
+  memcpy(halves, &value, sizeof(float));
+  return Point::Make(HalfToFloat(halves[0]), HalfToFloat(halves[1]));
+}
+
+TGFX_TEST(GPUTest, HalfUVRectVertices) {
+  EXPECT_EQ(HalfToFloat(FloatToHalf(63.5f)), 63.5f);
+  EXPECT_EQ(HalfToFloat(FloatToHalf(-2048.0f)), -2048.0f);
+  EXPECT_EQ(HalfToFloat(FloatToHalf(6e-8f)), HalfToFloat(1));
+  EXPECT_NE(HalfToFloat(FloatToHalf(0.1f)), 0.1f);
+  EXPECT_EQ(FloatToHalf(65520.0f), 0x7C00);
+
+  BlockAllocator allocator = {};
+  std::vector<PlacementPtr<RectRecord>> rects = {};
+  rects.push_back(allocator.make<RectRecord>(Rect::MakeXYWH(10, 10, 20, 20), Matrix::I()));
+  std::vector<PlacementPtr<Rect>> uvRects = {};
+  uvRects.push_back(allocator.make<Rect>(Rect::MakeWH(64, 32)));
+  auto provider =
+      RectsVertexProvider::MakeFrom(&allocator, std::move(rects), std::move(uvRects),
+                                    AAType::Coverage, true, UVSubsetMode::SubsetOnly, {});
+  ASSERT_TRUE(provider != nullptr);
+  auto floatCount = provider->vertexCount();
+  ASSERT_TRUE(provider->enableHalfUV());
+  // Each of the 8 vertices shrinks from 9 floats to 6.
+  EXPECT_EQ(provider->vertexCount(), floatCount - 24);
+  std::vector<float> vertices(provider->vertexCount());
+  provider->getVertices(vertices.data());
+  EXPECT_EQ(UnpackHalf2(vertices[3]), Point::Make(0.5f, 0.5f));
+  EXPECT_EQ(UnpackHalf2(vertices[4]), Point::Make(0.5f, 0.5f));
+  EXPECT_EQ(UnpackHalf2(vertices[5]), Point::Make(63.5f, 31.5f));
+  EXPECT_EQ(UnpackHalf2(vertices[21]), Point::Make(63.5f, 31.5f));
+
+  std::vector<PlacementPtr<RectRecord>> inexactRects = {};
+  inexactRects.push_back(allocator.make<RectRecord>(Rect::MakeWH(10, 10), Matrix::I()));
+  std::vector<PlacementPtr<Rect>> inexactUVRects = {};
+  inexactUVRects.push_back(allocator.make<Rect>(Rect::MakeXYWH(0.1f, 0.0f, 10.0f, 10.0f)));
+  provider = RectsVertexProvider::MakeFrom(&allocator, std::move(inexactRects),
+                                           std::move(inexactUVRects), AAType::None, true,
+                                           UVSubsetMode::None, {});
+  ASSERT_TRUE(provider != nullptr);
+  floatCount = provider->vertexCount();
+  EXPECT_FALSE(provider->enableHalfUV());
+  EXPECT_FALSE(provider->hasHalfUV());
+  EXPECT_EQ(provider->vertexCount(), floatCount);
+}
+
+TGFX_TEST(GPUTest, RectsVertexBatch) {
+  RectBatch batch = {};
+  std::vector<Rect> rects = {};
+  std::vector<Matrix> matrices = {};
+  for (size_t i = 0; i < RECT_BATCH_SIZE - 1; i++) {
+    auto offset = static_cast<float>(i) * 10.0f;
+    auto rect = Rect::MakeXYWH(offset, offset * 0.5f, 30.0f + offset, 20.0f);
+    auto matrix = Matrix::MakeRotate(offset, 5.0f, 5.0f);
+    matrix.postScale(1.5f, 0.75f);
+    batch.left[i] = batch.uvLeft[i] = rect.left;
+    batch.top[i] = batch.uvTop[i] = rect.top;
+    batch.right[i] = batch.uvRight[i] = rect.right;
+    batch.bottom[i] = batch.uvBottom[i] = rect.bottom;
+    batch.scaleX[i] = matrix.getScaleX();
+    batch.skewX[i] = matrix.getSkewX();
+    batch.transX[i] = matrix.getTranslateX();
+    batch.skewY[i] = matrix.getSkewY();
+    batch.scaleY[i] = matrix.getScaleY();
+    batch.transY[i] = matrix.getTranslateY();
+    rects.push_back(rect);
+    matrices.push_back(matrix);
+  }
+  QuadBatch quads = {};
+  ComputeQuadBatch(batch, rects.size(), &quads);
+  AAQuadBatch aaQuads = {};
+  ComputeAAQuadBatch(batch, rects.size(), &aaQuads);
+  for (size_t i = 0; i < rects.size(); i++) {
+    auto quad = Quad::MakeFrom(rects[i], &matrices[i]);
+    auto padding = 0.5f / sqrtf(matrices[i].getScaleX() * matrices[i].getScaleX() +
+                                matrices[i].getSkewY() * matrices[i].getSkewY());
+    auto outsetBounds = rects[i].makeOutset(padding, padding);
+    auto outsetQuad = Quad::MakeFrom(outsetBounds, &matrices[i]);
+    for (size_t k = 0; k < 4; k++) {
+      EXPECT_FLOAT_EQ(quads.x[k][i], quad.point(k).x);
+      EXPECT_FLOAT_EQ(quads.y[k][i], quad.point(k).y);
+      EXPECT_FLOAT_EQ(aaQuads.outset.x[k][i], outsetQuad.point(k).x);
+      EXPECT_FLOAT_EQ(aaQuads.outset.y[k][i], outsetQuad.point(k).y);
+    }
+    EXPECT_FLOAT_EQ(aaQuads.uvOutset[0][i], outsetBounds.left);
+    EXPECT_FLOAT_EQ(aaQuads.uvOutset[3][i], outsetBounds.bottom);
+    EXPECT_FLOAT_EQ(aaQuads.uvInset[0][i], rects[i].left + padding);
+    EXPECT_FLOAT_EQ(aaQuads.uvInset[3][i], rects[i].bottom - padding);
+  }
+}
+
+TGFX_TEST(GPUTest, StencilPath) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 512, 512);
+  ASSERT_TRUE(surface != nullptr);
+  // Two concentric polygons with the even-odd rule, which leaves a hole in the center.
+  Path path = {};
+  path.setFillType(PathFillType::EvenOdd);
+  for (auto [count, radius] : {std::pair(120, 200.f), std::pair(60, 100.f)}) {
+    for (int i = 0; i < count; i++) {
+      auto angle = static_cast<float>(i) * 2.f * M_PI_F /
+                   static_cast<float>(count);
+      auto point = Point::Make(256.f + radius * cosf(angle), 256.f + radius * sinf(angle));
+      if (i == 0) {
+        path.moveTo(point);
+      } else {
+        path.lineTo(point);
+      }
+    }
+    path.close();
+  }
+  ASSERT_TRUE(PathTriangulator::ShouldStencilPath(path));
+  auto canvas = surface->getCanvas();
+  canvas->clear();
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  paint.setAntiAlias(false);
+  canvas->drawPath(path, paint);
+  auto& drawOps = surface->renderContext->opsCompositor->drawOps;
+  ASSERT_EQ(drawOps.size(), 2u);
+  EXPECT_TRUE(drawOps[0]->usesStencil());
+  EXPECT_TRUE(drawOps[1]->usesStencil());
+  context->flushAndSubmit();
+  auto info = ImageInfo::Make(1, 1, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  uint32_t pixel = 0;
+  ASSERT_TRUE(surface->readPixels(info, &pixel, 256 + 150, 256));
+  EXPECT_EQ(pixel, 0xFF0000FF);
+  ASSERT_TRUE(surface->readPixels(info, &pixel, 256, 256));
+  EXPECT_EQ(pixel, 0u);
+  ASSERT_TRUE(surface->readPixels(info, &pixel, 4, 4));
+  EXPECT_EQ(pixel, 0u);
+  // Drawing the same path again reuses the cached triangles instead of uploading new ones.
+  canvas->clear();
+  canvas->drawPath(path, paint);
+  ASSERT_EQ(drawOps.size(), 2u);
+  auto stencilOp = static_cast<StencilPathOp*>(drawOps[0].get());
+  EXPECT_TRUE(stencilOp->bufferProxy->getBuffer() != nullptr);
+  context->flushAndSubmit();
+  ASSERT_TRUE(surface->readPixels(info, &pixel, 256 + 150, 256));
+  EXPECT_EQ(pixel, 0xFF0000FF);
+}
+
+TGFX_TEST(GPUTest, AtlasPlotUpload) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 64, 64);
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  canvas->clear();
+  Paint paint = {};
+  paint.setColor(Color::Red());
+  // Two different small paths, which are rasterized into two cells of the same plot.
+  Path triangle = {};
+  triangle.moveTo(0, 0);
+  triangle.lineTo(16, 0);
+  triangle.lineTo(0, 16);
+  triangle.close();
+  canvas->drawPath(triangle, paint);
+  Path star = {};
+  star.moveTo(40, 8);
+  star.lineTo(56, 8);
+  star.lineTo(44, 20);
+  star.lineTo(48, 0);
+  star.lineTo(52, 20);
+  star.close();
+  canvas->drawPath(star, paint);
+  surface->renderContext->flush();
+  auto& atlasTasks = context->drawingManager()->getDrawingBuffer()->atlasTasks;
+  ASSERT_EQ(atlasTasks.size(), 1u);
+  auto atlasTask = atlasTasks.front().get();
+  EXPECT_EQ(atlasTask->tasks.size(), 2u);
+  Plot* plot = nullptr;
+  if (atlasTask->hardwarePixels == nullptr) {
+    ASSERT_EQ(atlasTask->plotUploads.size(), 1u);
+    auto& plotUpload = atlasTask->plotUploads.front();
+    plot = plotUpload.plot;
+    EXPECT_TRUE(plot != nullptr);
+    EXPECT_FALSE(plotUpload.dirtyRect.isEmpty());
+    EXPECT_EQ(plot->shadowMemoryUsage(), plotUpload.info.byteSize());
+    EXPECT_GE(context->atlasManager()->memoryUsage(), plot->shadowMemoryUsage());
+  }
+  context->flushAndSubmit();
+  auto info = ImageInfo::Make(1, 1, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  uint32_t pixel = 0;
+  ASSERT_TRUE(surface->readPixels(info, &pixel, 4, 4));
+  EXPECT_EQ(pixel, 0xFF0000FF);
+  ASSERT_TRUE(surface->readPixels(info, &pixel, 47, 10));
+  EXPECT_EQ(pixel, 0xFF0000FF);
+  ASSERT_TRUE(surface->readPixels(info, &pixel, 12, 12));
+  EXPECT_EQ(pixel, 0u);
+  if (plot != nullptr) {
+    // Evicting the plot releases its CPU copy along with its cells.
+    auto usage = context->atlasManager()->memoryUsage();
+    auto shadowBytes = plot->shadowMemoryUsage();
+    plot->resetRects();
+    EXPECT_EQ(plot->shadowMemoryUsage(), 0u);
+    EXPECT_EQ(context->atlasManager()->memoryUsage(), usage - shadowBytes);
+  }
+}
+
+TGFX_TEST(GPUTest, AtlasGlyphBatch) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto typeface = MakeTypeface("resources/font/NotoSansSC-Regular.otf");
+  ASSERT_TRUE(typeface != nullptr);
+  auto surface = Surface::Make(context, 200, 50);
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  canvas->clear();
+  Font font(typeface, 20.f);
+  Paint paint = {};
+  paint.setColor(Color::Black());
+  canvas->drawSimpleText("Hello TGFX", 10, 30, font, paint);
+  surface->renderContext->flush();
+  auto& atlasTasks = context->drawingManager()->getDrawingBuffer()->atlasTasks;
+  ASSERT_EQ(atlasTasks.size(), 1u);
+  auto atlasTask = atlasTasks.front().get();
+  // All glyphs share the same ScalerContext, so they are rasterized by a single batch task.
+  EXPECT_EQ(atlasTask->tasks.size(), 1u);
+  EXPECT_TRUE(atlasTask->pendingGlyphBatches.empty());
+  context->flushAndSubmit();
+  // Drawing the same text again hits the glyph cache, no more atlas tasks are needed.
+  canvas->drawSimpleText("Hello TGFX", 10, 30, font, paint);
+  surface->renderContext->flush();
+  EXPECT_TRUE(context->drawingManager()->getDrawingBuffer()->atlasTasks.empty());
+  context->flushAndSubmit();
+}
+
+TGFX_TEST(GPUTest, CompressedImageTexture) {
+  EXPECT_EQ(ETC2CompressedSize(4, 4), 16u);
+  EXPECT_EQ(ETC2CompressedSize(5, 5), 64u);
+  EXPECT_EQ(ETC2CompressedRowBytes(130), 33u * 4u);
+  auto codec = MakeImageCodec("resources/apitest/mandrill_128.png");
+  ASSERT_TRUE(codec != nullptr);
+  auto blocks = ImageBuffer::CompressETC2(codec);
+  ASSERT_TRUE(blocks != nullptr);
+  EXPECT_EQ(blocks->size(), ETC2CompressedSize(codec->width(), codec->height()));
+  EXPECT_TRUE(ImageBuffer::MakeETC2(blocks, codec->width() * 2, codec->height()) == nullptr);
+  // The saved blocks restore the buffer without decoding the codec again.
+  auto buffer = ImageBuffer::MakeETC2(blocks, codec->width(), codec->height());
+  ASSERT_TRUE(buffer != nullptr);
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  if (!context->gpu()->features()->textureCompressionETC2) {
+    return;
+  }
+  auto textureView = TextureView::MakeFrom(context, buffer);
+  ASSERT_TRUE(textureView != nullptr);
+  EXPECT_EQ(textureView->getTexture()->format(), PixelFormat::ETC2_RGBA8);
+  auto image = Image::MakeFrom(codec);
+  ASSERT_TRUE(image != nullptr);
+  auto width = image->width();
+  auto height = image->height();
+  auto surface = Surface::Make(context, width, height);
+  ASSERT_TRUE(surface != nullptr);
+  surface->getCanvas()->drawImage(image);
+  Bitmap bitmap(width, height);
+  Pixmap pixmap(bitmap);
+  ASSERT_TRUE(surface->readPixels(pixmap.info(), pixmap.writablePixels()));
+  auto pixels = static_cast<const uint8_t*>(pixmap.pixels());
+  auto byteCount = pixmap.info().byteSize();
+  // ETC2 is lossy, but the average error per channel should stay small.
+  auto checkCompressedSurface = [&](Surface* compressedSurface) {
+    Bitmap compressedBitmap(width, height);
+    Pixmap compressedPixmap(compressedBitmap);
+    ASSERT_TRUE(compressedSurface->readPixels(compressedPixmap.info(),
+                                              compressedPixmap.writablePixels()));
+    auto compressedPixels = static_cast<const uint8_t*>(compressedPixmap.pixels());
+    size_t totalError = 0;
+    for (size_t i = 0; i < byteCount; i++) {
+      totalError += static_cast<size_t>(std::abs(pixels[i] - compressedPixels[i]));
+    }
+    EXPECT_LT(totalError / byteCount, 16u);
+  };
+  auto compressedSurface =
+      Surface::Make(context, width, height, false, 1, false, RenderFlags::CompressImages);
+  ASSERT_TRUE(compressedSurface != nullptr);
+  compressedSurface->getCanvas()->drawImage(image);
+  checkCompressedSurface(compressedSurface.get());
+  auto restoredSurface = Surface::Make(context, width, height);
+  ASSERT_TRUE(restoredSurface != nullptr);
+  restoredSurface->getCanvas()->drawImage(Image::MakeFrom(buffer));
+  checkCompressedSurface(restoredSurface.get());
+}
+
+TGFX_TEST(GPUTest, StagingImageUpload) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  EXPECT_TRUE(StagingImageBuffer::Make(context, 128, 128, false) == nullptr);
+  auto codec = MakeImageCodec("resources/apitest/imageReplacement.png");
+  ASSERT_TRUE(codec != nullptr);
+  auto stagingBuffer =
+      StagingImageBuffer::Make(context, codec->width(), codec->height(), codec->isAlphaOnly());
+  if (stagingBuffer == nullptr) {
+    // The GPU doesn't support staging buffers.
+    return;
+  }
+  auto globalCache = context->globalCache();
+  auto source = ImageSource::MakeStaging(codec, stagingBuffer, false);
+  ASSERT_TRUE(source != nullptr);
+  EXPECT_TRUE(source->getData() == stagingBuffer);
+  auto textureView = TextureView::MakeFrom(context, stagingBuffer);
+  ASSERT_TRUE(textureView != nullptr);
+  EXPECT_EQ(globalCache->stagingBuffers.size(), 1u);
+  // The buffer goes back to the pool once the copy is encoded and can't be uploaded twice.
+  EXPECT_TRUE(TextureView::MakeFrom(context, stagingBuffer) == nullptr);
+  context->flushAndSubmit(true);
+  auto bufferSize = globalCache->stagingBuffers.front()->size();
+  EXPECT_TRUE(globalCache->stagingBuffers.front()->isReady());
+
+  auto image = Image::MakeFrom(codec)->makeMipmapped(true);
+  ASSERT_TRUE(image != nullptr);
+  auto width = image->width();
+  auto height = image->height();
+  auto stagedSurface = Surface::Make(context, width, height);
+  ASSERT_TRUE(stagedSurface != nullptr);
+  stagedSurface->getCanvas()->drawImage(image);
+  auto surface = Surface::Make(context, width, height, false, 1, false,
+                               RenderFlags::DisableAsyncTask);
+  ASSERT_TRUE(surface != nullptr);
+  surface->getCanvas()->drawImage(Image::MakeFrom(codec)->makeMipmapped(true));
+  Bitmap stagedBitmap(width, height);
+  Pixmap stagedPixmap(stagedBitmap);
+  ASSERT_TRUE(stagedSurface->readPixels(stagedPixmap.info(), stagedPixmap.writablePixels()));
+  // The idle buffer from the first upload is reused instead of creating a new one.
+  ASSERT_EQ(globalCache->stagingBuffers.size(), 1u);
+  EXPECT_EQ(globalCache->stagingBuffers.front()->size(), bufferSize);
+  Bitmap bitmap(width, height);
+  Pixmap pixmap(bitmap);
+  ASSERT_TRUE(surface->readPixels(pixmap.info(), pixmap.writablePixels()));
+  EXPECT_EQ(memcmp(stagedPixmap.pixels(), pixmap.pixels(), pixmap.info().byteSize()), 0);
+}
+
+TGFX_TEST(GPUTest, TransientTargetAliasing) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 8, 8);
+  ASSERT_TRUE(surface != nullptr);
+  auto mainTarget = surface->renderContext->renderTarget;
+  auto drawingManager = context->drawingManager();
+  auto allocator = drawingManager->drawingAllocator();
+  auto makeTarget = [context](int width, int height) {
+    return RenderTargetProxy::Make(context, width, height, false, 1, false, ImageOrigin::TopLeft,
+                                   BackingFit::Approx);
+  };
+  auto addTextureTask = [&](std::shared_ptr<RenderTargetProxy> renderTarget,
+                            std::shared_ptr<RenderTargetProxy> source) {
+    auto provider = RectsVertexProvider::MakeFrom(allocator, Rect::MakeWH(8, 8), AAType::None);
+    auto drawOp = RectDrawOp::Make(context, std::move(provider), 0);
+    drawOp->addColorFP(TextureEffect::Make(allocator, source->asTextureProxy()));
+    auto drawOps = allocator->makeArray<DrawOp>(&drawOp, 1);
+    drawingManager->addOpsRenderTask(std::move(renderTarget), std::move(drawOps), std::nullopt);
+  };
+  // The chain first -> middle -> last -> main leaves the first target unused before the last one
+  // is drawn, so they can share the same backing texture.
+  auto firstTarget = makeTarget(300, 300);
+  auto middleTarget = makeTarget(400, 400);
+  auto lastTarget = makeTarget(300, 200);
+  ASSERT_TRUE(firstTarget != nullptr && middleTarget != nullptr && lastTarget != nullptr);
+  auto firstProxy = firstTarget->asTextureProxy().get();
+  auto middleProxy = middleTarget->asTextureProxy().get();
+  auto lastProxy = lastTarget->asTextureProxy().get();
+  EXPECT_EQ(lastProxy->backingStoreHeight(), 256);
+  drawingManager->addOpsRenderTask(firstTarget, {}, PMColor{1.0f, 0.0f, 0.0f, 1.0f});
+  addTextureTask(middleTarget, firstTarget);
+  addTextureTask(lastTarget, middleTarget);
+  addTextureTask(mainTarget, lastTarget);
+  firstTarget = nullptr;
+  middleTarget = nullptr;
+  lastTarget = nullptr;
+
+  auto& renderTasks = drawingManager->getDrawingBuffer()->renderTasks;
+  ASSERT_EQ(renderTasks.size(), 4u);
+  RenderTaskGraph::Optimize(&renderTasks);
+  ASSERT_EQ(renderTasks.size(), 4u);
+  EXPECT_EQ(middleProxy->backingStoreWidth(), 512);
+  EXPECT_EQ(middleProxy->backingStoreHeight(), 512);
+  EXPECT_EQ(lastProxy->backingStoreWidth(), firstProxy->backingStoreWidth());
+  EXPECT_EQ(lastProxy->backingStoreHeight(), firstProxy->backingStoreHeight());
+
+  context->flushAndSubmit();
+  uint32_t pixel = 0;
+  auto info = ImageInfo::Make(1, 1, ColorType::RGBA_8888, AlphaType::Premultiplied);
+  ASSERT_TRUE(surface->readPixels(info, &pixel, 4, 4));
+  EXPECT_EQ(pixel, 0xFF0000FF);
+}
 }  // namespace tgfx
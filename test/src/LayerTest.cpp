@@ -1224,6 +1224,51 @@ TGFX_TEST(LayerTest, HasContentChanged) {
   EXPECT_TRUE(Baseline::Compare(surface, "LayerTest/HasContentChanged_Zoom"));
 }
 
+TGFX_TEST(LayerTest, DistanceFieldTextWhileZooming) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 200, 200);
+  DisplayList displayList;
+  displayList.setAllowDistanceFieldText(true);
+  auto textLayer = TextLayer::Make();
+  textLayer->setText("Hello, World!");
+  auto typeface = MakeTypeface("resources/font/NotoSansSC-Regular.otf");
+  textLayer->setFont(Font(typeface, 20));
+  displayList.root()->addChild(textLayer);
+  displayList.render(surface.get());
+  EXPECT_FALSE(displayList.distanceFieldText);
+  EXPECT_FALSE(displayList.hasContentChanged());
+
+  displayList.setZoomScale(2.0f);
+  displayList.render(surface.get());
+  EXPECT_TRUE(displayList.distanceFieldText);
+  // The flag is set on the partial cache, and the target surface is left untouched.
+  EXPECT_EQ(surface->renderFlags(), 0u);
+  ASSERT_FALSE(displayList.surfaceCaches.empty());
+  auto partialCache = displayList.surfaceCaches.front();
+  EXPECT_EQ(partialCache->renderFlags(), RenderFlags::DistanceFieldText);
+  // Keeps requesting frames until the text is redrawn as sharp masks.
+  EXPECT_TRUE(displayList.hasContentChanged());
+  displayList.render(surface.get());
+  EXPECT_FALSE(displayList.distanceFieldText);
+  EXPECT_EQ(partialCache->renderFlags(), 0u);
+  EXPECT_FALSE(displayList.hasContentChanged());
+
+  displayList.setRenderMode(RenderMode::Direct);
+  displayList.setZoomScale(2.5f);
+  displayList.render(surface.get());
+  EXPECT_TRUE(displayList.distanceFieldText);
+  // The render flags of the target surface are restored after rendering.
+  EXPECT_EQ(surface->renderFlags(), 0u);
+
+  displayList.setRenderMode(RenderMode::Tiled);
+  displayList.setZoomScale(3.0f);
+  displayList.render(surface.get());
+  EXPECT_FALSE(displayList.distanceFieldText);
+  context->flushAndSubmit();
+}
+
 /**
  * The schematic diagram is as follows:
  * https://www.geogebra.org/graphing/uxs8drhd
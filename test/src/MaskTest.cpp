@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <vector>
+#include "core/DistanceFieldRasterizer.h"
 #include "core/PathRasterizer.h"
 #include "core/images/BufferImage.h"
 #include "tgfx/core/Surface.h"
@@ -74,4 +75,34 @@ TGFX_TEST(PathRasterizerTest, Rasterize) {
   canvas->drawImage(glyphImage);
   EXPECT_TRUE(Baseline::Compare(surface, "MaskTest/rasterize_emoji"));
 }
+
+TGFX_TEST(PathRasterizerTest, DistanceField) {
+  Path path = {};
+  path.addRect(4, 4, 36, 36);
+  auto rasterizer = PathRasterizer::MakeFrom(40, 40, path, true);
+  ASSERT_TRUE(rasterizer != nullptr);
+  auto fieldRasterizer = DistanceFieldRasterizer::MakeFrom(rasterizer);
+  ASSERT_TRUE(fieldRasterizer != nullptr);
+  static constexpr int Spread = DistanceFieldRasterizer::Spread;
+  EXPECT_EQ(fieldRasterizer->width(), 40 + 2 * Spread);
+  EXPECT_EQ(fieldRasterizer->height(), 40 + 2 * Spread);
+  EXPECT_TRUE(fieldRasterizer->isAlphaOnly());
+  auto info =
+      ImageInfo::Make(fieldRasterizer->width(), fieldRasterizer->height(), ColorType::ALPHA_8);
+  std::vector<uint8_t> pixels(info.byteSize());
+  ASSERT_TRUE(fieldRasterizer->readPixels(info, pixels.data()));
+  auto getValue = [&](int x, int y) {
+    return pixels[static_cast<size_t>(y) * info.rowBytes() + static_cast<size_t>(x)];
+  };
+  // The edges of the rect are moved by Spread pixels, and 128 is the value of the edges.
+  auto edge = 4 + Spread;
+  auto center = 20 + Spread;
+  EXPECT_EQ(getValue(center, center), 255);
+  EXPECT_EQ(getValue(0, 0), 0);
+  EXPECT_GT(getValue(edge, center), 128);
+  EXPECT_LT(getValue(edge - 1, center), 128);
+  EXPECT_GT(getValue(edge + 2, center), getValue(edge, center));
+  EXPECT_LT(getValue(edge - 3, center), getValue(edge - 1, center));
+  EXPECT_EQ(DistanceFieldRasterizer::MakeFrom(nullptr), nullptr);
+}
 }  // namespace tgfx
@@ -132,4 +132,149 @@ TGFX_TEST(PathTest, ZeroDimensionPathRasterization) {
   }
 }
 
+TGFX_TEST(PathTest, HairlineTriangles) {
+  Path path;
+  path.moveTo(10.f, 10.f);
+  path.lineTo(20.f, 10.f);
+  path.lineTo(20.f, 30.f);
+  {
+    std::vector<float> vertices = {};
+    auto count = PathTriangulator::ToHairlineTriangles(path, LineCap::Butt, true, &vertices);
+    // Two segments, each with two quads on both sides of the center line.
+    ASSERT_EQ(count, 8u);
+    ASSERT_EQ(vertices.size(), 8u * 3 * 3);
+    EXPECT_EQ(PathTriangulator::GetAATriangleCount(vertices.size() * sizeof(float)), 24u);
+    for (size_t i = 0; i < vertices.size(); i += 3) {
+      auto y = vertices[i + 1];
+      auto coverage = vertices[i + 2];
+      if (i < vertices.size() / 2) {
+        EXPECT_TRUE(coverage == 1.f ? y == 10.f : std::fabs(y - 10.f) == 1.f);
+      }
+      EXPECT_TRUE(coverage == 0.f || coverage == 1.f);
+    }
+    // Both segments end at the same mitered points around the joint, so they don't overlap.
+    std::vector<Point> firstEnds = {};
+    std::vector<Point> secondStarts = {};
+    for (size_t i = 0; i < vertices.size(); i += 3) {
+      auto point = Point::Make(vertices[i], vertices[i + 1]);
+      if (vertices[i + 2] != 0.f || std::fabs(point.x - 20.f) > 1.f) {
+        continue;
+      }
+      if (point.y < 12.f) {
+        (i < vertices.size() / 2 ? firstEnds : secondStarts).push_back(point);
+      }
+    }
+    EXPECT_TRUE(std::find(firstEnds.begin(), firstEnds.end(), Point::Make(19.f, 11.f)) !=
+                firstEnds.end());
+    EXPECT_TRUE(std::find(secondStarts.begin(), secondStarts.end(), Point::Make(19.f, 11.f)) !=
+                secondStarts.end());
+  }
+  {
+    std::vector<float> vertices = {};
+    auto count = PathTriangulator::ToHairlineTriangles(path, LineCap::Square, false, &vertices);
+    ASSERT_EQ(count, 4u);
+    EXPECT_EQ(PathTriangulator::GetTriangleCount(vertices.size() * sizeof(float)), 12u);
+    // The square cap extends the start point by half a pixel.
+    EXPECT_EQ(vertices[0], 9.5f);
+  }
+  {
+    Path curve;
+    curve.moveTo(0.f, 0.f);
+    curve.quadTo(50.f, 100.f, 100.f, 0.f);
+    std::vector<float> vertices = {};
+    auto count = PathTriangulator::ToHairlineTriangles(curve, LineCap::Butt, false, &vertices);
+    EXPECT_GT(count, 2u);
+    EXPECT_EQ(count % 2, 0u);
+  }
+  {
+    Path dot;
+    dot.moveTo(5.f, 5.f);
+    dot.lineTo(5.f, 5.f);
+    std::vector<float> vertices = {};
+    EXPECT_EQ(PathTriangulator::ToHairlineTriangles(dot, LineCap::Butt, true, &vertices), 0u);
+    EXPECT_EQ(PathTriangulator::ToHairlineTriangles(dot, LineCap::Round, true, &vertices), 4u);
+  }
+}
+
+TGFX_TEST(PathTest, ConvexPath) {
+  Path path = {};
+  EXPECT_FALSE(path.isConvex());
+  path.addRect(Rect::MakeXYWH(10.f, 10.f, 20.f, 20.f));
+  EXPECT_TRUE(path.isConvex());
+  path.addRect(Rect::MakeXYWH(40.f, 10.f, 20.f, 20.f));
+  EXPECT_FALSE(path.isConvex());
+
+  Path oval = {};
+  oval.addOval(Rect::MakeXYWH(0.f, 0.f, 100.f, 50.f));
+  EXPECT_TRUE(oval.isConvex());
+  std::vector<float> vertices = {};
+  auto count = PathTriangulator::ToConvexTriangles(oval, true, &vertices);
+  EXPECT_GT(count, 0u);
+  EXPECT_EQ(PathTriangulator::GetAATriangleCount(vertices.size() * sizeof(float)), count * 3);
+  vertices.clear();
+  auto nonAACount = PathTriangulator::ToConvexTriangles(oval, false, &vertices);
+  EXPECT_EQ(PathTriangulator::GetTriangleCount(vertices.size() * sizeof(float)), nonAACount * 3);
+  // The AA mesh adds an edge quad and a corner triangle for each vertex of the fan.
+  EXPECT_EQ(count, nonAACount + (nonAACount + 2) * 3);
+
+  Path chevron = {};
+  chevron.moveTo(0.f, 0.f);
+  chevron.lineTo(20.f, 10.f);
+  chevron.lineTo(0.f, 20.f);
+  chevron.lineTo(10.f, 10.f);
+  chevron.close();
+  EXPECT_FALSE(chevron.isConvex());
+  Path triangle = {};
+  triangle.moveTo(0.f, 0.f);
+  triangle.lineTo(20.f, 10.f);
+  triangle.lineTo(0.f, 20.f);
+  triangle.close();
+  EXPECT_TRUE(triangle.isConvex());
+
+  Path pentagram = {};
+  pentagram.moveTo(0.f, -10.f);
+  pentagram.lineTo(6.f, 8.f);
+  pentagram.lineTo(-9.f, -3.f);
+  pentagram.lineTo(9.f, -3.f);
+  pentagram.lineTo(-6.f, 8.f);
+  pentagram.close();
+  EXPECT_FALSE(pentagram.isConvex());
+
+  Path sliver = {};
+  sliver.moveTo(0.f, 0.f);
+  sliver.lineTo(20.f, 0.f);
+  sliver.lineTo(10.f, 0.5f);
+  sliver.close();
+  EXPECT_TRUE(sliver.isConvex());
+  vertices.clear();
+  EXPECT_EQ(PathTriangulator::ToConvexTriangles(sliver, true, &vertices), 0u);
+}
+
+TGFX_TEST(PathTest, StencilTriangles) {
+  Path path = {};
+  for (int i = 0; i < 200; i++) {
+    auto angle = static_cast<float>(i) * static_cast<float>(M_PI) / 100.f;
+    auto radius = i % 2 == 0 ? 200.f : 150.f;
+    auto point = Point::Make(256.f + radius * cosf(angle), 256.f + radius * sinf(angle));
+    if (i == 0) {
+      path.moveTo(point);
+    } else {
+      path.lineTo(point);
+    }
+  }
+  EXPECT_TRUE(PathTriangulator::ShouldStencilPath(path));
+  std::vector<float> vertices = {};
+  auto count = PathTriangulator::ToStencilTriangles(path, &vertices);
+  EXPECT_EQ(count, 198u);
+  EXPECT_EQ(PathTriangulator::GetTriangleCount(vertices.size() * sizeof(float)), count * 3);
+
+  auto smallPath = path;
+  smallPath.transform(Matrix::MakeScale(0.1f));
+  EXPECT_FALSE(PathTriangulator::ShouldStencilPath(smallPath));
+  Path simplePath = {};
+  simplePath.addOval(Rect::MakeWH(500.f, 500.f));
+  simplePath.addRect(Rect::MakeWH(300.f, 300.f));
+  EXPECT_FALSE(PathTriangulator::ShouldStencilPath(simplePath));
+}
+
 }  // namespace tgfx
\ No newline at end of file
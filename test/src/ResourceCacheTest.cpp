@@ -17,6 +17,7 @@
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include <array>
+#include <limits>
 #include <utility>
 #include "core/utils/BlockAllocator.h"
 #include "core/utils/UniqueID.h"
@@ -42,6 +43,110 @@ class TestResource : public Resource {
   }
 };
 
+class SizedResource : public Resource {
+ public:
+  static std::shared_ptr<SizedResource> Make(Context* context, size_t size,
+                                             const UniqueKey& uniqueKey) {
+    auto resource = Resource::AddToCache(context, new SizedResource(size));
+    resource->assignUniqueKey(uniqueKey);
+    return resource;
+  }
+
+  size_t memoryUsage() const override {
+    return size;
+  }
+
+ private:
+  size_t size = 0;
+
+  explicit SizedResource(size_t size) : size(size) {
+  }
+};
+
+TGFX_TEST(ResourceCacheTest, purgeByRegenerationCost) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto cache = context->resourceCache();
+  cache->purgeUntilMemoryTo(0);
+  auto otherBytes = cache->getResourceBytes(ResourceCategory::Other);
+  auto expensiveKey = UniqueKey::Make();
+  auto defaultKey = UniqueKey::Make();
+  auto cheapKey = UniqueKey::Make();
+  {
+    auto expensive = SizedResource::Make(context, 100, expensiveKey);
+    expensive->setRegenerationCost(400);
+    auto defaultCost = SizedResource::Make(context, 100, defaultKey);
+    auto cheap = SizedResource::Make(context, 100, cheapKey);
+    cheap->setRegenerationCost(10);
+    EXPECT_EQ(defaultCost->regenerationCost(), 100u);
+  }
+  auto totalBytes = cache->getResourceBytes();
+  EXPECT_EQ(cache->getResourceBytes(ResourceCategory::Other), otherBytes + 300);
+  // The cheapest resource per byte goes first, even though it is the most recently used one.
+  EXPECT_TRUE(cache->purgeUntilMemoryTo(totalBytes - 100));
+  EXPECT_TRUE(cache->hasUniqueResource(expensiveKey));
+  EXPECT_TRUE(cache->hasUniqueResource(defaultKey));
+  EXPECT_FALSE(cache->hasUniqueResource(cheapKey));
+  EXPECT_TRUE(cache->purgeUntilMemoryTo(totalBytes - 200));
+  EXPECT_TRUE(cache->hasUniqueResource(expensiveKey));
+  EXPECT_FALSE(cache->hasUniqueResource(defaultKey));
+  // A category over its own limit is purged even if the whole cache is under the limit.
+  context->setCacheLimit(ResourceCategory::Other, 0);
+  EXPECT_FALSE(cache->hasUniqueResource(expensiveKey));
+  EXPECT_EQ(cache->getResourceBytes(ResourceCategory::Other), otherBytes);
+  context->setCacheLimit(ResourceCategory::Other, std::numeric_limits<size_t>::max());
+}
+
+TGFX_TEST(ResourceCacheTest, memoryPressure) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto cache = context->resourceCache();
+  auto expensiveKey = UniqueKey::Make();
+  auto cheapKey = UniqueKey::Make();
+  {
+    auto expensive = SizedResource::Make(context, 1000, expensiveKey);
+    expensive->setRegenerationCost(4000);
+    SizedResource::Make(context, 1000, cheapKey);
+  }
+  auto moderateCount = context->memoryPressureCount(MemoryPressure::Moderate);
+  auto criticalCount = context->memoryPressureCount(MemoryPressure::Critical);
+  // The moderate level purges the resources that are cheap to regenerate first.
+  EXPECT_GE(context->onMemoryPressure(MemoryPressure::Moderate), 1000u);
+  EXPECT_FALSE(cache->hasUniqueResource(cheapKey));
+  // The target is half of the resource cache alone, so the atlas pages don't push it lower.
+  EXPECT_TRUE(cache->hasUniqueResource(expensiveKey));
+  EXPECT_EQ(context->memoryPressureCount(MemoryPressure::Moderate), moderateCount + 1);
+  SizedResource::Make(context, 1000, cheapKey);
+  EXPECT_GE(context->onMemoryPressure(MemoryPressure::Critical), 1000u);
+  EXPECT_FALSE(cache->hasUniqueResource(expensiveKey));
+  EXPECT_FALSE(cache->hasUniqueResource(cheapKey));
+  EXPECT_EQ(context->memoryPressureCount(MemoryPressure::Critical), criticalCount + 1);
+  // Exceeding the soft limit is handled as a moderate memory pressure once the work is submitted.
+  // The resource in use keeps the usage above the limit after purging.
+  auto usedResource = SizedResource::Make(context, 1000, UniqueKey::Make());
+  SizedResource::Make(context, 1000, cheapKey);
+  context->setMemorySoftLimit(0);
+  context->flushAndSubmit(true);
+  EXPECT_FALSE(cache->hasUniqueResource(cheapKey));
+  EXPECT_EQ(context->memoryPressureCount(MemoryPressure::Moderate), moderateCount + 2);
+  // Staying above the limit doesn't trigger the response again at the following submits.
+  SizedResource::Make(context, 1000, cheapKey);
+  context->flushAndSubmit(true);
+  context->flushAndSubmit(true);
+  EXPECT_TRUE(cache->hasUniqueResource(cheapKey));
+  EXPECT_EQ(context->memoryPressureCount(MemoryPressure::Moderate), moderateCount + 2);
+  // Dropping under the limit rearms it.
+  context->setMemorySoftLimit(std::numeric_limits<size_t>::max());
+  context->flushAndSubmit(true);
+  context->setMemorySoftLimit(0);
+  context->flushAndSubmit(true);
+  EXPECT_FALSE(cache->hasUniqueResource(cheapKey));
+  EXPECT_EQ(context->memoryPressureCount(MemoryPressure::Moderate), moderateCount + 3);
+  context->setMemorySoftLimit(std::numeric_limits<size_t>::max());
+}
+
 TGFX_TEST(ResourceCacheTest, multiThreadRecycling) {
   auto device = DevicePool::Make();
   ASSERT_TRUE(device != nullptr);
@@ -19,6 +19,7 @@
 #include "gpu/RenderContext.h"
 #include "gpu/opengl/GLCaps.h"
 #include "gpu/opengl/GLUtil.h"
+#include "tgfx/core/ReadbackRing.h"
 #include "tgfx/gpu/opengl/GLDevice.h"
 #include "utils/TestUtils.h"
 
@@ -73,4 +74,59 @@ TGFX_TEST(SurfaceTest, ImageSnapshot) {
   compareCanvas->drawImage(snapshotImage);
   EXPECT_TRUE(Baseline::Compare(compareSurface, "SurfaceTest/ImageSnapshot2"));
 }
+
+TGFX_TEST(SurfaceTest, ReadbackRing) {
+  ContextScope scope;
+  auto context = scope.getContext();
+  ASSERT_TRUE(context != nullptr);
+  auto surface = Surface::Make(context, 32, 32);
+  ASSERT_TRUE(surface != nullptr);
+  auto canvas = surface->getCanvas();
+  EXPECT_TRUE(ReadbackRing::Make(0) == nullptr);
+  auto ring = ReadbackRing::Make(2);
+  ASSERT_TRUE(ring != nullptr);
+  EXPECT_EQ(ring->capacity(), 2u);
+  canvas->clear(Color::Red());
+  EXPECT_EQ(ring->readPixels(surface.get(), Rect::MakeWH(32, 32)), 0);
+  canvas->clear(Color::Green());
+  EXPECT_EQ(ring->readPixels(surface.get(), Rect::MakeWH(32, 32)), 1);
+  canvas->clear(Color::Blue());
+  // All slots are in flight.
+  EXPECT_EQ(ring->readPixels(surface.get(), Rect::MakeWH(32, 32)), -1);
+  EXPECT_EQ(ring->pendingCount(), 2u);
+  context->flushAndSubmit();
+  std::vector<int64_t> frames = {};
+  std::vector<uint32_t> pixels = {};
+  auto callback = [&](int64_t frameIndex, const ImageInfo& info, const void* data) {
+    EXPECT_EQ(info.width(), 32);
+    EXPECT_EQ(info.height(), 32);
+    frames.push_back(frameIndex);
+    pixels.push_back(*static_cast<const uint32_t*>(data));
+  };
+  EXPECT_EQ(ring->poll(context, callback, true), 2u);
+  EXPECT_EQ(ring->pendingCount(), 0u);
+  // The slot of the first frame is reused by the third frame.
+  EXPECT_EQ(ring->readPixels(surface.get(), Rect::MakeWH(32, 32)), 2);
+  EXPECT_FALSE(ring->isReady(context, 0));
+  // The reused readback buffer still holds the pixels and the fence of the first frame, so the
+  // third frame is not ready before its transfer is flushed.
+  EXPECT_FALSE(ring->isReady(context, 2));
+  EXPECT_EQ(ring->poll(context, callback), 0u);
+  context->flushAndSubmit(true);
+  EXPECT_TRUE(ring->isReady(context, 2));
+  EXPECT_EQ(ring->poll(context, callback), 1u);
+  // Waiting flushes the transfer of a reused slot before reading it.
+  canvas->clear(Color::White());
+  EXPECT_EQ(ring->readPixels(surface.get(), Rect::MakeWH(32, 32)), 3);
+  EXPECT_EQ(ring->poll(context, callback, true), 1u);
+  ASSERT_EQ(frames.size(), 4u);
+  EXPECT_EQ(frames[0], 0);
+  EXPECT_EQ(frames[1], 1);
+  EXPECT_EQ(frames[2], 2);
+  EXPECT_EQ(frames[3], 3);
+  EXPECT_EQ(pixels[0], 0xFF0000FF);
+  EXPECT_EQ(pixels[1], 0xFF00FF00);
+  EXPECT_EQ(pixels[2], 0xFFFF0000);
+  EXPECT_EQ(pixels[3], 0xFFFFFFFF);
+}
 }  // namespace tgfx
@@ -16,6 +16,13 @@
 //
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <thread>
+#include "core/GlyphPathCache.h"
+#include "core/PathRef.h"
+#include "core/ScalerContext.h"
+#ifdef TGFX_USE_FREETYPE
+#include "core/vectors/freetype/FTTypeface.h"
+#endif
 #include "tgfx/core/CustomTypeface.h"
 #include "tgfx/core/Typeface.h"
 #include "utils/TestUtils.h"
@@ -171,4 +178,168 @@ TGFX_TEST(TypefaceTest, CustomImageTypeface) {
 
   EXPECT_TRUE(Baseline::Compare(surface, "TypefaceTest/CustomImageTypeface"));
 }
+
+TGFX_TEST(TypefaceTest, GlyphMetricsCache) {
+  auto typeface =
+      Typeface::MakeFromPath(ProjectPath::Absolute("resources/font/NotoSansSC-Regular.otf"));
+  ASSERT_TRUE(typeface != nullptr);
+  Font font(typeface, 20.0f);
+  font.setFauxBold(true);
+  auto scalerContext = font.scalerContext;
+  EXPECT_EQ(scalerContext->metricsCache.memoryUsage(), 0u);
+  for (GlyphID glyphID = 1; glyphID < 300; glyphID++) {
+    auto bounds = font.getBounds(glyphID);
+    EXPECT_EQ(bounds, scalerContext->getBounds(glyphID, true, false));
+    EXPECT_EQ(font.getBounds(glyphID), bounds);
+    EXPECT_EQ(font.getAdvance(glyphID), scalerContext->getAdvance(glyphID, false));
+    EXPECT_EQ(font.getVerticalOffset(glyphID), scalerContext->getVerticalOffset(glyphID));
+  }
+  auto memoryUsage = scalerContext->metricsCache.memoryUsage();
+  EXPECT_GT(memoryUsage, 0u);
+  EXPECT_LE(memoryUsage, GlyphMetricsCache::MaxCacheBytes);
+
+  using FloatTable = GlyphMetricsTable<float>;
+  // An unused table only holds the pointer to its page directory.
+  EXPECT_EQ(sizeof(FloatTable), sizeof(void*));
+  FloatTable table = {};
+  std::atomic<size_t> usedBytes = {0};
+  float advance = 0.0f;
+  // Nothing is cached if there is no room for a new page.
+  table.add(1, 1.0f, &usedBytes, 0);
+  EXPECT_FALSE(table.find(1, &advance));
+  EXPECT_EQ(usedBytes.load(), 0u);
+  table.add(1, 1.0f, &usedBytes, SIZE_MAX);
+  table.add(1, 2.0f, &usedBytes, SIZE_MAX);
+  EXPECT_EQ(usedBytes.load(), sizeof(FloatTable::Directory) + sizeof(FloatTable::Page));
+  EXPECT_TRUE(table.find(1, &advance));
+  EXPECT_EQ(advance, 1.0f);
+  EXPECT_FALSE(table.find(2, &advance));
+}
+
+TGFX_TEST(TypefaceTest, ConcurrentGlyphPaths) {
+  auto typeface =
+      Typeface::MakeFromPath(ProjectPath::Absolute("resources/font/NotoSansSC-Regular.otf"));
+  ASSERT_TRUE(typeface != nullptr);
+  Font font(typeface, 30.0f);
+  static constexpr GlyphID GlyphCount = 64;
+  std::vector<Path> expectedPaths(GlyphCount);
+  for (GlyphID glyphID = 1; glyphID < GlyphCount; glyphID++) {
+    font.getPath(glyphID, &expectedPaths[glyphID]);
+  }
+  static constexpr size_t ThreadCount = 4;
+  std::vector<int> mismatchCounts(ThreadCount, 0);
+  std::vector<std::thread> threads = {};
+  for (size_t i = 0; i < ThreadCount; i++) {
+    threads.emplace_back([&, i] {
+      Font threadFont(typeface, 30.0f);
+      for (GlyphID glyphID = 1; glyphID < GlyphCount; glyphID++) {
+        Path path = {};
+        threadFont.getPath(glyphID, &path);
+        if (path != expectedPaths[glyphID]) {
+          mismatchCounts[i]++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (auto count : mismatchCounts) {
+    EXPECT_EQ(count, 0);
+  }
+}
+
+#ifdef TGFX_USE_FREETYPE
+TGFX_TEST(TypefaceTest, IdleFaces) {
+  FTTypeface::ReleaseIdleFaces();
+  auto typeface = std::static_pointer_cast<FTTypeface>(
+      Typeface::MakeFromPath(ProjectPath::Absolute("resources/font/NotoSansSC-Regular.otf")));
+  ASSERT_TRUE(typeface != nullptr);
+  std::vector<std::unique_ptr<FTFace>> faces = {};
+  for (size_t i = 0; i < FTTypeface::MaxIdleFaceCount + 4; i++) {
+    auto ftFace = typeface->acquireFace();
+    ASSERT_TRUE(ftFace != nullptr);
+    faces.push_back(std::move(ftFace));
+  }
+  for (auto& ftFace : faces) {
+    typeface->releaseFace(std::move(ftFace));
+  }
+  // The idle faces are limited across all typefaces.
+  EXPECT_EQ(FTTypeface::ReleaseIdleFaces(), FTTypeface::MaxIdleFaceCount);
+
+  Font font(typeface, 20.0f);
+  Path path = {};
+  EXPECT_TRUE(font.scalerContext->generatePath(font.getGlyphID("T"), false, false, &path));
+  auto otherTypeface =
+      Typeface::MakeFromPath(ProjectPath::Absolute("resources/font/NotoSerifSC-Regular.otf"));
+  font = Font(otherTypeface, 20.0f);
+  EXPECT_TRUE(font.scalerContext->generatePath(font.getGlyphID("T"), false, false, &path));
+  // The idle faces of a typeface are destroyed with it.
+  typeface = nullptr;
+  EXPECT_EQ(FTTypeface::ReleaseIdleFaces(), 1u);
+  EXPECT_EQ(FTTypeface::ReleaseIdleFaces(), 0u);
+}
+#endif
+
+TGFX_TEST(TypefaceTest, GlyphPathCache) {
+  auto typeface =
+      Typeface::MakeFromPath(ProjectPath::Absolute("resources/font/NotoSansSC-Regular.otf"));
+  ASSERT_TRUE(typeface != nullptr);
+  auto cache = GlyphPathCache::Get();
+  cache->purge();
+  GlyphID glyphID = typeface->getGlyphID(static_cast<Unichar>('T'));
+  ASSERT_TRUE(glyphID > 0);
+
+  Font smallFont(typeface, 20.0f);
+  Path smallPath = {};
+  EXPECT_TRUE(smallFont.getPath(glyphID, &smallPath));
+  Path expectedPath = {};
+  EXPECT_TRUE(smallFont.scalerContext->generatePath(glyphID, false, false, &expectedPath));
+  EXPECT_TRUE(smallPath == expectedPath);
+  EXPECT_EQ(cache->cachedPathCount(), 1u);
+
+  // Larger sizes share the unhinted outline extracted at the reference size.
+  Path outline = {};
+  auto referenceContext = typeface->getScalerContext(GlyphPathCache::ReferenceSize);
+  EXPECT_TRUE(referenceContext->generateUnhintedPath(glyphID, false, false, &outline));
+  Font largeFont(typeface, GlyphPathCache::ReferenceSize / 2);
+  Path largePath = {};
+  EXPECT_TRUE(largeFont.getPath(glyphID, &largePath));
+  EXPECT_EQ(cache->cachedPathCount(), 2u);
+  expectedPath = outline;
+  expectedPath.transform(Matrix::MakeScale(0.5f, 0.5f));
+  EXPECT_TRUE(largePath == expectedPath);
+  auto largerFont = largeFont.makeWithSize(GlyphPathCache::ReferenceSize * 2);
+  Path largerPath = {};
+  EXPECT_TRUE(largerFont.getPath(glyphID, &largerPath));
+  expectedPath = outline;
+  expectedPath.transform(Matrix::MakeScale(2.0f, 2.0f));
+  EXPECT_TRUE(largerPath == expectedPath);
+  EXPECT_EQ(cache->cachedPathCount(), 2u);
+
+  // Paths of the same glyph share the PathRef, and therefore its unique key, at the reference size
+  // and at each small size.
+  Path referencePath = {};
+  EXPECT_TRUE(Font(typeface, GlyphPathCache::ReferenceSize).getPath(glyphID, &referencePath));
+  Path cachedPath = {};
+  EXPECT_TRUE(Font(typeface, GlyphPathCache::ReferenceSize).getPath(glyphID, &cachedPath));
+  EXPECT_TRUE(cachedPath.isSame(referencePath));
+  EXPECT_TRUE(PathRef::GetUniqueKey(cachedPath) == PathRef::GetUniqueKey(referencePath));
+  EXPECT_TRUE(smallFont.getPath(glyphID, &cachedPath));
+  EXPECT_TRUE(cachedPath.isSame(smallPath));
+  EXPECT_EQ(cache->cachedPathCount(), 2u);
+
+  largeFont.setFauxItalic(true);
+  Path italicPath = {};
+  EXPECT_TRUE(largeFont.getPath(glyphID, &italicPath));
+  EXPECT_FALSE(italicPath == largePath);
+
+  for (GlyphID id = 1; id <= GlyphPathCache::MaxCachedPathCount; id++) {
+    Path path = {};
+    smallFont.getPath(id, &path);
+  }
+  EXPECT_EQ(cache->cachedPathCount(), GlyphPathCache::MaxCachedPathCount);
+  cache->purge();
+  EXPECT_EQ(cache->cachedPathCount(), 0u);
+}
 }  // namespace tgfx